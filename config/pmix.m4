@@ -609,6 +609,13 @@ AC_DEFUN([PMIX_SETUP_CORE],[
 
     PMIX_MUNGE_CONFIG
 
+    ##################################
+    # zlib
+    ##################################
+    pmix_show_title "zlib"
+
+    PMIX_ZLIB_CONFIG
+
     ##################################
     # MCA
     ##################################
@@ -198,11 +198,22 @@ extern "C" {
  * (a) PMIX_TIMEOUT - maximum time for the get to execute before declaring
  *     an error. The timeout parameter can help avoid "hangs" due to programming
  *     errors that prevent the target proc from ever exposing its data.
+ *
+ * (b) PMIX_GET_POINTER - return a byte object whose bytes point directly
+ *     into the read-only shared memory of the local data store instead of
+ *     a copy of them. The bytes remain valid as long as the nspace is known
+ *     to the client and the owner does not replace the key. A value obtained
+ *     this way must be released with PMIx_Get_release.
  */
  pmix_status_t PMIx_Get(const pmix_proc_t *proc, const char key[],
                         const pmix_info_t info[], size_t ninfo,
                         pmix_value_t **val);
 
+/* Release a value returned by PMIx_Get. Unlike PMIX_VALUE_RELEASE, this
+ * can also be used for values obtained with the PMIX_GET_POINTER directive
+ * as it leaves the bytes that belong to the data store alone. */
+ void PMIx_Get_release(pmix_value_t *val);
+
 /* A non-blocking operation version of PMIx_Get - the callback function will
  * be executed once the specified data has been _PMIx_Put_
  * by the identified process and retrieved by the local server. The info
@@ -211,6 +222,22 @@ extern "C" {
                            const pmix_info_t info[], size_t ninfo,
                            pmix_value_cbfunc_t cbfunc, void *cbdata);
 
+/* Retrieve the values of n keys at once - key[i] is looked up for the
+ * process procs[i] and returned in vals[i] together with the status of
+ * the lookup in status[i]. An empty nspace in procs[i] refers to the
+ * caller's own nspace. This is a blocking operation that is equivalent
+ * to n calls of PMIx_Get, but all keys that are found locally are
+ * resolved in a single pass, and all keys of a process whose data
+ * has to be obtained from the server share one request. The info array
+ * applies to all the keys and is used as described for PMIx_Get.
+ *
+ * Returns PMIX_SUCCESS if all the values were retrieved, otherwise the
+ * status of the first one that was not. The caller is responsible for
+ * releasing the values that were returned. */
+ pmix_status_t PMIx_Get_multi(const pmix_proc_t procs[], const char *keys[], size_t n,
+                              const pmix_info_t info[], size_t ninfo,
+                              pmix_value_t *vals[], pmix_status_t status[]);
+
 
 /* Publish the data in the info array for lookup. By default,
  * the data will be published into the PMIX_SESSION range and
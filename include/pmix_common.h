@@ -110,6 +110,13 @@ typedef uint32_t pmix_rank_t;
                                                                     //        accept tool connection requests
 #define PMIX_SERVER_SYSTEM_SUPPORT          "pmix.srvr.sys"         // (bool) The host RM wants to declare itself as being the local
                                                                     //        system server for PMIx connection requests
+#define PMIX_SERVER_COMPRESS_MODEX          "pmix.srvr.cmpmdx"      // (bool) The host RM can carry compressed collective modex data between
+                                                                    //        all of its servers - compress the data passed to fence_nb
+#define PMIX_SERVER_COMPRESS_MIN            "pmix.srvr.cmpmin"      // (size_t) only compress collective modex data of at least this many bytes
+#define PMIX_SERVER_DEDUP_MODEX             "pmix.srvr.dedupmdx"    // (bool) The host RM's servers all understand collective modex data in
+                                                                    //        which identical keys and values are sent only once
+#define PMIX_SERVER_FENCE_STATS             "pmix.srvr.fncstats"    // (bool) report the latency histograms of the fence phases
+                                                                    //        when the server finalizes
 #define PMIX_SERVER_PIDINFO                 "pmix.srvr.pidinfo"     // (pid_t) pid of the target server
 #define PMIX_SERVER_TMPDIR                  "pmix.srvr.tmpdir"      // (char*) temp directory where PMIx server will place
                                                                     //        client rendezvous points
@@ -193,6 +200,8 @@ typedef uint32_t pmix_rank_t;
                                                                     //        not request data from the server if not found
 #define PMIX_EMBED_BARRIER                  "pmix.embed.barrier"    // (bool) execute a blocking fence operation before executing the
                                                                     //        specified operation
+#define PMIX_GET_POINTER                    "pmix.get.ptr"          // (bool) return a byte object pointing into the local data store instead
+                                                                    //        of a copy where possible - release with PMIx_Get_release
 
 /* attributes used by host server to pass data to the server convenience library - the
  * data will then be parsed and provided to the local clients */
@@ -259,6 +268,8 @@ typedef uint32_t pmix_rank_t;
                                                                      //     returns (pmix_data_array_t) an array of pmix_proc_info_t for
                                                                      //     procs in job on same node
 #define PMIX_QUERY_AUTHORIZATIONS           "pmix.qry.auths"         // return operations tool is authorized to perform"
+#define PMIX_QUERY_FENCE_STATS              "pmix.qry.fncstats"      // (char*) latency histograms of the phases of the fences the
+                                                                     //         local server completed, one line per phase
 
 /* log attributes */
 #define PMIX_LOG_STDERR                     "pmix.log.stderr"        // (bool) log data to stderr
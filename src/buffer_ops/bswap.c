@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2016      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <string.h>
+
+#include "src/include/types.h"
+#include "src/buffer_ops/internal.h"
+
+/* the vector kernels are only a win where packing has to swap
+ * bytes at all, and need a compiler that can build them for a
+ * CPU other than the one it targets by default */
+#if defined(HAVE_UNIX_BYTESWAP) && !defined(WORDS_BIGENDIAN) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define PMIX_BFROP_SWAP_X86 1
+#include <immintrin.h>
+#else
+#define PMIX_BFROP_SWAP_X86 0
+#endif
+
+/*
+ * Scalar kernels - the way the pack and unpack functions always
+ * converted values, one at a time
+ */
+void pmix_bfrop_swap16_scalar(void *dst, const void *src, size_t n)
+{
+    size_t i;
+    uint16_t tmp;
+    char *d = (char*)dst;
+    const char *s = (const char*)src;
+
+    for (i=0; i < n; i++) {
+        memcpy(&tmp, s, sizeof(tmp));
+        tmp = pmix_htons(tmp);
+        memcpy(d, &tmp, sizeof(tmp));
+        s += sizeof(tmp);
+        d += sizeof(tmp);
+    }
+}
+
+void pmix_bfrop_swap32_scalar(void *dst, const void *src, size_t n)
+{
+    size_t i;
+    uint32_t tmp;
+    char *d = (char*)dst;
+    const char *s = (const char*)src;
+
+    for (i=0; i < n; i++) {
+        memcpy(&tmp, s, sizeof(tmp));
+        tmp = htonl(tmp);
+        memcpy(d, &tmp, sizeof(tmp));
+        s += sizeof(tmp);
+        d += sizeof(tmp);
+    }
+}
+
+void pmix_bfrop_swap64_scalar(void *dst, const void *src, size_t n)
+{
+    size_t i;
+    uint64_t tmp;
+    char *d = (char*)dst;
+    const char *s = (const char*)src;
+
+    for (i=0; i < n; i++) {
+        memcpy(&tmp, s, sizeof(tmp));
+        tmp = pmix_hton64(tmp);
+        memcpy(d, &tmp, sizeof(tmp));
+        s += sizeof(tmp);
+        d += sizeof(tmp);
+    }
+}
+
+#if PMIX_BFROP_SWAP_X86
+/* byte shuffles reversing each 2, 4 or 8 byte element of a
+ * 16 byte lane - AVX2 shuffles each of its two lanes the same */
+static const uint8_t swap16_mask[32] = {
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+};
+static const uint8_t swap32_mask[32] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+};
+static const uint8_t swap64_mask[32] = {
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+};
+
+/* shuffle whole 16 byte blocks and return how many bytes were done */
+__attribute__((target("ssse3")))
+static size_t swap_ssse3(char *dst, const char *src, size_t nbytes,
+                         const uint8_t *mask)
+{
+    __m128i m = _mm_loadu_si128((const __m128i*)mask);
+    size_t i;
+
+    for (i=0; i + 16 <= nbytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_shuffle_epi8(v, m));
+    }
+    return i;
+}
+
+/* shuffle whole 32 byte blocks and return how many bytes were done */
+__attribute__((target("avx2")))
+static size_t swap_avx2(char *dst, const char *src, size_t nbytes,
+                        const uint8_t *mask)
+{
+    __m256i m = _mm256_loadu_si256((const __m256i*)mask);
+    size_t i;
+
+    for (i=0; i + 32 <= nbytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_shuffle_epi8(v, m));
+    }
+    return i;
+}
+
+/* the block sizes are multiples of every element size, so the
+ * scalar kernel finishes off whole elements */
+#define PMIX_BFROP_SWAP_KERNEL(isa, bits)                                   \
+static void swap ## bits ## _ ## isa(void *dst, const void *src, size_t n)  \
+{                                                                           \
+    size_t done;                                                            \
+    done = swap_ ## isa((char*)dst, (const char*)src,                       \
+                        n * (bits / 8), swap ## bits ## _mask);             \
+    pmix_bfrop_swap ## bits ## _scalar((char*)dst + done,                   \
+                                       (const char*)src + done,             \
+                                       n - done / (bits / 8));              \
+}
+
+PMIX_BFROP_SWAP_KERNEL(ssse3, 16)
+PMIX_BFROP_SWAP_KERNEL(ssse3, 32)
+PMIX_BFROP_SWAP_KERNEL(ssse3, 64)
+PMIX_BFROP_SWAP_KERNEL(avx2, 16)
+PMIX_BFROP_SWAP_KERNEL(avx2, 32)
+PMIX_BFROP_SWAP_KERNEL(avx2, 64)
+#endif
+
+pmix_bfrop_swap_fn_t pmix_bfrop_swap16 = pmix_bfrop_swap16_scalar;
+pmix_bfrop_swap_fn_t pmix_bfrop_swap32 = pmix_bfrop_swap32_scalar;
+pmix_bfrop_swap_fn_t pmix_bfrop_swap64 = pmix_bfrop_swap64_scalar;
+const char *pmix_bfrop_swap_kernel = "scalar";
+
+void pmix_bfrop_swap_init(void)
+{
+#if PMIX_BFROP_SWAP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        pmix_bfrop_swap16 = swap16_avx2;
+        pmix_bfrop_swap32 = swap32_avx2;
+        pmix_bfrop_swap64 = swap64_avx2;
+        pmix_bfrop_swap_kernel = "avx2";
+        return;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        pmix_bfrop_swap16 = swap16_ssse3;
+        pmix_bfrop_swap32 = swap32_ssse3;
+        pmix_bfrop_swap64 = swap64_ssse3;
+        pmix_bfrop_swap_kernel = "ssse3";
+        return;
+    }
+#endif
+    pmix_bfrop_swap16 = pmix_bfrop_swap16_scalar;
+    pmix_bfrop_swap32 = pmix_bfrop_swap32_scalar;
+    pmix_bfrop_swap64 = pmix_bfrop_swap64_scalar;
+    pmix_bfrop_swap_kernel = "scalar";
+}
@@ -239,6 +239,91 @@ typedef pmix_status_t (*pmix_bfrop_unpack_fn_t)(pmix_buffer_t *buffer, void *des
 typedef pmix_status_t (*pmix_bfrop_copy_payload_fn_t)(pmix_buffer_t *dest,
                                                       pmix_buffer_t *src);
 
+/**
+ * Pack a PMIX_BUFFER in place
+ * Everything packed into the buffer between open_nested and the
+ * matching close_nested becomes the payload of a single PMIX_BUFFER
+ * value - it unpacks exactly as if the payload had been packed into
+ * a separate buffer that was then packed as a PMIX_BUFFER, but
+ * without assembling and copying that separate buffer. Nested values
+ * may themselves be packed in place. In a compact buffer the payload
+ * is packed V1, as that separate buffer would be, until the value is
+ * closed.
+ *
+ * @param buffer The buffer to pack into.
+ *
+ * @param size_hint The expected number of payload bytes - room for
+ * them is allocated up front. May be zero.
+ *
+ * @param offset Returns the position of the value in the buffer,
+ * which must be passed to close_nested.
+ */
+typedef pmix_status_t (*pmix_bfrop_open_nested_fn_t)(pmix_buffer_t *buffer,
+                                                     size_t size_hint,
+                                                     size_t *offset);
+
+/**
+ * Complete a PMIX_BUFFER packed in place by setting its size to the
+ * number of bytes packed since the matching open_nested
+ */
+typedef pmix_status_t (*pmix_bfrop_close_nested_fn_t)(pmix_buffer_t *buffer,
+                                                      size_t offset);
+
+/**
+ * Make room for a known amount of data
+ * Grows the buffer so that at least the given number of bytes can
+ * be packed after what it already holds without reallocating it.
+ * Callers that know roughly how much they are about to pack use
+ * this to allocate it all at once.
+ *
+ * @param buffer The buffer to grow.
+ *
+ * @param bytes The number of bytes about to be packed.
+ *
+ * @retval PMIX_SUCCESS The room is available.
+ *
+ * @retval PMIX_ERR_OUT_OF_RESOURCE The buffer could not be grown - it
+ * is left as it was.
+ */
+typedef pmix_status_t (*pmix_bfrop_reserve_fn_t)(pmix_buffer_t *buffer,
+                                                 size_t bytes);
+
+/**
+ * Unpack values without copying them out of the buffer
+ * Works like unpack for PMIX_STRING and PMIX_BYTE_OBJECT values, but
+ * the strings and the bytes of the byte objects returned point into
+ * the buffer instead of being allocated. They are only valid while
+ * the buffer holds its data and must not be freed or modified. A
+ * NULL string unpacks as NULL.
+ *
+ * @retval PMIX_SUCCESS The values were unpacked.
+ *
+ * @retval PMIX_ERR_NOT_SUPPORTED The type can not be unpacked in place.
+ *
+ * @retval PMIX_ERROR(s) As for unpack.
+ */
+typedef pmix_status_t (*pmix_bfrop_unpack_view_fn_t)(pmix_buffer_t *buffer, void *dest,
+                                                     int32_t *max_num_values,
+                                                     pmix_data_type_t type);
+
+/**
+ * Step over packed values without unpacking them
+ * Advances the buffer past the next packed values of the given type
+ * as unpack would, but without returning them. Keys, strings and
+ * byte objects are stepped over in place - values of other types
+ * are unpacked and released. Supports PMIX_STRING, PMIX_BYTE_OBJECT,
+ * PMIX_VALUE and PMIX_KVAL.
+ *
+ * @retval PMIX_SUCCESS The values were stepped over.
+ *
+ * @retval PMIX_ERR_NOT_SUPPORTED The type can not be stepped over.
+ *
+ * @retval PMIX_ERROR(s) As for unpack.
+ */
+typedef pmix_status_t (*pmix_bfrop_skip_fn_t)(pmix_buffer_t *buffer,
+                                              int32_t *max_num_values,
+                                              pmix_data_type_t type);
+
 /**
  * BFROP initialization function.
  *
@@ -305,6 +390,11 @@ struct pmix_bfrop_t {
     pmix_bfrop_copy_fn_t              copy;
     pmix_bfrop_print_fn_t             print;
     pmix_bfrop_copy_payload_fn_t      copy_payload;
+    pmix_bfrop_open_nested_fn_t       open_nested;
+    pmix_bfrop_close_nested_fn_t      close_nested;
+    pmix_bfrop_reserve_fn_t           reserve;
+    pmix_bfrop_unpack_view_fn_t       unpack_view;
+    pmix_bfrop_skip_fn_t              skip;
 };
 typedef struct pmix_bfrop_t pmix_bfrop_t;
 
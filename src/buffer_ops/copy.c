@@ -61,10 +61,15 @@ pmix_status_t pmix_bfrop_copy_payload(pmix_buffer_t *dest, pmix_buffer_t *src)
     if( NULL == dest->base_ptr ){
         /* destination buffer is empty - derive src buffer type */
         dest->type = src->type;
+        dest->version = src->version;
     } else if( dest->type != src->type ){
         /* buffer types mismatch */
         PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
         return PMIX_ERR_BAD_PARAM;
+    } else if( PMIX_BFROP_BUFFER_COMPACT(dest) != PMIX_BFROP_BUFFER_COMPACT(src) ){
+        /* the reader could not tell where one encoding ends */
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        return PMIX_ERR_BAD_PARAM;
     }
 
     to_copy = src->pack_ptr - src->unpack_ptr;
@@ -50,11 +50,30 @@
  */
 #define PMIX_BFROP_DEFAULT_INITIAL_SIZE  128
 /*
- * The default threshold size when we switch from doubling the
- * buffer size to addatively increasing it
+ * The default threshold size above which buffer allocations are
+ * kept in multiples of it
  */
 #define PMIX_BFROP_DEFAULT_THRESHOLD_SIZE 1024
 
+/*
+ * Length that leads floats and doubles packed as binary. A string
+ * length is never negative, so it tells them apart from the decimal
+ * strings older versions pack
+ */
+#define PMIX_BFROP_FP_BINARY    -1
+
+/*
+ * Most bytes a varint of a 64 bit value takes
+ */
+#define PMIX_BFROP_VARINT_MAX   10
+
+/*
+ * Compact buffers pack ranks offset by this much so the special
+ * ranks at the top of the range - UNDEF, WILDCARD and LOCAL_NODE -
+ * wrap around to the smallest varints
+ */
+#define PMIX_BFROP_RANK_BIAS    3
+
 /*
  * Internal type corresponding to size_t.  Do not use this in
  * interface calls - use PMIX_SIZE instead.
@@ -232,6 +251,20 @@ pmix_status_t pmix_bfrop_print(char **output, char *prefix, void *src, pmix_data
 
 pmix_status_t pmix_bfrop_copy_payload(pmix_buffer_t *dest, pmix_buffer_t *src);
 
+pmix_status_t pmix_bfrop_open_nested(pmix_buffer_t *buffer, size_t size_hint,
+                                     size_t *offset);
+
+pmix_status_t pmix_bfrop_close_nested(pmix_buffer_t *buffer, size_t offset);
+
+pmix_status_t pmix_bfrop_reserve(pmix_buffer_t *buffer, size_t bytes);
+
+pmix_status_t pmix_bfrop_unpack_view(pmix_buffer_t *buffer, void *dest,
+                                     int32_t *max_num_vals,
+                                     pmix_data_type_t type);
+
+pmix_status_t pmix_bfrop_skip(pmix_buffer_t *buffer, int32_t *max_num_vals,
+                              pmix_data_type_t type);
+
 /*
  * Specialized functions
  */
@@ -338,6 +371,8 @@ pmix_status_t pmix_bfrop_pack_array(pmix_buffer_t *buffer, const void *src,
                                       int32_t *num_vals, pmix_data_type_t type);
  pmix_status_t pmix_bfrop_unpack_string(pmix_buffer_t *buffer, void *dest,
                                         int32_t *num_vals, pmix_data_type_t type);
+ pmix_status_t pmix_bfrop_unpack_string_view(pmix_buffer_t *buffer, void *dest,
+                                             int32_t *num_vals, pmix_data_type_t type);
  pmix_status_t pmix_bfrop_unpack_sizet(pmix_buffer_t *buffer, void *dest,
                                        int32_t *num_vals, pmix_data_type_t type);
  pmix_status_t pmix_bfrop_unpack_pid(pmix_buffer_t *buffer, void *dest,
@@ -395,6 +430,8 @@ pmix_status_t pmix_bfrop_pack_array(pmix_buffer_t *buffer, const void *src,
                                           int32_t *num_vals, pmix_data_type_t type);
  pmix_status_t pmix_bfrop_unpack_bo(pmix_buffer_t *buffer, void *dest,
                                     int32_t *num_vals, pmix_data_type_t type);
+ pmix_status_t pmix_bfrop_unpack_bo_view(pmix_buffer_t *buffer, void *dest,
+                                         int32_t *num_vals, pmix_data_type_t type);
  pmix_status_t pmix_bfrop_unpack_pdata(pmix_buffer_t *buffer, void *dest,
                                        int32_t *num_vals, pmix_data_type_t type);
  pmix_status_t pmix_bfrop_unpack_ptr(pmix_buffer_t *buffer, void *dest,
@@ -543,6 +580,8 @@ pmix_status_t pmix_bfrop_print_array(char **output, char *prefix,
 
  char* pmix_bfrop_buffer_extend(pmix_buffer_t *bptr, size_t bytes_to_add);
 
+ char* pmix_bfrop_buffer_reserve(pmix_buffer_t *bptr, size_t bytes_to_add);
+
  bool pmix_bfrop_too_small(pmix_buffer_t *buffer, size_t bytes_reqd);
 
  pmix_bfrop_type_info_t* pmix_bfrop_find_type(pmix_data_type_t type);
@@ -551,6 +590,35 @@ pmix_status_t pmix_bfrop_print_array(char **output, char *prefix,
 
  pmix_status_t pmix_bfrop_get_data_type(pmix_buffer_t *buffer, pmix_data_type_t *type);
 
+ pmix_status_t pmix_bfrop_pack_varint(pmix_buffer_t *buffer, uint64_t val);
+
+ void pmix_bfrop_put_varint_fixed(char *dst, uint64_t val);
+
+ pmix_status_t pmix_bfrop_unpack_varint(pmix_buffer_t *buffer, uint64_t *val);
+
+ pmix_status_t pmix_bfrop_pack_count(pmix_buffer_t *buffer, int32_t count);
+
+ pmix_status_t pmix_bfrop_unpack_count(pmix_buffer_t *buffer, int32_t *count);
+
+/*
+ * Byte order conversion of arrays of n 2, 4 or 8 byte integers
+ * between host and network order - the same swap works both
+ * ways. pmix_bfrop_swap_init points the kernels at the fastest
+ * version the CPU we are running on supports
+ */
+ typedef void (*pmix_bfrop_swap_fn_t)(void *dst, const void *src, size_t n);
+
+ extern pmix_bfrop_swap_fn_t pmix_bfrop_swap16;
+ extern pmix_bfrop_swap_fn_t pmix_bfrop_swap32;
+ extern pmix_bfrop_swap_fn_t pmix_bfrop_swap64;
+ extern const char *pmix_bfrop_swap_kernel;
+
+ void pmix_bfrop_swap_init(void);
+
+ void pmix_bfrop_swap16_scalar(void *dst, const void *src, size_t n);
+ void pmix_bfrop_swap32_scalar(void *dst, const void *src, size_t n);
+ void pmix_bfrop_swap64_scalar(void *dst, const void *src, size_t n);
+
  END_C_DECLS
 
 #endif
@@ -27,9 +27,42 @@
 #endif
 
 #include "src/class/pmix_pointer_array.h"
+#include "src/util/error.h"
 
 #include "src/buffer_ops/internal.h"
 
+/* move the buffer to an allocation of to_alloc bytes. The new
+ * space is not cleared - nothing is ever read from it that
+ * wasn't packed there first */
+static char* buffer_realloc(pmix_buffer_t *buffer, size_t to_alloc)
+{
+    size_t pack_offset, unpack_offset;
+    char *ptr;
+
+    if (NULL != buffer->base_ptr) {
+        pack_offset = ((char*) buffer->pack_ptr) - ((char*) buffer->base_ptr);
+        unpack_offset = ((char*) buffer->unpack_ptr) -
+            ((char*) buffer->base_ptr);
+        ptr = (char*)realloc(buffer->base_ptr, to_alloc);
+    } else {
+        pack_offset = 0;
+        unpack_offset = 0;
+        buffer->bytes_used = 0;
+        ptr = (char*)malloc(to_alloc);
+    }
+
+    /* leave the buffer untouched if we couldn't get the space */
+    if (NULL == ptr) {
+        return NULL;
+    }
+    buffer->base_ptr = ptr;
+    buffer->pack_ptr = ((char*) buffer->base_ptr) + pack_offset;
+    buffer->unpack_ptr = ((char*) buffer->base_ptr) + unpack_offset;
+    buffer->bytes_allocated = to_alloc;
+
+    return buffer->pack_ptr;
+}
+
 /**
  * Internal function that resizes (expands) an inuse buffer if
  * necessary.
@@ -37,7 +70,6 @@
 char* pmix_bfrop_buffer_extend(pmix_buffer_t *buffer, size_t bytes_to_add)
 {
     size_t required, to_alloc;
-    size_t pack_offset, unpack_offset;
 
     /* Check to see if we have enough space already */
 
@@ -46,43 +78,52 @@ char* pmix_bfrop_buffer_extend(pmix_buffer_t *buffer, size_t bytes_to_add)
     }
 
     required = buffer->bytes_used + bytes_to_add;
-    if (required >= pmix_bfrop_threshold_size) {
-        to_alloc = ((required + pmix_bfrop_threshold_size - 1)
-                    / pmix_bfrop_threshold_size) * pmix_bfrop_threshold_size;
-    } else {
-        to_alloc = buffer->bytes_allocated;
-        if(0 == to_alloc) {
-            to_alloc = pmix_bfrop_initial_size;
-        }
-        while(to_alloc < required) {
-            to_alloc <<= 1;
+    if (required < buffer->bytes_used) {
+        return NULL;
+    }
+
+    /* grow geometrically at every size so that packing a large
+     * payload a piece at a time copies each byte a bounded number
+     * of times - stepping by the threshold above it made that
+     * quadratic */
+    to_alloc = buffer->bytes_allocated;
+    if (0 == to_alloc) {
+        to_alloc = pmix_bfrop_initial_size;
+    }
+    while (to_alloc < required) {
+        if (to_alloc > SIZE_MAX / 2) {
+            to_alloc = required;
+            break;
         }
+        to_alloc <<= 1;
+    }
+    /* keep large allocations in whole threshold units */
+    if (pmix_bfrop_threshold_size <= to_alloc &&
+        to_alloc <= SIZE_MAX - pmix_bfrop_threshold_size) {
+        to_alloc = ((to_alloc + pmix_bfrop_threshold_size - 1)
+                    / pmix_bfrop_threshold_size) * pmix_bfrop_threshold_size;
     }
 
-    if (NULL != buffer->base_ptr) {
-        pack_offset = ((char*) buffer->pack_ptr) - ((char*) buffer->base_ptr);
-        unpack_offset = ((char*) buffer->unpack_ptr) -
-            ((char*) buffer->base_ptr);
-        buffer->base_ptr = (char*)realloc(buffer->base_ptr, to_alloc);
-        memset(buffer->base_ptr + pack_offset, 0, to_alloc - buffer->bytes_allocated);
-    } else {
-        pack_offset = 0;
-        unpack_offset = 0;
-        buffer->bytes_used = 0;
-        buffer->base_ptr = (char*)malloc(to_alloc);
-        memset(buffer->base_ptr, 0, to_alloc);
+    return buffer_realloc(buffer, to_alloc);
+}
+
+/**
+ * Internal function that makes room for exactly bytes_to_add
+ * more bytes when the caller knows how much is coming
+ */
+char* pmix_bfrop_buffer_reserve(pmix_buffer_t *buffer, size_t bytes_to_add)
+{
+    size_t required;
+
+    if ((buffer->bytes_allocated - buffer->bytes_used) >= bytes_to_add) {
+        return buffer->pack_ptr;
     }
 
-    if (NULL == buffer->base_ptr) {
+    required = buffer->bytes_used + bytes_to_add;
+    if (required < buffer->bytes_used) {
         return NULL;
     }
-    buffer->pack_ptr = ((char*) buffer->base_ptr) + pack_offset;
-    buffer->unpack_ptr = ((char*) buffer->base_ptr) + unpack_offset;
-    buffer->bytes_allocated = to_alloc;
-
-    /* All done */
-
-    return buffer->pack_ptr;
+    return buffer_realloc(buffer, required);
 }
 
 /*
@@ -109,6 +150,104 @@ bool pmix_bfrop_too_small(pmix_buffer_t *buffer, size_t bytes_reqd)
     return false;
 }
 
+/*
+ * Internal functions that pack and unpack an unsigned value as an
+ * LEB128 varint - seven bits to a byte, lowest first, with the top
+ * bit set on every byte but the last
+ */
+pmix_status_t pmix_bfrop_pack_varint(pmix_buffer_t *buffer, uint64_t val)
+{
+    char *dst;
+    size_t n = 0;
+
+    if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, PMIX_BFROP_VARINT_MAX))) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    while (0x80 <= val) {
+        dst[n++] = (char)(0x80 | (val & 0x7f));
+        val >>= 7;
+    }
+    dst[n++] = (char)val;
+
+    buffer->pack_ptr += n;
+    buffer->bytes_used += n;
+    return PMIX_SUCCESS;
+}
+
+/*
+ * Internal function that writes a varint padded out to the full
+ * PMIX_BFROP_VARINT_MAX bytes, so that a value not known yet can
+ * have its place held and be filled in later. Readers take the
+ * padding as high bits of zero
+ */
+void pmix_bfrop_put_varint_fixed(char *dst, uint64_t val)
+{
+    size_t n;
+
+    for (n=0; n < PMIX_BFROP_VARINT_MAX - 1; n++) {
+        dst[n] = (char)(0x80 | (val & 0x7f));
+        val >>= 7;
+    }
+    dst[n] = (char)val;
+}
+
+pmix_status_t pmix_bfrop_unpack_varint(pmix_buffer_t *buffer, uint64_t *val)
+{
+    const uint8_t *src = (const uint8_t*)buffer->unpack_ptr;
+    uint64_t v = 0;
+    size_t n, avail;
+
+    if (buffer->pack_ptr <= buffer->unpack_ptr) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    avail = buffer->pack_ptr - buffer->unpack_ptr;
+
+    for (n=0; n < avail && n < PMIX_BFROP_VARINT_MAX; n++) {
+        v |= (uint64_t)(src[n] & 0x7f) << (7 * n);
+        if (0 == (src[n] & 0x80)) {
+            *val = v;
+            buffer->unpack_ptr += n + 1;
+            return PMIX_SUCCESS;
+        }
+    }
+    if (n == avail) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    /* more bytes than any 64 bit value needs */
+    return PMIX_ERR_UNPACK_FAILURE;
+}
+
+/*
+ * Internal functions for the counts that lead arrays and strings -
+ * an int32 unless the buffer is compact
+ */
+pmix_status_t pmix_bfrop_pack_count(pmix_buffer_t *buffer, int32_t count)
+{
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        return pmix_bfrop_pack_varint(buffer, (uint32_t)count);
+    }
+    return pmix_bfrop_pack_int32(buffer, &count, 1, PMIX_INT32);
+}
+
+pmix_status_t pmix_bfrop_unpack_count(pmix_buffer_t *buffer, int32_t *count)
+{
+    pmix_status_t rc;
+    uint64_t v;
+    int32_t n=1;
+
+    if (!PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        return pmix_bfrop_unpack_int32(buffer, count, &n, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_unpack_varint(buffer, &v))) {
+        return rc;
+    }
+    if (UINT32_MAX < v) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    *count = (int32_t)(uint32_t)v;
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_bfrop_store_data_type(pmix_buffer_t *buffer, pmix_data_type_t type)
 {
     /* Lookup the pack function for the actual pmix_data_type type and call it */
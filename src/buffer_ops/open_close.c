@@ -52,6 +52,11 @@ pmix_bfrop_t pmix_bfrop = {
     pmix_bfrop_copy,
     pmix_bfrop_print,
     pmix_bfrop_copy_payload,
+    pmix_bfrop_open_nested,
+    pmix_bfrop_close_nested,
+    pmix_bfrop_reserve,
+    pmix_bfrop_unpack_view,
+    pmix_bfrop_skip,
 };
 
 /**
@@ -62,10 +67,14 @@ static void pmix_buffer_construct (pmix_buffer_t* buffer)
 {
     /** set the default buffer type */
     buffer->type = pmix_default_buf_type;
+    /* peers may be older than us unless we learn otherwise */
+    buffer->version = PMIX_BFROP_BUFFER_V1;
 
     /* Make everything NULL to begin with */
     buffer->base_ptr = buffer->pack_ptr = buffer->unpack_ptr = NULL;
     buffer->bytes_allocated = buffer->bytes_used = 0;
+    buffer->nested_offset = SIZE_MAX;
+    buffer->nested_version = PMIX_BFROP_BUFFER_V1;
 }
 
 static void pmix_buffer_destruct (pmix_buffer_t* buffer)
@@ -176,6 +185,9 @@ pmix_status_t pmix_bfrop_open(void)
     pmix_bfrop_threshold_size = PMIX_BFROP_DEFAULT_THRESHOLD_SIZE;
     pmix_bfrop_initial_size = 1;
 
+    /* pick the byte order kernels for this CPU */
+    pmix_bfrop_swap_init();
+
     /* Register all the supported types */
     PMIX_REGISTER_TYPE("PMIX_BOOL", PMIX_BOOL,
                        pmix_bfrop_pack_bool,
@@ -53,7 +53,7 @@ pmix_status_t pmix_bfrop_pack(pmix_buffer_t *buffer,
             return rc;
         }
     }
-    if (PMIX_SUCCESS != (rc = pmix_bfrop_pack_int32(buffer, &num_vals, 1, PMIX_INT32))) {
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_pack_count(buffer, num_vals))) {
         return rc;
     }
 
@@ -61,6 +61,122 @@ pmix_status_t pmix_bfrop_pack(pmix_buffer_t *buffer,
     return pmix_bfrop_pack_buffer(buffer, src, num_vals, type);
 }
 
+pmix_status_t pmix_bfrop_open_nested(pmix_buffer_t *buffer, size_t size_hint,
+                                     size_t *offset)
+{
+    pmix_status_t rc;
+    size_t nbytes = 0;
+    char *dst;
+
+    /* check for error */
+    if (NULL == buffer || NULL == offset) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* lay out the same preamble as packing one PMIX_BUFFER */
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(buffer, PMIX_INT32))) {
+            return rc;
+        }
+    }
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_pack_count(buffer, 1))) {
+        return rc;
+    }
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(buffer, PMIX_BUFFER))) {
+            return rc;
+        }
+    }
+
+    /* make room for the size and the payload */
+    if (0 < size_hint &&
+        NULL == pmix_bfrop_buffer_reserve(buffer, size_hint + sizeof(pmix_data_type_t) + PMIX_BFROP_VARINT_MAX)) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+
+    *offset = buffer->bytes_used;
+    if (!PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        /* the number of bytes is packed with a fixed size, so hold
+         * its place until we know it */
+        return pmix_bfrop_pack_sizet(buffer, &nbytes, 1, PMIX_SIZE);
+    }
+
+    /* a compact buffer packs it as a varint - hold the place with
+     * one padded to full width. The payload is read back as a
+     * buffer of its own, which starts out V1, so pack it that way
+     * until the value is closed */
+    if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, PMIX_BFROP_VARINT_MAX))) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    pmix_bfrop_put_varint_fixed(dst, 0);
+    buffer->pack_ptr += PMIX_BFROP_VARINT_MAX;
+    buffer->bytes_used += PMIX_BFROP_VARINT_MAX;
+    buffer->nested_offset = *offset;
+    buffer->nested_version = buffer->version;
+    buffer->version = PMIX_BFROP_BUFFER_V1;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_bfrop_close_nested(pmix_buffer_t *buffer, size_t offset)
+{
+    pmix_status_t rc;
+    pmix_buffer_t hdr;
+    size_t nbytes = 0;
+
+    /* check for error */
+    if (NULL == buffer) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* the outermost value opened in a compact buffer */
+    if (offset == buffer->nested_offset) {
+        if (buffer->bytes_used < offset + PMIX_BFROP_VARINT_MAX) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+        nbytes = buffer->bytes_used - offset - PMIX_BFROP_VARINT_MAX;
+        pmix_bfrop_put_varint_fixed(buffer->base_ptr + offset, nbytes);
+        buffer->version = buffer->nested_version;
+        buffer->nested_offset = SIZE_MAX;
+        return PMIX_SUCCESS;
+    }
+
+    PMIX_CONSTRUCT(&hdr, pmix_buffer_t);
+    hdr.type = buffer->type;
+    hdr.version = buffer->version;
+    /* pack the placeholder again to learn where the payload starts */
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_pack_sizet(&hdr, &nbytes, 1, PMIX_SIZE))) {
+        goto cleanup;
+    }
+    if (buffer->bytes_used < offset + hdr.bytes_used) {
+        rc = PMIX_ERR_BAD_PARAM;
+        goto cleanup;
+    }
+    nbytes = buffer->bytes_used - offset - hdr.bytes_used;
+    hdr.pack_ptr = hdr.base_ptr;
+    hdr.bytes_used = 0;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_pack_sizet(&hdr, &nbytes, 1, PMIX_SIZE))) {
+        goto cleanup;
+    }
+    memcpy(buffer->base_ptr + offset, hdr.base_ptr, hdr.bytes_used);
+
+  cleanup:
+    PMIX_DESTRUCT(&hdr);
+    return rc;
+}
+
+pmix_status_t pmix_bfrop_reserve(pmix_buffer_t *buffer, size_t bytes)
+{
+    /* check for error */
+    if (NULL == buffer) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    if (NULL == pmix_bfrop_buffer_reserve(buffer, bytes)) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_bfrop_pack_buffer(pmix_buffer_t *buffer,
                                      const void *src, int32_t num_vals,
                                      pmix_data_type_t type)
@@ -78,6 +194,35 @@ pmix_status_t pmix_bfrop_pack_buffer(pmix_buffer_t *buffer,
         }
     }
 
+    /* the fixed size types are the most common, so call their
+     * pack functions directly */
+    switch (type) {
+        case PMIX_BYTE:
+        case PMIX_INT8:
+        case PMIX_UINT8:
+            return pmix_bfrop_pack_byte(buffer, src, num_vals, type);
+        case PMIX_INT16:
+        case PMIX_UINT16:
+            return pmix_bfrop_pack_int16(buffer, src, num_vals, type);
+        case PMIX_INT32:
+        case PMIX_UINT32:
+            return pmix_bfrop_pack_int32(buffer, src, num_vals, type);
+        case PMIX_INT64:
+        case PMIX_UINT64:
+            return pmix_bfrop_pack_int64(buffer, src, num_vals, type);
+        case PMIX_INT:
+        case PMIX_UINT:
+            return pmix_bfrop_pack_int(buffer, src, num_vals, type);
+        case PMIX_SIZE:
+            return pmix_bfrop_pack_sizet(buffer, src, num_vals, type);
+        case PMIX_PID:
+            return pmix_bfrop_pack_pid(buffer, src, num_vals, type);
+        case PMIX_PROC_RANK:
+            return pmix_bfrop_pack_rank(buffer, src, num_vals, type);
+        default:
+            break;
+    }
+
     /* Lookup the pack function for this type and call it */
 
     if (NULL == (info = (pmix_bfrop_type_info_t*)pmix_pointer_array_get_item(&pmix_bfrop_types, type))) {
@@ -147,6 +292,18 @@ pmix_status_t pmix_bfrop_pack_sizet(pmix_buffer_t *buffer, const void *src,
                                     int32_t num_vals, pmix_data_type_t type)
  {
     pmix_status_t ret;
+    const size_t *ssrc = (const size_t*)src;
+    int32_t i;
+
+    /* a varint holds any size_t without saying how wide it is */
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        for (i=0; i < num_vals; i++) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_varint(buffer, ssrc[i]))) {
+                return ret;
+            }
+        }
+        return PMIX_SUCCESS;
+    }
 
     /* System types need to always be described so we can properly
        unpack them. */
@@ -208,8 +365,7 @@ pmix_status_t pmix_bfrop_pack_byte(pmix_buffer_t *buffer, const void *src,
 pmix_status_t pmix_bfrop_pack_int16(pmix_buffer_t *buffer, const void *src,
                                     int32_t num_vals, pmix_data_type_t type)
  {
-    int32_t i;
-    uint16_t tmp, *srctmp = (uint16_t*) src;
+    uint16_t tmp;
     char *dst;
 
     pmix_output_verbose(20, pmix_globals.debug_output, "pmix_bfrop_pack_int16 * %d\n", num_vals);
@@ -218,11 +374,7 @@ pmix_status_t pmix_bfrop_pack_int16(pmix_buffer_t *buffer, const void *src,
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        tmp = pmix_htons(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
+    pmix_bfrop_swap16(dst, src, num_vals);
     buffer->pack_ptr += num_vals * sizeof(tmp);
     buffer->bytes_used += num_vals * sizeof(tmp);
 
@@ -235,8 +387,7 @@ pmix_status_t pmix_bfrop_pack_int16(pmix_buffer_t *buffer, const void *src,
 pmix_status_t pmix_bfrop_pack_int32(pmix_buffer_t *buffer, const void *src,
                                     int32_t num_vals, pmix_data_type_t type)
  {
-    int32_t i;
-    uint32_t tmp, *srctmp = (uint32_t*) src;
+    uint32_t tmp;
     char *dst;
 
     pmix_output_verbose(20, pmix_globals.debug_output, "pmix_bfrop_pack_int32 * %d\n", num_vals);
@@ -245,11 +396,7 @@ pmix_status_t pmix_bfrop_pack_int32(pmix_buffer_t *buffer, const void *src,
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        tmp = htonl(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
+    pmix_bfrop_swap32(dst, src, num_vals);
     buffer->pack_ptr += num_vals * sizeof(tmp);
     buffer->bytes_used += num_vals * sizeof(tmp);
 
@@ -259,6 +406,19 @@ pmix_status_t pmix_bfrop_pack_int32(pmix_buffer_t *buffer, const void *src,
 pmix_status_t pmix_bfrop_pack_datatype(pmix_buffer_t *buffer, const void *src,
                                        int32_t num_vals, pmix_data_type_t type)
 {
+    pmix_status_t ret;
+    const pmix_data_type_t *ssrc = (const pmix_data_type_t*)src;
+    int32_t i;
+
+    /* every type defined so far fits in a single byte varint */
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        for (i=0; i < num_vals; i++) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_varint(buffer, ssrc[i]))) {
+                return ret;
+            }
+        }
+        return PMIX_SUCCESS;
+    }
     return pmix_bfrop_pack_int16(buffer, src, num_vals, type);
 }
 
@@ -268,8 +428,7 @@ pmix_status_t pmix_bfrop_pack_datatype(pmix_buffer_t *buffer, const void *src,
 pmix_status_t pmix_bfrop_pack_int64(pmix_buffer_t *buffer, const void *src,
                                     int32_t num_vals, pmix_data_type_t type)
  {
-    int32_t i;
-    uint64_t tmp, tmp2;
+    uint64_t tmp;
     char *dst;
     size_t bytes_packed = num_vals * sizeof(tmp);
 
@@ -279,12 +438,7 @@ pmix_status_t pmix_bfrop_pack_int64(pmix_buffer_t *buffer, const void *src,
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        memcpy(&tmp2, (char *)src+i*sizeof(uint64_t), sizeof(uint64_t));
-        tmp = pmix_hton64(tmp2);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
-    }
+    pmix_bfrop_swap64(dst, src, num_vals);
     buffer->pack_ptr += bytes_packed;
     buffer->bytes_used += bytes_packed;
 
@@ -304,12 +458,12 @@ pmix_status_t pmix_bfrop_pack_string(pmix_buffer_t *buffer, const void *src,
     for (i = 0; i < num_vals; ++i) {
         if (NULL == ssrc[i]) {  /* got zero-length string/NULL pointer - store NULL */
         len = 0;
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_int32(buffer, &len, 1, PMIX_INT32))) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_count(buffer, len))) {
             return ret;
         }
     } else {
         len = (int32_t)strlen(ssrc[i]) + 1;
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_int32(buffer, &len, 1, PMIX_INT32))) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_count(buffer, len))) {
             return ret;
         }
         if (PMIX_SUCCESS != (ret =
@@ -327,10 +481,21 @@ pmix_status_t pmix_bfrop_pack_float(pmix_buffer_t *buffer, const void *src,
                                     int32_t num_vals, pmix_data_type_t type)
 {
     pmix_status_t ret = PMIX_SUCCESS;
-    int32_t i;
+    int32_t i, len;
     float *ssrc = (float*)src;
     char *convert;
 
+    /* pack the bits if the reader can take them - they go as
+     * a uint32 so they are put in network order */
+    if (PMIX_BFROP_BUFFER_V2 <= buffer->version &&
+        sizeof(float) == sizeof(uint32_t) && 0 < num_vals) {
+        len = PMIX_BFROP_FP_BINARY;
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_int32(buffer, &len, 1, PMIX_INT32))) {
+            return ret;
+        }
+        return pmix_bfrop_pack_int32(buffer, src, num_vals, PMIX_UINT32);
+    }
+
     for (i = 0; i < num_vals; ++i) {
         if (0 > asprintf(&convert, "%f", ssrc[i])) {
             return PMIX_ERR_NOMEM;
@@ -350,10 +515,21 @@ pmix_status_t pmix_bfrop_pack_double(pmix_buffer_t *buffer, const void *src,
                                      int32_t num_vals, pmix_data_type_t type)
 {
     pmix_status_t ret = PMIX_SUCCESS;
-    int32_t i;
+    int32_t i, len;
     double *ssrc = (double*)src;
     char *convert;
 
+    /* pack the bits if the reader can take them - they go as
+     * a uint64 so they are put in network order */
+    if (PMIX_BFROP_BUFFER_V2 <= buffer->version &&
+        sizeof(double) == sizeof(uint64_t) && 0 < num_vals) {
+        len = PMIX_BFROP_FP_BINARY;
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_int32(buffer, &len, 1, PMIX_INT32))) {
+            return ret;
+        }
+        return pmix_bfrop_pack_int64(buffer, src, num_vals, PMIX_UINT64);
+    }
+
     for (i = 0; i < num_vals; ++i) {
         if (0 > asprintf(&convert, "%f", ssrc[i])) {
             return PMIX_ERR_NOMEM;
@@ -651,7 +827,12 @@ pmix_status_t pmix_bfrop_pack_info(pmix_buffer_t *buffer, const void *src,
             return ret;
         }
         /* pack the type */
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_int(buffer, &info[i].value.type, 1, PMIX_INT))) {
+        if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+            ret = pmix_bfrop_store_data_type(buffer, info[i].value.type);
+        } else {
+            ret = pmix_bfrop_pack_int(buffer, &info[i].value.type, 1, PMIX_INT);
+        }
+        if (PMIX_SUCCESS != ret) {
             return ret;
         }
         /* pack value */
@@ -683,7 +864,12 @@ pmix_status_t pmix_bfrop_pack_pdata(pmix_buffer_t *buffer, const void *src,
             return ret;
         }
         /* pack the type */
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_int(buffer, &pdata[i].value.type, 1, PMIX_INT))) {
+        if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+            ret = pmix_bfrop_store_data_type(buffer, pdata[i].value.type);
+        } else {
+            ret = pmix_bfrop_pack_int(buffer, &pdata[i].value.type, 1, PMIX_INT);
+        }
+        if (PMIX_SUCCESS != ret) {
             return ret;
         }
         /* pack value */
@@ -922,6 +1108,19 @@ pmix_status_t pmix_bfrop_pack_cmd(pmix_buffer_t *buffer, const void *src,
 pmix_status_t pmix_bfrop_pack_infodirs(pmix_buffer_t *buffer, const void *src,
                                        int32_t num_vals, pmix_data_type_t type)
 {
+    pmix_status_t ret;
+    const pmix_info_directives_t *ssrc = (const pmix_info_directives_t*)src;
+    int32_t i;
+
+    /* the directives are usually none at all */
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        for (i=0; i < num_vals; i++) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_varint(buffer, ssrc[i]))) {
+                return ret;
+            }
+        }
+        return PMIX_SUCCESS;
+    }
     return pmix_bfrop_pack_int32(buffer, src, num_vals, PMIX_UINT32);
 }
 
@@ -1022,6 +1221,18 @@ pmix_status_t pmix_bfrop_pack_darray(pmix_buffer_t *buffer, const void *src,
 pmix_status_t pmix_bfrop_pack_rank(pmix_buffer_t *buffer, const void *src,
                                      int32_t num_vals, pmix_data_type_t type)
 {
+    pmix_status_t ret;
+    const pmix_rank_t *ssrc = (const pmix_rank_t*)src;
+    int32_t i;
+
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        for (i=0; i < num_vals; i++) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_pack_varint(buffer, (pmix_rank_t)(ssrc[i] + PMIX_BFROP_RANK_BIAS)))) {
+                return ret;
+            }
+        }
+        return PMIX_SUCCESS;
+    }
     return pmix_bfrop_pack_int32(buffer, src, num_vals, PMIX_UINT32);
 }
 
@@ -56,6 +56,21 @@ typedef enum pmix_bfrop_buffer_type_t pmix_bfrop_buffer_type_t;
 #define PMIX_BFROP_BUFFER_TYPE_HTON(h);
 #define PMIX_BFROP_BUFFER_TYPE_NTOH(h);
 
+/**
+ * buffer encoding version - the newest encoding the reader of a
+ * buffer is known to understand. Floats and doubles unpack
+ * whichever of V1 or V2 they were packed with, but the varints of
+ * V3 can only be read from a buffer that is itself set to V3, so
+ * the reader must be told the version the writer used
+ */
+#define PMIX_BFROP_BUFFER_V1    0x00    /* floats and doubles as decimal strings */
+#define PMIX_BFROP_BUFFER_V2    0x01    /* floats and doubles as IEEE bits in network order */
+#define PMIX_BFROP_BUFFER_V3    0x02    /* as V2, with counts, sizes, ranks and type tags as varints */
+#define PMIX_BFROP_BUFFER_NEWEST PMIX_BFROP_BUFFER_V3
+
+/* true if the buffer packs counts, sizes, ranks and type tags as varints */
+#define PMIX_BFROP_BUFFER_COMPACT(b) (PMIX_BFROP_BUFFER_V3 <= (b)->version)
+
 /**
  * Structure for holding a buffer */
 typedef struct {
@@ -63,6 +78,8 @@ typedef struct {
     pmix_object_t parent;
     /** type of buffer */
     pmix_bfrop_buffer_type_t type;
+    /** encoding version to pack with */
+    uint8_t version;
     /** Start of my memory */
     char *base_ptr;
     /** Where the next data will be packed to (within the allocated
@@ -77,6 +94,12 @@ typedef struct {
     /** Number of bytes used by the buffer (i.e., amount of data --
         including overhead -- packed in the buffer) */
     size_t bytes_used;
+    /** Offset of the PMIX_BUFFER being packed in place in a compact
+        buffer, or SIZE_MAX if there is none. Its payload is packed
+        V1 - as a separately packed buffer would be - and the
+        buffer goes back to nested_version when it is closed */
+    size_t nested_offset;
+    uint8_t nested_version;
 } pmix_buffer_t;
 PMIX_CLASS_DECLARATION (pmix_buffer_t);
 
@@ -33,12 +33,154 @@
 #include "src/buffer_ops/types.h"
 #include "src/buffer_ops/internal.h"
 
+static pmix_status_t unpack_values(pmix_buffer_t *buffer,
+                                   void *dst, int32_t *num_vals,
+                                   pmix_data_type_t type, bool view);
+static pmix_status_t skip_values(pmix_buffer_t *buffer, int32_t n,
+                                 pmix_data_type_t type);
+static pmix_status_t unpack_val(pmix_buffer_t *buffer, pmix_value_t *val);
+
 pmix_status_t pmix_bfrop_unpack(pmix_buffer_t *buffer,
                                 void *dst, int32_t *num_vals,
                                 pmix_data_type_t type)
+{
+    return unpack_values(buffer, dst, num_vals, type, false);
+}
+
+pmix_status_t pmix_bfrop_unpack_view(pmix_buffer_t *buffer,
+                                     void *dst, int32_t *num_vals,
+                                     pmix_data_type_t type)
+{
+    if (PMIX_STRING != type && PMIX_BYTE_OBJECT != type) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    return unpack_values(buffer, dst, num_vals, type, true);
+}
+
+/* step over one packed value - only the types that unpack without
+ * allocating anything are stepped over in place */
+static pmix_status_t skip_value(pmix_buffer_t *buffer)
+{
+    pmix_value_t val;
+    pmix_status_t rc;
+
+    PMIX_VALUE_CONSTRUCT(&val);
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_get_data_type(buffer, &val.type))) {
+        return rc;
+    }
+    if (PMIX_STRING == val.type || PMIX_BYTE_OBJECT == val.type) {
+        return skip_values(buffer, 1, val.type);
+    }
+    if (PMIX_SUCCESS != (rc = unpack_val(buffer, &val))) {
+        return rc;
+    }
+    PMIX_VALUE_DESTRUCT(&val);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t skip_values(pmix_buffer_t *buffer, int32_t n,
+                                 pmix_data_type_t type)
+{
+    pmix_byte_object_t bo;
+    pmix_data_type_t local_type;
+    char *str;
+    int32_t i, m;
+    pmix_status_t rc;
+
+    /* check the type as pmix_bfrop_unpack_buffer would */
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_get_data_type(buffer, &local_type))) {
+            return rc;
+        }
+        if (type != local_type) {
+            return PMIX_ERR_PACK_MISMATCH;
+        }
+    }
+
+    for (i=0; i < n; i++) {
+        m = 1;
+        switch (type) {
+            case PMIX_STRING:
+                rc = pmix_bfrop_unpack_string_view(buffer, &str, &m, PMIX_STRING);
+                break;
+            case PMIX_BYTE_OBJECT:
+                rc = pmix_bfrop_unpack_bo_view(buffer, &bo, &m, PMIX_BYTE_OBJECT);
+                break;
+            case PMIX_VALUE:
+                rc = skip_value(buffer);
+                break;
+            case PMIX_KVAL:
+                /* the key is packed without a type */
+                if (PMIX_SUCCESS == (rc = pmix_bfrop_unpack_string_view(buffer, &str, &m, PMIX_STRING))) {
+                    rc = skip_value(buffer);
+                }
+                break;
+            default:
+                rc = PMIX_ERR_NOT_SUPPORTED;
+                break;
+        }
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_bfrop_skip(pmix_buffer_t *buffer, int32_t *num_vals,
+                              pmix_data_type_t type)
+{
+    pmix_status_t rc, ret;
+    int32_t local_num;
+    pmix_data_type_t local_type;
+
+    /* check for error */
+    if (NULL == buffer || NULL == num_vals) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if (PMIX_STRING != type && PMIX_BYTE_OBJECT != type &&
+        PMIX_VALUE != type && PMIX_KVAL != type) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    if (0 == *num_vals) {
+        return PMIX_ERR_UNPACK_INADEQUATE_SPACE;
+    }
+
+    /* the declared number of values, as unpack reads it */
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_get_data_type(buffer, &local_type))) {
+            *num_vals = 0;
+            return rc;
+        }
+        if (PMIX_INT32 != local_type) {
+            *num_vals = 0;
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+    }
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_unpack_count(buffer, &local_num))) {
+        *num_vals = 0;
+        return rc;
+    }
+    if (local_num > *num_vals) {
+        local_num = *num_vals;
+        ret = PMIX_ERR_UNPACK_INADEQUATE_SPACE;
+    } else {
+        *num_vals = local_num;
+        ret = PMIX_SUCCESS;
+    }
+
+    if (PMIX_SUCCESS != (rc = skip_values(buffer, local_num, type))) {
+        *num_vals = 0;
+        ret = rc;
+    }
+    return ret;
+}
+
+static pmix_status_t unpack_values(pmix_buffer_t *buffer,
+                                   void *dst, int32_t *num_vals,
+                                   pmix_data_type_t type, bool view)
  {
     pmix_status_t rc, ret;
-    int32_t local_num, n=1;
+    int32_t local_num;
     pmix_data_type_t local_type;
 
     /* check for error */
@@ -77,8 +219,7 @@ pmix_status_t pmix_bfrop_unpack(pmix_buffer_t *buffer,
         }
     }
 
-    n=1;
-    if (PMIX_SUCCESS != (rc = pmix_bfrop_unpack_int32(buffer, &local_num, &n, PMIX_INT32))) {
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_unpack_count(buffer, &local_num))) {
         *num_vals = 0;
             /* don't error log here as the user may be unpacking past
              * the end of the buffer, which isn't necessarily an error */
@@ -104,7 +245,27 @@ pmix_status_t pmix_bfrop_unpack(pmix_buffer_t *buffer,
     }
 
     /** Unpack the value(s) */
-    if (PMIX_SUCCESS != (rc = pmix_bfrop_unpack_buffer(buffer, dst, &local_num, type))) {
+    if (view) {
+        /* check the type as pmix_bfrop_unpack_buffer would */
+        if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+            if (PMIX_SUCCESS != (rc = pmix_bfrop_get_data_type(buffer, &local_type))) {
+                *num_vals = 0;
+                return rc;
+            }
+            if (type != local_type) {
+                *num_vals = 0;
+                return PMIX_ERR_PACK_MISMATCH;
+            }
+        }
+        if (PMIX_STRING == type) {
+            rc = pmix_bfrop_unpack_string_view(buffer, dst, &local_num, type);
+        } else {
+            rc = pmix_bfrop_unpack_bo_view(buffer, dst, &local_num, type);
+        }
+    } else {
+        rc = pmix_bfrop_unpack_buffer(buffer, dst, &local_num, type);
+    }
+    if (PMIX_SUCCESS != rc) {
         *num_vals = 0;
         ret = rc;
     }
@@ -134,6 +295,35 @@ pmix_status_t pmix_bfrop_unpack_buffer(pmix_buffer_t *buffer, void *dst, int32_t
         }
     }
 
+    /* the fixed size types are the most common, so call their
+     * unpack functions directly */
+    switch (type) {
+        case PMIX_BYTE:
+        case PMIX_INT8:
+        case PMIX_UINT8:
+            return pmix_bfrop_unpack_byte(buffer, dst, num_vals, type);
+        case PMIX_INT16:
+        case PMIX_UINT16:
+            return pmix_bfrop_unpack_int16(buffer, dst, num_vals, type);
+        case PMIX_INT32:
+        case PMIX_UINT32:
+            return pmix_bfrop_unpack_int32(buffer, dst, num_vals, type);
+        case PMIX_INT64:
+        case PMIX_UINT64:
+            return pmix_bfrop_unpack_int64(buffer, dst, num_vals, type);
+        case PMIX_INT:
+        case PMIX_UINT:
+            return pmix_bfrop_unpack_int(buffer, dst, num_vals, type);
+        case PMIX_SIZE:
+            return pmix_bfrop_unpack_sizet(buffer, dst, num_vals, type);
+        case PMIX_PID:
+            return pmix_bfrop_unpack_pid(buffer, dst, num_vals, type);
+        case PMIX_PROC_RANK:
+            return pmix_bfrop_unpack_rank(buffer, dst, num_vals, type);
+        default:
+            break;
+    }
+
     /* Lookup the unpack function for this type and call it */
 
     if (NULL == (info = (pmix_bfrop_type_info_t*)pmix_pointer_array_get_item(&pmix_bfrop_types, type))) {
@@ -214,6 +404,22 @@ pmix_status_t pmix_bfrop_unpack_sizet(pmix_buffer_t *buffer, void *dest,
  {
     pmix_status_t ret;
     pmix_data_type_t remote_type;
+    size_t *sdest = (size_t*)dest;
+    uint64_t v;
+    int32_t i;
+
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        for (i=0; i < *num_vals; i++) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_varint(buffer, &v))) {
+                return ret;
+            }
+            if (SIZE_MAX < v) {
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
+            sdest[i] = (size_t)v;
+        }
+        return PMIX_SUCCESS;
+    }
 
     if (PMIX_SUCCESS != (ret = pmix_bfrop_get_data_type(buffer, &remote_type))) {
         return ret;
@@ -285,8 +491,7 @@ pmix_status_t pmix_bfrop_unpack_byte(pmix_buffer_t *buffer, void *dest,
 pmix_status_t pmix_bfrop_unpack_int16(pmix_buffer_t *buffer, void *dest,
                                       int32_t *num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint16_t tmp, *desttmp = (uint16_t*) dest;
+    uint16_t tmp;
 
     pmix_output_verbose(20, pmix_globals.debug_output, "pmix_bfrop_unpack_int16 * %d\n", (int)*num_vals);
     /* check to see if there's enough data in buffer */
@@ -295,12 +500,8 @@ pmix_status_t pmix_bfrop_unpack_int16(pmix_buffer_t *buffer, void *dest,
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
-        tmp = pmix_ntohs(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    pmix_bfrop_swap16(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -308,8 +509,7 @@ pmix_status_t pmix_bfrop_unpack_int16(pmix_buffer_t *buffer, void *dest,
 pmix_status_t pmix_bfrop_unpack_int32(pmix_buffer_t *buffer, void *dest,
                                       int32_t *num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint32_t tmp, *desttmp = (uint32_t*) dest;
+    uint32_t tmp;
 
     pmix_output_verbose(20, pmix_globals.debug_output, "pmix_bfrop_unpack_int32 * %d\n", (int)*num_vals);
     /* check to see if there's enough data in buffer */
@@ -318,12 +518,8 @@ pmix_status_t pmix_bfrop_unpack_int32(pmix_buffer_t *buffer, void *dest,
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
-        tmp = ntohl(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    pmix_bfrop_swap32(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -331,14 +527,30 @@ pmix_status_t pmix_bfrop_unpack_int32(pmix_buffer_t *buffer, void *dest,
 pmix_status_t pmix_bfrop_unpack_datatype(pmix_buffer_t *buffer, void *dest,
                                          int32_t *num_vals, pmix_data_type_t type)
 {
+    pmix_status_t ret;
+    pmix_data_type_t *sdest = (pmix_data_type_t*)dest;
+    uint64_t v;
+    int32_t i;
+
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        for (i=0; i < *num_vals; i++) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_varint(buffer, &v))) {
+                return ret;
+            }
+            if (UINT16_MAX < v) {
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
+            sdest[i] = (pmix_data_type_t)v;
+        }
+        return PMIX_SUCCESS;
+    }
     return pmix_bfrop_unpack_int16(buffer, dest, num_vals, type);
 }
 
 pmix_status_t pmix_bfrop_unpack_int64(pmix_buffer_t *buffer, void *dest,
                                       int32_t *num_vals, pmix_data_type_t type)
 {
-    int32_t i;
-    uint64_t tmp, *desttmp = (uint64_t*) dest;
+    uint64_t tmp;
 
     pmix_output_verbose(20, pmix_globals.debug_output, "pmix_bfrop_unpack_int64 * %d\n", (int)*num_vals);
     /* check to see if there's enough data in buffer */
@@ -347,12 +559,8 @@ pmix_status_t pmix_bfrop_unpack_int64(pmix_buffer_t *buffer, void *dest,
     }
 
     /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
-        tmp = pmix_ntoh64(tmp);
-        memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
-    }
+    pmix_bfrop_swap64(dest, buffer->unpack_ptr, *num_vals);
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -361,11 +569,11 @@ pmix_status_t pmix_bfrop_unpack_string(pmix_buffer_t *buffer, void *dest,
                                        int32_t *num_vals, pmix_data_type_t type)
 {
     pmix_status_t ret;
-    int32_t i, len, n=1;
+    int32_t i, len;
     char **sdest = (char**) dest;
 
     for (i = 0; i < (*num_vals); ++i) {
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_int32(buffer, &len, &n, PMIX_INT32))) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_count(buffer, &len))) {
             return ret;
         }
         if (0 ==  len) {   /* zero-length string - unpack the NULL */
@@ -384,10 +592,60 @@ pmix_status_t pmix_bfrop_unpack_string(pmix_buffer_t *buffer, void *dest,
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_bfrop_unpack_string_view(pmix_buffer_t *buffer, void *dest,
+                                            int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_status_t ret;
+    int32_t i, len;
+    char **sdest = (char**) dest;
+
+    for (i = 0; i < (*num_vals); ++i) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_count(buffer, &len))) {
+            return ret;
+        }
+        if (0 ==  len) {   /* zero-length string - unpack the NULL */
+            sdest[i] = NULL;
+            continue;
+        }
+        if (0 > len || pmix_bfrop_too_small(buffer, len)) {
+            return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        }
+        /* the terminator was packed with the string - make sure
+         * it is there before handing out a pointer to it */
+        if ('\0' != buffer->unpack_ptr[len-1]) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        sdest[i] = buffer->unpack_ptr;
+        buffer->unpack_ptr += len;
+    }
+
+    return PMIX_SUCCESS;
+}
+
+/* get the decimal string a float or double was packed as without
+ * copying it out of the buffer - returns NULL in str for a NULL */
+static pmix_status_t unpack_fp_string(pmix_buffer_t *buffer, int32_t len,
+                                      char **str)
+{
+    *str = NULL;
+    if (0 == len) {
+        return PMIX_SUCCESS;
+    }
+    if (0 > len || pmix_bfrop_too_small(buffer, len)) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    if ('\0' != buffer->unpack_ptr[len-1]) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    *str = buffer->unpack_ptr;
+    buffer->unpack_ptr += len;
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_bfrop_unpack_float(pmix_buffer_t *buffer, void *dest,
                                       int32_t *num_vals, pmix_data_type_t type)
 {
-    int32_t i, n;
+    int32_t i, n, len;
     float *desttmp = (float*) dest, tmp;
     pmix_status_t ret;
     char *convert;
@@ -401,14 +659,21 @@ pmix_status_t pmix_bfrop_unpack_float(pmix_buffer_t *buffer, void *dest,
     /* unpack the data */
     for (i = 0; i < (*num_vals); ++i) {
         n=1;
-        convert = NULL;
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string(buffer, &convert, &n, PMIX_STRING))) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_int32(buffer, &len, &n, PMIX_INT32))) {
+            return ret;
+        }
+        if (PMIX_BFROP_FP_BINARY == len && 0 == i &&
+            sizeof(float) == sizeof(uint32_t)) {
+            /* the rest are the bits */
+            n = *num_vals;
+            return pmix_bfrop_unpack_int32(buffer, dest, &n, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS != (ret = unpack_fp_string(buffer, len, &convert))) {
             return ret;
         }
         if (NULL != convert) {
             tmp = strtof(convert, NULL);
             memcpy(&desttmp[i], &tmp, sizeof(tmp));
-            free(convert);
         }
     }
     return PMIX_SUCCESS;
@@ -417,7 +682,7 @@ pmix_status_t pmix_bfrop_unpack_float(pmix_buffer_t *buffer, void *dest,
 pmix_status_t pmix_bfrop_unpack_double(pmix_buffer_t *buffer, void *dest,
                                        int32_t *num_vals, pmix_data_type_t type)
 {
-    int32_t i, n;
+    int32_t i, n, len;
     double *desttmp = (double*) dest, tmp;
     pmix_status_t ret;
     char *convert;
@@ -431,14 +696,21 @@ pmix_status_t pmix_bfrop_unpack_double(pmix_buffer_t *buffer, void *dest,
     /* unpack the data */
     for (i = 0; i < (*num_vals); ++i) {
         n=1;
-        convert = NULL;
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string(buffer, &convert, &n, PMIX_STRING))) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_int32(buffer, &len, &n, PMIX_INT32))) {
+            return ret;
+        }
+        if (PMIX_BFROP_FP_BINARY == len && 0 == i &&
+            sizeof(double) == sizeof(uint64_t)) {
+            /* the rest are the bits */
+            n = *num_vals;
+            return pmix_bfrop_unpack_int64(buffer, dest, &n, PMIX_UINT64);
+        }
+        if (PMIX_SUCCESS != (ret = unpack_fp_string(buffer, len, &convert))) {
             return ret;
         }
         if (NULL != convert) {
             tmp = strtod(convert, NULL);
             memcpy(&desttmp[i], &tmp, sizeof(tmp));
-            free(convert);
         }
     }
     return PMIX_SUCCESS;
@@ -758,14 +1030,13 @@ pmix_status_t pmix_bfrop_unpack_info(pmix_buffer_t *buffer, void *dest,
         /* unpack key */
         m=1;
         tmp = NULL;
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string(buffer, &tmp, &m, PMIX_STRING))) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string_view(buffer, &tmp, &m, PMIX_STRING))) {
             return ret;
         }
         if (NULL == tmp) {
             return PMIX_ERROR;
         }
         (void)strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
         /* unpack the flags */
         m=1;
         if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_infodirs(buffer, &ptr[i].flags, &m, PMIX_INFO_DIRECTIVES))) {
@@ -775,7 +1046,12 @@ pmix_status_t pmix_bfrop_unpack_info(pmix_buffer_t *buffer, void *dest,
          * instead of a pointer in this struct, we directly unpack it to
          * avoid the malloc */
          m=1;
-         if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_int(buffer, &ptr[i].value.type, &m, PMIX_INT))) {
+         if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+            ret = pmix_bfrop_get_data_type(buffer, &ptr[i].value.type);
+         } else {
+            ret = pmix_bfrop_unpack_int(buffer, &ptr[i].value.type, &m, PMIX_INT);
+         }
+         if (PMIX_SUCCESS != ret) {
             return ret;
         }
         pmix_output_verbose(20, pmix_globals.debug_output,
@@ -812,19 +1088,23 @@ pmix_status_t pmix_bfrop_unpack_pdata(pmix_buffer_t *buffer, void *dest,
         /* unpack key */
         m=1;
         tmp = NULL;
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string(buffer, &tmp, &m, PMIX_STRING))) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string_view(buffer, &tmp, &m, PMIX_STRING))) {
             return ret;
         }
         if (NULL == tmp) {
             return PMIX_ERROR;
         }
         (void)strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
         /* unpack value - since the value structure is statically-defined
          * instead of a pointer in this struct, we directly unpack it to
          * avoid the malloc */
          m=1;
-         if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_int(buffer, &ptr[i].value.type, &m, PMIX_INT))) {
+         if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+            ret = pmix_bfrop_get_data_type(buffer, &ptr[i].value.type);
+         } else {
+            ret = pmix_bfrop_unpack_int(buffer, &ptr[i].value.type, &m, PMIX_INT);
+         }
+         if (PMIX_SUCCESS != ret) {
             return ret;
         }
         pmix_output_verbose(20, pmix_globals.debug_output,
@@ -897,14 +1177,13 @@ pmix_status_t pmix_bfrop_unpack_proc(pmix_buffer_t *buffer, void *dest,
         /* unpack nspace */
         m=1;
         tmp = NULL;
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string(buffer, &tmp, &m, PMIX_STRING))) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string_view(buffer, &tmp, &m, PMIX_STRING))) {
             return ret;
         }
         if (NULL == tmp) {
             return PMIX_ERROR;
         }
         (void)strncpy(ptr[i].nspace, tmp, PMIX_MAX_NSLEN);
-        free(tmp);
         /* unpack the rank */
         m=1;
         if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_rank(buffer, &ptr[i].rank, &m, PMIX_PROC_RANK))) {
@@ -946,14 +1225,13 @@ pmix_status_t pmix_bfrop_unpack_app(pmix_buffer_t *buffer, void *dest,
         for (k=0; k < ptr[i].argc; k++) {
             m=1;
             tmp = NULL;
-            if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string(buffer, &tmp, &m, PMIX_STRING))) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string_view(buffer, &tmp, &m, PMIX_STRING))) {
                 return ret;
             }
             if (NULL == tmp) {
                 return PMIX_ERROR;
             }
             pmix_argv_append_nosize(&ptr[i].argv, tmp);
-            free(tmp);
         }
         /* unpack env */
         m=1;
@@ -963,14 +1241,13 @@ pmix_status_t pmix_bfrop_unpack_app(pmix_buffer_t *buffer, void *dest,
         for (k=0; k < nval; k++) {
             m=1;
             tmp = NULL;
-            if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string(buffer, &tmp, &m, PMIX_STRING))) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_string_view(buffer, &tmp, &m, PMIX_STRING))) {
                 return ret;
             }
             if (NULL == tmp) {
                 return PMIX_ERROR;
             }
             pmix_argv_append_nosize(&ptr[i].env, tmp);
-            free(tmp);
         }
         /* unpack maxprocs */
         m=1;
@@ -1168,6 +1445,23 @@ pmix_status_t pmix_bfrop_unpack_cmd(pmix_buffer_t *buffer, void *dest,
 pmix_status_t pmix_bfrop_unpack_infodirs(pmix_buffer_t *buffer, void *dest,
                                          int32_t *num_vals, pmix_data_type_t type)
 {
+    pmix_status_t ret;
+    pmix_info_directives_t *sdest = (pmix_info_directives_t*)dest;
+    uint64_t v;
+    int32_t i;
+
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        for (i=0; i < *num_vals; i++) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_varint(buffer, &v))) {
+                return ret;
+            }
+            if (UINT32_MAX < v) {
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
+            sdest[i] = (pmix_info_directives_t)v;
+        }
+        return PMIX_SUCCESS;
+    }
     return pmix_bfrop_unpack_int32(buffer, dest, num_vals, PMIX_UINT32);
 }
 
@@ -1202,6 +1496,35 @@ pmix_status_t pmix_bfrop_unpack_bo(pmix_buffer_t *buffer, void *dest,
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_bfrop_unpack_bo_view(pmix_buffer_t *buffer, void *dest,
+                                        int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_byte_object_t *ptr;
+    int32_t i, n, m;
+    pmix_status_t ret;
+
+    ptr = (pmix_byte_object_t *) dest;
+    n = *num_vals;
+
+    for (i = 0; i < n; ++i) {
+        memset(&ptr[i], 0, sizeof(pmix_byte_object_t));
+        /* unpack the number of bytes */
+        m=1;
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_sizet(buffer, &ptr[i].size, &m, PMIX_SIZE))) {
+            return ret;
+        }
+        if (0 < ptr[i].size) {
+            if (pmix_bfrop_too_small(buffer, ptr[i].size)) {
+                ptr[i].size = 0;
+                return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+            }
+            ptr[i].bytes = buffer->unpack_ptr;
+            buffer->unpack_ptr += ptr[i].size;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_bfrop_unpack_ptr(pmix_buffer_t *buffer, void *dest,
                           int32_t *num_vals, pmix_data_type_t type)
 {
@@ -1384,6 +1707,23 @@ pmix_status_t pmix_bfrop_unpack_darray(pmix_buffer_t *buffer, void *dest,
 pmix_status_t pmix_bfrop_unpack_rank(pmix_buffer_t *buffer, void *dest,
                                      int32_t *num_vals, pmix_data_type_t type)
 {
+    pmix_status_t ret;
+    pmix_rank_t *sdest = (pmix_rank_t*)dest;
+    uint64_t v;
+    int32_t i;
+
+    if (PMIX_BFROP_BUFFER_COMPACT(buffer)) {
+        for (i=0; i < *num_vals; i++) {
+            if (PMIX_SUCCESS != (ret = pmix_bfrop_unpack_varint(buffer, &v))) {
+                return ret;
+            }
+            if (UINT32_MAX < v) {
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
+            sdest[i] = (pmix_rank_t)((pmix_rank_t)v - PMIX_BFROP_RANK_BIAS);
+        }
+        return PMIX_SUCCESS;
+    }
     return pmix_bfrop_unpack_int32(buffer, dest, num_vals, PMIX_UINT32);
 }
 
@@ -75,6 +75,9 @@
 #define PMIX_MAX_RETRIES 10
 
 static pmix_status_t usock_connect(struct sockaddr *address, int *fd);
+static pmix_status_t _process_map_blob(pmix_nspace_t *nsptr,
+                                       pmix_byte_object_t *bo,
+                                       bool store_hosts);
 
 static void _notify_complete(pmix_status_t status, void *cbdata)
 {
@@ -156,7 +159,9 @@ static void pmix_client_notify_recv(struct pmix_peer_t *peer, pmix_usock_hdr_t *
 }
 
 
-pmix_client_globals_t pmix_client_globals = {{{0}}};
+pmix_client_globals_t pmix_client_globals = {
+    .lock = PTHREAD_MUTEX_INITIALIZER
+};
 
 /* callback for wait completion */
 static void wait_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
@@ -168,9 +173,38 @@ static void wait_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
                         "pmix:client recv callback activated with %d bytes",
                         (NULL == buf) ? -1 : (int)buf->bytes_used);
 
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
 
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+static pmix_status_t _load_job_map(const char *nspace)
+{
+    pmix_status_t rc;
+    pmix_value_t *val = NULL;
+    pmix_nspace_t *nsptr;
+
+    nsptr = pmix_nspace_lookup(nspace);
+    if (NULL == nsptr) {
+        nsptr = PMIX_NEW(pmix_nspace_t);
+        (void)strncpy(nsptr->nspace, nspace, PMIX_MAX_NSLEN);
+        pmix_nspace_add(nsptr);
+    }
+
+    if (PMIX_SUCCESS != pmix_dstore_fetch(nspace, PMIX_RANK_WILDCARD, PMIX_MAP_BLOB, &val)) {
+        /* the host didn't provide a map */
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_BYTE_OBJECT != val->type) {
+        PMIX_ERROR_LOG(PMIX_ERR_TYPE_MISMATCH);
+        PMIX_VALUE_RELEASE(val);
+        return PMIX_ERR_TYPE_MISMATCH;
+    }
+    rc = _process_map_blob(nsptr, &val->data.bo, false);
+    PMIX_VALUE_RELEASE(val);
+    return rc;
+}
+#endif /* PMIX_ENABLE_DSTORE */
+
 /* callback to receive job info */
 static void job_data(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
                      pmix_buffer_t *buf, void *cbdata)
@@ -185,13 +219,26 @@ static void job_data(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
     if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(buf, &nspace, &cnt, PMIX_STRING))) {
         PMIX_ERROR_LOG(rc);
         cb->status = PMIX_ERROR;
-        cb->active = false;
+        PMIX_WAKEUP_THREAD(cb->active);
         return;
     }
+    free(nspace);
     /* decode it */
+    pthread_mutex_lock(&pmix_client_globals.lock);
     pmix_client_process_nspace_blob(pmix_globals.myid.nspace, buf);
+    pthread_mutex_unlock(&pmix_client_globals.lock);
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    /* the server only sent us a handle - everything else about
+     * our job is read from the dstore as needed, except for the
+     * node map which is required to resolve peers and nodes */
+    if (PMIX_SUCCESS != (rc = _load_job_map(pmix_globals.myid.nspace))) {
+        cb->status = rc;
+        PMIX_WAKEUP_THREAD(cb->active);
+        return;
+    }
+#endif /* PMIX_ENABLE_DSTORE */
     cb->status = PMIX_SUCCESS;
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
 
 static pmix_status_t connect_to_server(struct sockaddr_un *address, void *cbdata)
@@ -319,7 +366,7 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc,
     (void)strncpy(pmix_globals.myid.nspace, evar, PMIX_MAX_NSLEN);
     nsptr = PMIX_NEW(pmix_nspace_t);
     (void)strncpy(nsptr->nspace, evar, PMIX_MAX_NSLEN);
-    pmix_list_append(&pmix_globals.nspaces, &nsptr->super);
+    pmix_nspace_add(nsptr);
 
     /* if we don't have a path to the daemon rendezvous point,
      * then we need to return an error */
@@ -674,7 +721,7 @@ PMIX_EXPORT pmix_status_t PMIx_Abort(int flag, const char msg[],
     done:
     PMIX_RELEASE(kv);  // maintain accounting
     cb->pstatus = rc;
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
 
 PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope, const char key[], pmix_value_t *val)
@@ -697,11 +744,19 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope, const char key[], pmix_va
     cb->key = (char*)key;
     cb->value = val;
 
-    /* pass this into the event library for thread protection */
-    PMIX_THREADSHIFT(cb, _putfn);
+    if (pmix_globals.server) {
+        /* pass this into the event library for thread protection */
+        PMIX_THREADSHIFT(cb, _putfn);
 
-    /* wait for the result */
-    PMIX_WAIT_FOR_COMPLETION(cb->active);
+        /* wait for the result */
+        PMIX_WAIT_FOR_COMPLETION(cb->active);
+    } else {
+        /* putting never involves the server, so there is no need to
+         * go thru the event library - just protect the caches */
+        pthread_mutex_lock(&pmix_client_globals.lock);
+        _putfn(0, 0, cb);
+        pthread_mutex_unlock(&pmix_client_globals.lock);
+    }
     rc = cb->pstatus;
     PMIX_RELEASE(cb);
 
@@ -717,6 +772,9 @@ static void _commitfn(int sd, short args, void *cbdata)
     pmix_cmd_t cmd=PMIX_COMMIT_CMD;
 
     msgout = PMIX_NEW(pmix_buffer_t);
+    /* use the encoding we agreed on with the server - the blobs
+     * inside are packed by PMIx_Put and keep their own */
+    msgout->version = pmix_client_globals.myserver.bfrop_version;
     /* pack the cmd */
     if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(msgout, &cmd, 1, PMIX_CMD))) {
         PMIX_ERROR_LOG(rc);
@@ -724,18 +782,20 @@ static void _commitfn(int sd, short args, void *cbdata)
         goto done;
     }
 
+    /* the caches are filled by PMIx_Put on the caller's thread */
+    pthread_mutex_lock(&pmix_client_globals.lock);
     /* if we haven't already done it, ensure we have committed our values */
     if (NULL != pmix_globals.cache_local) {
         scope = PMIX_LOCAL;
         if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(msgout, &scope, 1, PMIX_SCOPE))) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(msgout);
-            goto done;
+            goto unlock;
         }
         if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(msgout, &pmix_globals.cache_local, 1, PMIX_BUFFER))) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(msgout);
-            goto done;
+            goto unlock;
         }
         PMIX_RELEASE(pmix_globals.cache_local);
     }
@@ -744,24 +804,28 @@ static void _commitfn(int sd, short args, void *cbdata)
         if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(msgout, &scope, 1, PMIX_SCOPE))) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(msgout);
-            goto done;
+            goto unlock;
         }
         if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(msgout, &pmix_globals.cache_remote, 1, PMIX_BUFFER))) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(msgout);
-            goto done;
+            goto unlock;
         }
         PMIX_RELEASE(pmix_globals.cache_remote);
     }
+    pthread_mutex_unlock(&pmix_client_globals.lock);
 
     /* push the message into our event base to send to the server - always
      * send, even if we have nothing to contribute, so the server knows
      * that we contributed whatever we had */
      PMIX_ACTIVATE_SEND_RECV(&pmix_client_globals.myserver, msgout, NULL, NULL);
+     goto done;
 
+     unlock:
+     pthread_mutex_unlock(&pmix_client_globals.lock);
      done:
      cb->pstatus = rc;
-     cb->active = false;
+     PMIX_WAKEUP_THREAD(cb->active);
  }
 
  PMIX_EXPORT pmix_status_t PMIx_Commit(void)
@@ -805,22 +869,20 @@ static void _peersfn(int sd, short args, void *cbdata)
     pmix_nrec_t *nptr;
     size_t i;
 
-    /* cycle across our known nspaces */
+    /* find the nspace */
     tmp = NULL;
-    PMIX_LIST_FOREACH(nsptr, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strncmp(nsptr->nspace, cb->nspace, PMIX_MAX_NSLEN)) {
-            /* cycle across the nodes in this nspace */
-            PMIX_LIST_FOREACH(nptr, &nsptr->nodes, pmix_nrec_t) {
-                if (0 == strcmp(cb->key, nptr->name)) {
-                    /* add the contribution from this node */
-                    tmp = pmix_argv_split(nptr->procs, ',');
-                    for (i=0; NULL != tmp[i]; i++) {
-                        pmix_argv_append_nosize(&nsps, nsptr->nspace);
-                        pmix_argv_append_nosize(&nsprocs, tmp[i]);
-                    }
-                    pmix_argv_free(tmp);
-                    tmp = NULL;
+    if (NULL != (nsptr = pmix_nspace_lookup(cb->nspace))) {
+        /* cycle across the nodes in this nspace */
+        PMIX_LIST_FOREACH(nptr, &nsptr->nodes, pmix_nrec_t) {
+            if (0 == strcmp(cb->key, nptr->name)) {
+                /* add the contribution from this node */
+                tmp = pmix_argv_split(nptr->procs, ',');
+                for (i=0; NULL != tmp[i]; i++) {
+                    pmix_argv_append_nosize(&nsps, nsptr->nspace);
+                    pmix_argv_append_nosize(&nsprocs, tmp[i]);
                 }
+                pmix_argv_free(tmp);
+                tmp = NULL;
             }
         }
     }
@@ -845,7 +907,7 @@ static void _peersfn(int sd, short args, void *cbdata)
 
     done:
     cb->pstatus = rc;
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
 
 PMIX_EXPORT pmix_status_t PMIx_Resolve_peers(const char *nodename,
@@ -891,14 +953,12 @@ static void _nodesfn(int sd, short args, void *cbdata)
     pmix_nspace_t *nsptr;
     pmix_nrec_t *nptr;
 
-    /* cycle across our known nspaces */
+    /* find the nspace */
     tmp = NULL;
-    PMIX_LIST_FOREACH(nsptr, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strncmp(nsptr->nspace, cb->nspace, PMIX_MAX_NSLEN)) {
-            /* cycle across the nodes in this nspace */
-            PMIX_LIST_FOREACH(nptr, &nsptr->nodes, pmix_nrec_t) {
-                pmix_argv_append_unique_nosize(&tmp, nptr->name, false);
-            }
+    if (NULL != (nsptr = pmix_nspace_lookup(cb->nspace))) {
+        /* cycle across the nodes in this nspace */
+        PMIX_LIST_FOREACH(nptr, &nsptr->nodes, pmix_nrec_t) {
+            pmix_argv_append_unique_nosize(&tmp, nptr->name, false);
         }
     }
     if (NULL == tmp) {
@@ -910,7 +970,7 @@ static void _nodesfn(int sd, short args, void *cbdata)
     }
 
     cb->pstatus = rc;
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
 
 PMIX_EXPORT pmix_status_t PMIx_Resolve_nodes(const char *nspace, char **nodelist)
@@ -942,12 +1002,30 @@ PMIX_EXPORT pmix_status_t PMIx_Resolve_nodes(const char *nspace, char **nodelist
 }
 
 
+/* servers that can answer an offer of a buffer encoding tell us
+ * so when they fork us - an older one would take the offer for
+ * part of the credential. The variable names the uri of the server
+ * that set it, as we may have inherited it from an ancestor that
+ * was started by another server */
+static bool offer_bfrop_version(void)
+{
+    char *ver, *uri;
+
+    if (NULL == (ver = getenv("PMIX_BFROP_VERSION")) ||
+        NULL == (uri = getenv("PMIX_SERVER_URI")) ||
+        NULL == (ver = strchr(ver, ':'))) {
+        return false;
+    }
+    return (0 == strcmp(ver + 1, uri));
+}
+
 static pmix_status_t send_connect_ack(int sd)
 {
     char *msg;
     pmix_usock_hdr_t hdr;
     size_t sdsize=0, csize=0;
     char *cred = NULL;
+    bool offer = offer_bfrop_version();
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix: SEND CONNECT ACK");
@@ -969,8 +1047,13 @@ static pmix_status_t send_connect_ack(int sd)
         }
         csize = strlen(cred) + 1;  // must NULL terminate the string!
     }
+    /* the offer follows the credential, so it needs
+     * an empty one to hold the place if we have none */
+    if (offer && 0 == csize) {
+        csize = 1;
+    }
     /* set the number of bytes to be read beyond the header */
-    hdr.nbytes = sdsize + strlen(PMIX_VERSION) + 1 + csize;  // must NULL terminate the VERSION string!
+    hdr.nbytes = sdsize + strlen(PMIX_VERSION) + 1 + csize + (offer ? 1 : 0);  // must NULL terminate the VERSION string!
 
     /* create a space for our message */
     sdsize = (sizeof(hdr) + hdr.nbytes);
@@ -995,6 +1078,9 @@ static pmix_status_t send_connect_ack(int sd)
     if (NULL != cred) {
         memcpy(msg+csize, cred, strlen(cred));  // leaves last position in msg set to NULL
     }
+    if (offer) {
+        msg[sdsize-1] = PMIX_BFROP_BUFFER_NEWEST;
+    }
 
     if (PMIX_SUCCESS != pmix_usock_send_blocking(sd, msg, sdsize)) {
         free(msg);
@@ -1070,6 +1156,18 @@ static pmix_status_t send_connect_ack(int sd)
         PMIX_ERROR_LOG(rc);
         return rc;
     }
+
+    /* and the buffer encoding we will use, if we offered one */
+    if (offer_bfrop_version()) {
+        rc = pmix_usock_recv_blocking(sd, (char*)&pmix_client_globals.myserver.bfrop_version, 1);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        if (PMIX_BFROP_BUFFER_NEWEST < pmix_client_globals.myserver.bfrop_version) {
+            return PMIX_ERR_HANDSHAKE_FAILED;
+        }
+    }
         if (sockopt) {
             /* return the socket to normal */
         if (0 != setsockopt(sd, SOL_SOCKET, SO_RCVTIMEO, &save, sz)) {
@@ -1080,35 +1178,113 @@ static pmix_status_t send_connect_ack(int sd)
     return PMIX_SUCCESS;
 }
 
-void pmix_client_process_nspace_blob(const char *nspace, pmix_buffer_t *bptr)
+static pmix_status_t _process_map_blob(pmix_nspace_t *nsptr,
+                                       pmix_byte_object_t *bo,
+                                       bool store_hosts)
 {
     pmix_status_t rc;
     int32_t cnt;
     int rank;
-    pmix_kval_t *kptr, *kp2, kv;
+    pmix_kval_t *kp2, kv;
     pmix_buffer_t buf2;
-    pmix_byte_object_t *bo;
     size_t nnodes, i, j;
-    pmix_nspace_t *nsptr, *nsptr2;
     pmix_nrec_t *nrec, *nr2;
     char **procs;
 
+    /* transfer the byte object for unpacking */
+    PMIX_CONSTRUCT(&buf2, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(&buf2, bo->bytes, bo->size);
+    /* start by unpacking the number of nodes */
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf2, &nnodes, &cnt, PMIX_SIZE))) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&buf2);
+        return rc;
+    }
+    /* unpack the list of procs on each node */
+    for (i=0; i < nnodes; i++) {
+        cnt = 1;
+        PMIX_CONSTRUCT(&kv, pmix_kval_t);
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf2, &kv, &cnt, PMIX_KVAL))) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&buf2);
+            PMIX_DESTRUCT(&kv);
+            return rc;
+        }
+        /* the name of the node is in the key, and the value is
+         * a comma-delimited list of procs on that node. See if we already
+         * have this node */
+        nrec = NULL;
+        PMIX_LIST_FOREACH(nr2, &nsptr->nodes, pmix_nrec_t) {
+            if (0 == strcmp(nr2->name, kv.key)) {
+                nrec = nr2;
+                break;
+            }
+        }
+        if (NULL == nrec) {
+            /* Create a node record and store that list */
+            nrec = PMIX_NEW(pmix_nrec_t);
+            nrec->name = strdup(kv.key);
+            pmix_list_append(&nsptr->nodes, &nrec->super);
+        } else {
+            /* refresh the list */
+            if (NULL != nrec->procs) {
+                free(nrec->procs);
+            }
+        }
+        nrec->procs = strdup(kv.value->data.string);
+        /* the dstore already holds the hostname of each proc, so
+         * only the node list is needed in that case */
+        if (!store_hosts) {
+            PMIX_DESTRUCT(&kv);
+            continue;
+        }
+        /* split the list of procs so we can store their
+         * individual location data */
+        procs = pmix_argv_split(nrec->procs, ',');
+        for (j=0; NULL != procs[j]; j++) {
+            /* store the hostname for each proc - again, this is
+             * data obtained via a job-level exchange, so store it
+             * in the job-level data hash_table */
+            kp2 = PMIX_NEW(pmix_kval_t);
+            kp2->key = strdup(PMIX_HOSTNAME);
+            kp2->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+            kp2->value->type = PMIX_STRING;
+            kp2->value->data.string = strdup(nrec->name);
+            rank = strtol(procs[j], NULL, 10);
+            if (PMIX_SUCCESS != (rc = pmix_hash_store(&nsptr->internal, rank, kp2))) {
+                PMIX_ERROR_LOG(rc);
+            }
+            PMIX_RELEASE(kp2); // maintain accounting
+        }
+        pmix_argv_free(procs);
+        PMIX_DESTRUCT(&kv);
+    }
+    /* cleanup */
+    PMIX_DESTRUCT(&buf2);  // releases the original data
+    return PMIX_SUCCESS;
+}
+
+void pmix_client_process_nspace_blob(const char *nspace, pmix_buffer_t *bptr)
+{
+    pmix_status_t rc;
+    int32_t cnt;
+    int rank;
+    pmix_kval_t *kptr, *kp2;
+    pmix_buffer_t buf2;
+    pmix_byte_object_t *bo;
+    pmix_nspace_t *nsptr;
+
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix: PROCESSING BLOB FOR NSPACE %s", nspace);
 
-    /* cycle across our known nspaces */
-    nsptr = NULL;
-    PMIX_LIST_FOREACH(nsptr2, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(nsptr2->nspace, nspace)) {
-            nsptr = nsptr2;
-            break;
-        }
-    }
+    /* see if we know this nspace */
+    nsptr = pmix_nspace_lookup(nspace);
     if (NULL == nsptr) {
         /* we don't know this nspace - add it */
         nsptr = PMIX_NEW(pmix_nspace_t);
         (void)strncpy(nsptr->nspace, nspace, PMIX_MAX_NSLEN);
-        pmix_list_append(&pmix_globals.nspaces, &nsptr->super);
+        pmix_nspace_add(nsptr);
     }
 
     /* unpack any info structs provided */
@@ -1152,73 +1328,11 @@ void pmix_client_process_nspace_blob(const char *nspace, pmix_buffer_t *bptr)
             PMIX_DESTRUCT(&buf2);  // releases the original kptr data
             PMIX_RELEASE(kp2);
         } else if (0 == strcmp(kptr->key, PMIX_MAP_BLOB)) {
-            /* transfer the byte object for unpacking */
-            bo = &(kptr->value->data.bo);
-            PMIX_CONSTRUCT(&buf2, pmix_buffer_t);
-            PMIX_LOAD_BUFFER(&buf2, bo->bytes, bo->size);
+            rc = _process_map_blob(nsptr, &(kptr->value->data.bo), true);
             PMIX_RELEASE(kptr);
-            /* start by unpacking the number of nodes */
-            cnt = 1;
-            if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf2, &nnodes, &cnt, PMIX_SIZE))) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&buf2);
+            if (PMIX_SUCCESS != rc) {
                 return;
             }
-            /* unpack the list of procs on each node */
-            for (i=0; i < nnodes; i++) {
-                cnt = 1;
-                PMIX_CONSTRUCT(&kv, pmix_kval_t);
-                if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf2, &kv, &cnt, PMIX_KVAL))) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&buf2);
-                    PMIX_DESTRUCT(&kv);
-                    return;
-                }
-                /* the name of the node is in the key, and the value is
-                 * a comma-delimited list of procs on that node. See if we already
-                 * have this node */
-                 nrec = NULL;
-                 PMIX_LIST_FOREACH(nr2, &nsptr->nodes, pmix_nrec_t) {
-                    if (0 == strcmp(nr2->name, kv.key)) {
-                        nrec = nr2;
-                        break;
-                    }
-                }
-                if (NULL == nrec) {
-                    /* Create a node record and store that list */
-                    nrec = PMIX_NEW(pmix_nrec_t);
-                    nrec->name = strdup(kv.key);
-                    pmix_list_append(&nsptr->nodes, &nrec->super);
-                } else {
-                    /* refresh the list */
-                    if (NULL != nrec->procs) {
-                        free(nrec->procs);
-                    }
-                }
-                nrec->procs = strdup(kv.value->data.string);
-                /* split the list of procs so we can store their
-                 * individual location data */
-                procs = pmix_argv_split(nrec->procs, ',');
-                for (j=0; NULL != procs[j]; j++) {
-                    /* store the hostname for each proc - again, this is
-                     * data obtained via a job-level exchange, so store it
-                     * in the job-level data hash_table */
-                     kp2 = PMIX_NEW(pmix_kval_t);
-                     kp2->key = strdup(PMIX_HOSTNAME);
-                     kp2->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
-                     kp2->value->type = PMIX_STRING;
-                     kp2->value->data.string = strdup(nrec->name);
-                     rank = strtol(procs[j], NULL, 10);
-                     if (PMIX_SUCCESS != (rc = pmix_hash_store(&nsptr->internal, rank, kp2))) {
-                        PMIX_ERROR_LOG(rc);
-                    }
-                    PMIX_RELEASE(kp2); // maintain accounting
-                }
-                pmix_argv_free(procs);
-                PMIX_DESTRUCT(&kv);
-            }
-            /* cleanup */
-            PMIX_DESTRUCT(&buf2);  // releases the original kptr data
         } else {
             /* this is job-level data, so just add it to that hash_table
              * with the wildcard rank */
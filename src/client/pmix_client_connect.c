@@ -313,7 +313,9 @@ static void wait_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
             continue;
         }
         /* extract and process any proc-related info for this nspace */
+        pthread_mutex_lock(&pmix_client_globals.lock);
         pmix_client_process_nspace_blob(nspace, bptr);
+        pthread_mutex_unlock(&pmix_client_globals.lock);
         PMIX_RELEASE(bptr);
     }
     if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
@@ -331,5 +333,5 @@ static void op_cbfunc(pmix_status_t status, void *cbdata)
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
 
     cb->status = status;
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
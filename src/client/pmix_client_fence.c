@@ -147,6 +147,8 @@ PMIX_EXPORT pmix_status_t PMIx_Fence_nb(const pmix_proc_t procs[], size_t nprocs
     }
 
     msg = PMIX_NEW(pmix_buffer_t);
+    /* use the encoding we agreed on with the server */
+    msg->version = pmix_client_globals.myserver.bfrop_version;
     if (PMIX_SUCCESS != (rc = pack_fence(msg, cmd, rgs, nrg, info, ninfo))) {
         PMIX_RELEASE(msg);
         return rc;
@@ -250,6 +252,6 @@ static void op_cbfunc(pmix_status_t status, void *cbdata)
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
 
     cb->status = status;
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
 
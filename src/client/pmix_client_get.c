@@ -65,11 +65,77 @@ static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank,
 
 static void _getnbfn(int sd, short args, void *cbdata);
 
+static void _getnb_locked(pmix_cb_t *cb, pmix_list_t *ready);
+
+static void _getnb_ready(pmix_list_t *ready, pmix_cb_t *cb,
+                         pmix_status_t rc, pmix_value_t *val);
+
+static void _getnb_complete(pmix_list_t *ready);
+
+static pmix_status_t _get_local(const pmix_proc_t *proc, const char *key,
+                                const pmix_info_t info[], size_t ninfo,
+                                pmix_value_t **val);
+
 static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
                          pmix_buffer_t *buf, void *cbdata);
 
+static void _getnb_process(pmix_cb_t *cb, pmix_buffer_t *buf, pmix_list_t *ready);
+
 static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata);
 
+static void _value_ptr_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata);
+
+static bool _get_pointer(const pmix_info_t info[], size_t ninfo);
+
+/* caddy for PMIx_Get_multi requests */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    volatile bool active;
+    const pmix_proc_t *procs;
+    const char **keys;
+    size_t nkeys;
+    const pmix_info_t *info;
+    size_t ninfo;
+    bool pointer;
+    pmix_cb_t **results;    // pmix_cb_t collecting the result of each key that
+                            // could not be resolved locally, NULL for the others
+    size_t nmiss;           // number of such keys
+    size_t nleft;           // number of results not yet returned
+} pmix_get_multi_caddy_t;
+
+static void gmcon(pmix_get_multi_caddy_t *p)
+{
+    p->active = false;
+    p->procs = NULL;
+    p->keys = NULL;
+    p->nkeys = 0;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->pointer = false;
+    p->results = NULL;
+    p->nmiss = 0;
+    p->nleft = 0;
+}
+static void gmdes(pmix_get_multi_caddy_t *p)
+{
+    size_t n;
+
+    if (NULL != p->results) {
+        for (n=0; n < p->nkeys; n++) {
+            if (NULL != p->results[n]) {
+                PMIX_RELEASE(p->results[n]);
+            }
+        }
+        free(p->results);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_multi_caddy_t,
+                           pmix_object_t,
+                           gmcon, gmdes);
+
+static void _getmultifn(int fd, short flags, void *cbdata);
+
 PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc, const char key[],
                                    const pmix_info_t info[], size_t ninfo,
                                    pmix_value_t **val)
@@ -81,12 +147,22 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc, const char key[],
         return PMIX_ERR_INIT;
     }
 
+    /* if we already have the data, there is no need to
+     * go thru the event library */
+    if (PMIX_SUCCESS == _get_local(proc, key, info, ninfo, val)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "pmix:client get completed locally");
+        return PMIX_SUCCESS;
+    }
+
     /* create a callback object as we need to pass it to the
      * recv routine so we know which callback to use when
      * the return message is recvd */
     cb = PMIX_NEW(pmix_cb_t);
     cb->active = true;
-    if (PMIX_SUCCESS != (rc = PMIx_Get_nb(proc, key, info, ninfo, _value_cbfunc, cb))) {
+    if (PMIX_SUCCESS != (rc = PMIx_Get_nb(proc, key, info, ninfo,
+                                          _get_pointer(info, ninfo) ? _value_ptr_cbfunc : _value_cbfunc,
+                                          cb))) {
         PMIX_RELEASE(cb);
         return rc;
     }
@@ -172,18 +248,219 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const char *key,
     return PMIX_SUCCESS;
 }
 
-static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(const pmix_proc_t procs[], const char *keys[], size_t n,
+                                         const pmix_info_t info[], size_t ninfo,
+                                         pmix_value_t *vals[], pmix_status_t status[])
+{
+    pmix_get_multi_caddy_t *cd;
+    pmix_status_t rc;
+    size_t i;
+    pmix_value_t *val;
+
+    if (pmix_globals.init_cntr <= 0) {
+        return PMIX_ERR_INIT;
+    }
+
+    if (NULL == procs || NULL == keys || NULL == vals || NULL == status) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* unlike PMIx_Get, we do not support the legacy requests
+     * for all the data of a proc */
+    for (i=0; i < n; i++) {
+        if (NULL == keys[i]) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+    if (0 == n) {
+        return PMIX_SUCCESS;
+    }
+
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix: get_multi %lu values", (unsigned long)n);
+
+    cd = PMIX_NEW(pmix_get_multi_caddy_t);
+    cd->results = (pmix_cb_t**)calloc(n, sizeof(pmix_cb_t*));
+    if (NULL == cd->results) {
+        PMIX_RELEASE(cd);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    cd->procs = procs;
+    cd->keys = keys;
+    cd->nkeys = n;
+    cd->info = info;
+    cd->ninfo = ninfo;
+    cd->pointer = _get_pointer(info, ninfo);
+
+    /* resolve whatever we can right here */
+    for (i=0; i < n; i++) {
+        if (PMIX_SUCCESS == _get_local(&procs[i], keys[i], info, ninfo, &val)) {
+            status[i] = PMIX_SUCCESS;
+            vals[i] = val;
+        } else {
+            cd->results[i] = PMIX_NEW(pmix_cb_t);
+            cd->results[i]->cbdata = cd;
+            cd->nmiss++;
+        }
+    }
+
+    if (0 < cd->nmiss) {
+        /* thread-shift once for all the remaining keys */
+        PMIX_THREADSHIFT(cd, _getmultifn);
+
+        /* wait for all the data to return */
+        PMIX_WAIT_FOR_COMPLETION(cd->active);
+    }
+    rc = PMIX_SUCCESS;
+    for (i=0; i < n; i++) {
+        if (NULL != cd->results[i]) {
+            status[i] = cd->results[i]->status;
+            vals[i] = cd->results[i]->value;
+        }
+        if (PMIX_SUCCESS != status[i] && PMIX_SUCCESS == rc) {
+            rc = status[i];
+        }
+    }
+    PMIX_RELEASE(cd);
+
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix:client get_multi completed");
+
+    return rc;
+}
+
+/* hand the value over to the cb, without copying the bytes of a
+ * byte object that point into the dstore if pointer is set */
+static void _xfer_value(pmix_cb_t *cb, pmix_status_t status, pmix_value_t *kv, bool pointer)
 {
-    pmix_cb_t *cb = (pmix_cb_t*)cbdata;
     pmix_status_t rc;
 
     cb->status = status;
-    if (PMIX_SUCCESS == status) {
-        if (PMIX_SUCCESS != (rc = pmix_bfrop.copy((void**)&cb->value, kv, PMIX_VALUE))) {
-            PMIX_ERROR_LOG(rc);
+    if (PMIX_SUCCESS != status) {
+        return;
+    }
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    if (pointer && PMIX_BYTE_OBJECT == kv->type &&
+        pmix_dstore_is_mapped(kv->data.bo.bytes)) {
+        PMIX_VALUE_CREATE(cb->value, 1);
+        if (NULL == cb->value) {
+            cb->status = PMIX_ERR_OUT_OF_RESOURCE;
+        } else {
+            cb->value->type = PMIX_BYTE_OBJECT;
+            cb->value->data.bo = kv->data.bo;
+        }
+        return;
+    }
+#endif /* PMIX_ENABLE_DSTORE */
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.copy((void**)&cb->value, kv, PMIX_VALUE))) {
+        PMIX_ERROR_LOG(rc);
+    }
+}
+
+static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t*)cbdata;
+
+    _xfer_value(cb, status, kv, false);
+    PMIX_WAKEUP_THREAD(cb->active);
+}
+
+static void _value_ptr_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t*)cbdata;
+
+    _xfer_value(cb, status, kv, true);
+    PMIX_WAKEUP_THREAD(cb->active);
+}
+
+PMIX_EXPORT void PMIx_Get_release(pmix_value_t *val)
+{
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    int mapped;
+#endif /* PMIX_ENABLE_DSTORE */
+
+    if (NULL == val) {
+        return;
+    }
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    if (PMIX_BYTE_OBJECT == val->type) {
+        /* the fetches attach new segments under the lock */
+        pthread_mutex_lock(&pmix_client_globals.lock);
+        mapped = pmix_dstore_is_mapped(val->data.bo.bytes);
+        pthread_mutex_unlock(&pmix_client_globals.lock);
+        if (mapped) {
+            /* the bytes belong to the dstore */
+            val->data.bo.bytes = NULL;
+            val->data.bo.size = 0;
         }
     }
-    cb->active = false;
+#endif /* PMIX_ENABLE_DSTORE */
+    PMIX_VALUE_RELEASE(val);
+}
+
+/* collect the value of one of the keys of a PMIx_Get_multi request */
+static void _multi_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
+{
+    pmix_cb_t *res = (pmix_cb_t*)cbdata;
+    pmix_get_multi_caddy_t *cd = (pmix_get_multi_caddy_t*)res->cbdata;
+
+    _xfer_value(res, status, kv, cd->pointer);
+    cd->nleft--;
+    if (0 == cd->nleft) {
+        PMIX_WAKEUP_THREAD(cd->active);
+    }
+}
+
+static void _getmultifn(int fd, short flags, void *cbdata)
+{
+    pmix_get_multi_caddy_t *cd = (pmix_get_multi_caddy_t*)cbdata;
+    pmix_cb_t *cb;
+    const pmix_proc_t *proc;
+    size_t n;
+
+    /* hold a reference on the results so they cannot complete
+     * before we have gone thru all the keys */
+    cd->nleft = cd->nmiss + 1;
+    for (n=0; n < cd->nkeys; n++) {
+        if (NULL == cd->results[n]) {
+            /* already resolved */
+            continue;
+        }
+        /* each key is looked up just like in PMIx_Get_nb, but as
+         * we already are in the event thread, there is no need to
+         * shift into it again. Keys of the procs whose data has to be
+         * requested from the server will wait for the same request */
+        proc = &cd->procs[n];
+        cb = PMIX_NEW(pmix_cb_t);
+        cb->active = true;
+        if (0 == strlen(proc->nspace)) {
+            (void)strncpy(cb->nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN);
+        } else {
+            (void)strncpy(cb->nspace, proc->nspace, PMIX_MAX_NSLEN);
+        }
+        cb->rank = proc->rank;
+        cb->key = (char*)cd->keys[n];
+        cb->info = (pmix_info_t*)cd->info;
+        cb->ninfo = cd->ninfo;
+        cb->value_cbfunc = _multi_cbfunc;
+        cb->cbdata = cd->results[n];
+        _getnbfn(fd, flags, cb);
+    }
+    cd->nleft--;
+    if (0 == cd->nleft) {
+        PMIX_WAKEUP_THREAD(cd->active);
+    }
+}
+
+static bool _get_pointer(const pmix_info_t info[], size_t ninfo)
+{
+    size_t n;
+
+    for (n=0; n < ninfo; n++) {
+        if (0 == strcmp(info[n].key, PMIX_GET_POINTER)) {
+            return info[n].value.data.flag;
+        }
+    }
+    return false;
 }
 
 static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank,
@@ -195,6 +472,8 @@ static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank,
 
     /* nope - see if we can get it */
     msg = PMIX_NEW(pmix_buffer_t);
+    /* use the encoding we agreed on with the server */
+    msg->version = pmix_client_globals.myserver.bfrop_version;
     /* pack the get cmd */
     if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(msg, &cmd, 1, PMIX_CMD))) {
         PMIX_ERROR_LOG(rc);
@@ -235,12 +514,49 @@ static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank,
 static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
                          pmix_buffer_t *buf, void *cbdata)
 {
-    pmix_cb_t *cb = (pmix_cb_t*)cbdata;
+    pmix_list_t ready;
+
+    /* the data is shared with PMIx_Get on the caller's thread */
+    PMIX_CONSTRUCT(&ready, pmix_list_t);
+    pthread_mutex_lock(&pmix_client_globals.lock);
+    _getnb_process((pmix_cb_t*)cbdata, buf, &ready);
+    pthread_mutex_unlock(&pmix_client_globals.lock);
+    _getnb_complete(&ready);
+    PMIX_DESTRUCT(&ready);
+}
+
+/* queue a request that is done - the callbacks are executed once
+ * the lock is released, as they may call into PMIx themselves. The
+ * value is handed to the callback and released after it returns */
+static void _getnb_ready(pmix_list_t *ready, pmix_cb_t *cb,
+                         pmix_status_t rc, pmix_value_t *val)
+{
+    cb->pstatus = rc;
+    cb->value = val;
+    pmix_list_append(ready, &cb->super);
+}
+
+static void _getnb_complete(pmix_list_t *ready)
+{
+    pmix_cb_t *cb;
+
+    while (NULL != (cb = (pmix_cb_t*)pmix_list_remove_first(ready))) {
+        if (NULL != cb->value_cbfunc) {
+            cb->value_cbfunc(cb->pstatus, cb->value, cb->cbdata);
+        }
+        PMIx_Get_release(cb->value);
+        cb->value = NULL;
+        PMIX_RELEASE(cb);
+    }
+}
+
+static void _getnb_process(pmix_cb_t *cb, pmix_buffer_t *buf, pmix_list_t *ready)
+{
     pmix_cb_t *cb2;
     pmix_status_t rc, ret;
     pmix_value_t *val = NULL;
     int32_t cnt;
-    pmix_nspace_t *ns, *nptr;
+    pmix_nspace_t *nptr;
     pmix_rank_t rank;
 #if (PMIX_ENABLE_DSTORE != 1)
     pmix_rank_t cur_rank;
@@ -265,18 +581,12 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
     }
 
     /* look up the nspace object for this proc */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strncmp(cb->nspace, ns->nspace, PMIX_MAX_NSLEN)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cb->nspace);
     if (NULL == nptr) {
         /* new nspace - setup a record for it */
         nptr = PMIX_NEW(pmix_nspace_t);
         (void)strncpy(nptr->nspace, cb->nspace, PMIX_MAX_NSLEN);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_add(nptr);
     }
 
     if (PMIX_SUCCESS != ret) {
@@ -303,11 +613,10 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
                 /* unpack the nspace - we don't really need it, but have to
                  * unpack it to maintain sequence */
                 cnt = 1;
-                if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(bptr, &nspace, &cnt, PMIX_STRING))) {
+                if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack_view(bptr, &nspace, &cnt, PMIX_STRING))) {
                     PMIX_ERROR_LOG(rc);
                     return;
                 }
-                free(nspace);
                 pmix_client_process_nspace_blob(cb->nspace, bptr);
             } else {
                 cnt = 1;
@@ -353,20 +662,13 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
 #endif /* PMIX_ENABLE_DSTORE */
 
 done:
-    /* if a callback was provided, execute it */
-    if (NULL != cb && NULL != cb->value_cbfunc) {
-        if (NULL == val) {
-            rc = PMIX_ERR_NOT_FOUND;
-        }
-        cb->value_cbfunc(rc, val, cb->cbdata);
-    }
-    if (NULL != val) {
-        PMIX_VALUE_RELEASE(val);
+    if (NULL == val) {
+        rc = PMIX_ERR_NOT_FOUND;
     }
     /* we obviously processed this one, so remove it from the
      * list of pending requests */
     pmix_list_remove_item(&pmix_client_globals.pending_requests, &cb->super);
-    PMIX_RELEASE(cb);
+    _getnb_ready(ready, cb, rc, val);
 
     /* now search any pending requests to see if they can be met */
     PMIX_LIST_FOREACH_SAFE(cb, cb2, &pmix_client_globals.pending_requests, pmix_cb_t) {
@@ -378,12 +680,8 @@ done:
 #else
             rc = pmix_hash_fetch(&nptr->modex, rank, cb->key, &val);
 #endif /* PMIX_ENABLE_DSTORE */
-            cb->value_cbfunc(rc, val, cb->cbdata);
-            if (NULL != val) {
-                PMIX_VALUE_RELEASE(val);
-            }
             pmix_list_remove_item(&pmix_client_globals.pending_requests, &cb->super);
-            PMIX_RELEASE(cb);
+            _getnb_ready(ready, cb, rc, val);
         }
     }
 }
@@ -440,14 +738,76 @@ static pmix_status_t process_val(pmix_value_t *val,
 
 static void _getnbfn(int fd, short flags, void *cbdata)
 {
-    pmix_cb_t *cb = (pmix_cb_t*)cbdata;
+    pmix_list_t ready;
+
+    /* the data is shared with PMIx_Get on the caller's thread */
+    PMIX_CONSTRUCT(&ready, pmix_list_t);
+    pthread_mutex_lock(&pmix_client_globals.lock);
+    _getnb_locked((pmix_cb_t*)cbdata, &ready);
+    pthread_mutex_unlock(&pmix_client_globals.lock);
+    _getnb_complete(&ready);
+    PMIX_DESTRUCT(&ready);
+}
+
+/* Look the key up in the data we already have, right on the caller's
+ * thread. This mirrors the local part of _getnb_locked - anything else,
+ * including a key that is not found, is left to the full path */
+static pmix_status_t _get_local(const pmix_proc_t *proc, const char *key,
+                                const pmix_info_t info[], size_t ninfo,
+                                pmix_value_t **val)
+{
+    pmix_nspace_t *nptr;
+    const char *nm;
+    pmix_status_t rc = PMIX_ERR_NOT_FOUND;
+
+    /* the server's data is not protected by our lock, and the
+     * legacy requests need the full logic */
+    if (pmix_globals.server || NULL == proc || NULL == key) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (0 == strlen(proc->nspace)) {
+        nm = pmix_globals.myid.nspace;
+    } else {
+        nm = proc->nspace;
+    }
+
+    pthread_mutex_lock(&pmix_client_globals.lock);
+    nptr = pmix_nspace_lookup(nm);
+    if (NULL == nptr) {
+        /* let the full path learn about the nspace */
+    } else if (0 == strncmp(key, "pmix", 4)) {
+        rc = pmix_hash_fetch(&nptr->internal, proc->rank, key, val);
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+        if (PMIX_SUCCESS != rc) {
+            rc = pmix_dstore_fetch(nptr->nspace, proc->rank, key, val);
+        }
+#endif /* PMIX_ENABLE_DSTORE */
+    } else {
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+        if (_get_pointer(info, ninfo)) {
+            rc = pmix_dstore_fetch_ptr(nptr->nspace, proc->rank, key, val);
+        } else {
+            rc = pmix_dstore_fetch(nptr->nspace, proc->rank, key, val);
+        }
+#else
+        rc = pmix_hash_fetch(&nptr->modex, proc->rank, key, val);
+#endif /* PMIX_ENABLE_DSTORE */
+    }
+    pthread_mutex_unlock(&pmix_client_globals.lock);
+    /* the fetched value is a copy that can be handed to the caller,
+     * except for the bytes borrowed from the dstore */
+    return rc;
+}
+
+static void _getnb_locked(pmix_cb_t *cb, pmix_list_t *ready)
+{
     pmix_cb_t *cbret;
     pmix_buffer_t *msg;
     pmix_value_t *val;
     pmix_info_t *info, *iptr;
     pmix_pointer_array_t results;
     pmix_status_t rc;
-    pmix_nspace_t *ns, *nptr;
+    pmix_nspace_t *nptr;
     size_t n, nvals;
 
     pmix_output_verbose(2, pmix_globals.debug_output,
@@ -456,13 +816,7 @@ static void _getnbfn(int fd, short flags, void *cbdata)
                         (NULL == cb->key) ? "NULL" : cb->key);
 
     /* find the nspace object */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(cb->nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cb->nspace);
     if (NULL == nptr) {
         /* we are asking for info about a new nspace - give us
          * a chance to learn about it from the server. If the
@@ -470,7 +824,7 @@ static void _getnbfn(int fd, short flags, void *cbdata)
          * an error */
          nptr = PMIX_NEW(pmix_nspace_t);
          (void)strncpy(nptr->nspace, cb->nspace, PMIX_MAX_NSLEN);
-         pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+         pmix_nspace_add(nptr);
          /* there is no point in looking for data in this nspace
           * object, so let's just go generate the request */
          goto request;
@@ -496,12 +850,12 @@ static void _getnbfn(int fd, short flags, void *cbdata)
                 pmix_output_verbose(2, pmix_globals.debug_output,
                                     "pmix_get[%d]: value retrieved from dstore", __LINE__);
                 if (PMIX_SUCCESS != (rc = process_val(val, &nvals, &results))) {
-                    cb->value_cbfunc(rc, NULL, cb->cbdata);
                     /* cleanup */
                     if (NULL != val) {
                         PMIX_VALUE_RELEASE(val);
                     }
-                    PMIX_RELEASE(cb);
+                    PMIX_DESTRUCT(&results);
+                    _getnb_ready(ready, cb, rc, NULL);
                     return;
                 }
                 /* cleanup */
@@ -516,12 +870,12 @@ static void _getnbfn(int fd, short flags, void *cbdata)
         /* now get any data from the job-level info */
         if (PMIX_SUCCESS == (rc = pmix_hash_fetch(&nptr->internal, PMIX_RANK_WILDCARD, NULL, &val))) {
             if (PMIX_SUCCESS != (rc = process_val(val, &nvals, &results))) {
-                cb->value_cbfunc(rc, NULL, cb->cbdata);
                 /* cleanup */
                 if (NULL != val) {
                     PMIX_VALUE_RELEASE(val);
                 }
-                PMIX_RELEASE(cb);
+                PMIX_DESTRUCT(&results);
+                _getnb_ready(ready, cb, rc, NULL);
                 return;
             }
             /* cleanup */
@@ -544,25 +898,24 @@ static void _getnbfn(int fd, short flags, void *cbdata)
         /* done with results array */
         PMIX_DESTRUCT(&results);
         /* return the result to the caller */
-        cb->value_cbfunc(PMIX_SUCCESS, val, cb->cbdata);
-        PMIX_VALUE_FREE(val, 1);
-        PMIX_RELEASE(cb);
+        _getnb_ready(ready, cb, PMIX_SUCCESS, val);
         return;
     }
 
     /* if the key is in the PMIx namespace, then they are looking for data
      * that was provided at startup */
     if (0 == strncmp(cb->key, "pmix", 4)) {
-        /* should be in the internal hash table. */
-        if (PMIX_SUCCESS == (rc = pmix_hash_fetch(&nptr->internal, cb->rank, cb->key, &val))) {
-            /* found it - we are in an event, so we can
-             * just execute the callback */
-            cb->value_cbfunc(rc, val, cb->cbdata);
-            /* cleanup */
-            if (NULL != val) {
-                PMIX_VALUE_RELEASE(val);
-            }
-            PMIX_RELEASE(cb);
+        /* should be in the internal hash table - or, for the job-level
+         * data our server published, in the dstore */
+        rc = pmix_hash_fetch(&nptr->internal, cb->rank, cb->key, &val);
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+        if (PMIX_SUCCESS != rc) {
+            rc = pmix_dstore_fetch(nptr->nspace, cb->rank, cb->key, &val);
+        }
+#endif /* PMIX_ENABLE_DSTORE */
+        if (PMIX_SUCCESS == rc) {
+            /* found it - it is returned once we release the lock */
+            _getnb_ready(ready, cb, rc, val);
             return;
         }
         /* if we don't have it, go request it */
@@ -571,20 +924,19 @@ static void _getnbfn(int fd, short flags, void *cbdata)
 
     /* otherwise, the data must be something they "put" */
 #if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
-    if (PMIX_SUCCESS == (rc = pmix_dstore_fetch(nptr->nspace, cb->rank, cb->key, &val))) {
+    if (_get_pointer(cb->info, cb->ninfo)) {
+        rc = pmix_dstore_fetch_ptr(nptr->nspace, cb->rank, cb->key, &val);
+    } else {
+        rc = pmix_dstore_fetch(nptr->nspace, cb->rank, cb->key, &val);
+    }
+    if (PMIX_SUCCESS == rc) {
 #else
     if (PMIX_SUCCESS == (rc = pmix_hash_fetch(&nptr->modex, cb->rank, cb->key, &val))) {
 #endif /* PMIX_ENABLE_DSTORE */
         pmix_output_verbose(2, pmix_globals.debug_output,
                             "pmix_get[%d]: value retrieved from dstore", __LINE__);
-        /* found it - we are in an event, so we can
-         * just execute the callback */
-        cb->value_cbfunc(rc, val, cb->cbdata);
-        /* cleanup */
-        if (NULL != val) {
-            PMIX_VALUE_RELEASE(val);
-        }
-        PMIX_RELEASE(cb);
+        /* found it - it is returned once we release the lock */
+        _getnb_ready(ready, cb, rc, val);
         return;
     } else if (PMIX_ERR_NOT_FOUND == rc) {
         /* we have the modex data from this proc, but didn't find the key
@@ -595,12 +947,11 @@ static void _getnbfn(int fd, short flags, void *cbdata)
             pmix_output_verbose(2, pmix_globals.debug_output,
                                 "Error requesting key=%s for rank = %d, namespace = %s",
                                 cb->key, cb->rank, cb->nspace);
-            cb->value_cbfunc(rc, NULL, cb->cbdata);
             /* protect the data */
             cb->procs = NULL;
             cb->key = NULL;
             cb->info = NULL;
-            PMIX_RELEASE(cb);
+            _getnb_ready(ready, cb, rc, NULL);
             return;
         }
         pmix_output_verbose(2, pmix_globals.debug_output,
@@ -614,8 +965,7 @@ static void _getnbfn(int fd, short flags, void *cbdata)
      * are a server, or we are a client and not connected, then there is
      * nothing more we can do */
     if (pmix_globals.server || (!pmix_globals.server && !pmix_globals.connected)) {
-        cb->value_cbfunc(PMIX_ERR_NOT_FOUND, NULL, cb->cbdata);
-        PMIX_RELEASE(cb);
+        _getnb_ready(ready, cb, PMIX_ERR_NOT_FOUND, NULL);
         return;
     }
 
@@ -628,8 +978,7 @@ static void _getnbfn(int fd, short flags, void *cbdata)
             pmix_output_verbose(2, pmix_globals.debug_output,
                                 "PMIx_Get key=%s for rank = %d, namespace = %s was not found - request was optional",
                                 cb->key, cb->rank, cb->nspace);
-            cb->value_cbfunc(PMIX_ERR_NOT_FOUND, NULL, cb->cbdata);
-            PMIX_RELEASE(cb);
+            _getnb_ready(ready, cb, PMIX_ERR_NOT_FOUND, NULL);
             return;
         }
     }
@@ -639,8 +988,7 @@ static void _getnbfn(int fd, short flags, void *cbdata)
      * event notifications */
     if (NULL != cb->key && 0 == strncmp(cb->key, "pmix", 4) &&
         0 == strncmp(cb->nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN)) {
-        cb->value_cbfunc(PMIX_ERR_NOT_FOUND, NULL, cb->cbdata);
-        PMIX_RELEASE(cb);
+        _getnb_ready(ready, cb, PMIX_ERR_NOT_FOUND, NULL);
         return;
     }
 
@@ -661,8 +1009,7 @@ static void _getnbfn(int fd, short flags, void *cbdata)
      * about packing the key as we return everything from that proc */
     msg = _pack_get(cb->nspace, cb->rank, cb->info, cb->ninfo, PMIX_GETNB_CMD);
     if (NULL == msg) {
-        cb->value_cbfunc(PMIX_ERROR, NULL, cb->cbdata);
-        PMIX_RELEASE(cb);
+        _getnb_ready(ready, cb, PMIX_ERROR, NULL);
         return;
     }
 
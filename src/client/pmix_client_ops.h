@@ -13,6 +13,8 @@
 #include <src/include/pmix_config.h>
 
 
+#include <pthread.h>
+
 #include "src/buffer_ops/buffer_ops.h"
 #include "src/class/pmix_hash_table.h"
 #include "src/usock/usock.h"
@@ -22,6 +24,8 @@ BEGIN_C_DECLS
 typedef struct {
     pmix_peer_t myserver;           // messaging support to/from my server
     pmix_list_t pending_requests;   // list of pmix_cb_t pending data requests
+    pthread_mutex_t lock;           // protects the data read and written directly from the caller's
+                                    // thread by PMIx_Put and PMIx_Get, see _putfn and _get_local
 } pmix_client_globals_t;
 
 extern pmix_client_globals_t pmix_client_globals;
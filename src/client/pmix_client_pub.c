@@ -425,7 +425,7 @@ static void op_cbfunc(pmix_status_t status, void *cbdata)
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
 
     cb->status = status;
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
 
 static void wait_lookup_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
@@ -518,5 +518,5 @@ static void lookup_cbfunc(pmix_status_t status, pmix_pdata_t pdata[], size_t nda
         }
     }
 
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
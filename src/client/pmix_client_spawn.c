@@ -206,7 +206,9 @@ static void wait_cbfunc(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
         if (NULL != n2) {
             (void)strncpy(nspace, n2, PMIX_MAX_NSLEN);
             /* extract and process any proc-related info for this nspace */
+            pthread_mutex_lock(&pmix_client_globals.lock);
             pmix_client_process_nspace_blob(nspace, buf);
+            pthread_mutex_unlock(&pmix_client_globals.lock);
             free(n2);
         }
     }
@@ -224,6 +226,6 @@ static void spawn_cbfunc(pmix_status_t status, char nspace[], void *cbdata)
     if (NULL != nspace) {
         (void)strncpy(cb->nspace, nspace, PMIX_MAX_NSLEN);
     }
-    cb->active = false;
+    PMIX_WAKEUP_THREAD(cb->active);
 }
 
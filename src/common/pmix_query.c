@@ -91,6 +91,42 @@ static void query_cbfunc(struct pmix_peer_t *peer,
     PMIX_RELEASE(cd);
 }
 
+static void _local_query(int sd, short args, void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t*)cbdata;
+    pmix_shift_caddy_t *results;
+    pmix_status_t rc;
+
+    /* we may know the answers ourselves */
+    results = PMIX_NEW(pmix_shift_caddy_t);
+    if (PMIX_SUCCESS == pmix_server_query_local(cd->queries, cd->nqueries,
+                                                &results->info, &results->ninfo)) {
+        if (NULL != cd->cbfunc) {
+            cd->cbfunc(PMIX_SUCCESS, results->info, results->ninfo, cd->cbdata, relcbfunc, results);
+        } else {
+            relcbfunc(results);
+        }
+        PMIX_RELEASE(cd);
+        return;
+    }
+    PMIX_RELEASE(results);
+
+    if (NULL == pmix_host_server.query) {
+        /* nothing we can do */
+        rc = PMIX_ERR_NOT_SUPPORTED;
+    } else {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "pmix:query handed to RM");
+        rc = pmix_host_server.query(&pmix_globals.myid,
+                                    cd->queries, cd->nqueries,
+                                    cd->cbfunc, cd->cbdata);
+    }
+    if (PMIX_SUCCESS != rc && NULL != cd->cbfunc) {
+        cd->cbfunc(rc, NULL, 0, cd->cbdata, NULL, NULL);
+    }
+    PMIX_RELEASE(cd);
+}
+
 PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nqueries,
                                              pmix_info_cbfunc_t cbfunc, void *cbdata)
 
@@ -112,17 +148,15 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
     }
 
     /* if we are the server, then we just issue the query and
-     * return the response */
+     * return the response - the local answers come from state
+     * owned by the progress thread, so look them up there */
     if (pmix_globals.server) {
-            if (NULL == pmix_host_server.query) {
-                /* nothing we can do */
-                return PMIX_ERR_NOT_SUPPORTED;
-            }
-            pmix_output_verbose(2, pmix_globals.debug_output,
-                                "pmix:query handed to RM");
-            pmix_host_server.query(&pmix_globals.myid,
-                                   queries, nqueries,
-                                   cbfunc, cbdata);
+        cd = PMIX_NEW(pmix_query_caddy_t);
+        cd->queries = queries;
+        cd->nqueries = nqueries;
+        cd->cbfunc = cbfunc;
+        cd->cbdata = cbdata;
+        PMIX_THREADSHIFT(cd, _local_query);
     } else {
         /* if we are a client, then relay this request to the server */
         cd = PMIX_NEW(pmix_query_caddy_t);
@@ -90,3 +90,56 @@ int pmix_dstore_nspace_add(const char *nspace)
     }
     return pmix_dstore.nspace(nspace);
 }
+
+int pmix_dstore_nspace_del(const char *nspace)
+{
+    if (!pmix_dstore.nspace_del) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    return pmix_dstore.nspace_del(nspace);
+}
+
+int pmix_dstore_fetch_ptr(const char *nspace, pmix_rank_t rank,
+                          const char *key, pmix_value_t **kvs)
+{
+    if (!pmix_dstore.fetch_ptr) {
+        return pmix_dstore_fetch(nspace, rank, key, kvs);
+    }
+    return pmix_dstore.fetch_ptr(nspace, rank, key, kvs);
+}
+
+int pmix_dstore_is_mapped(const void *addr)
+{
+    if (!pmix_dstore.is_mapped || NULL == addr) {
+        return 0;
+    }
+    return pmix_dstore.is_mapped(addr);
+}
+
+int pmix_dstore_store_many(const char *nspace, pmix_rank_t ranks[],
+                           pmix_kval_t *kvs[], size_t n)
+{
+    size_t i;
+    int rc, ret = PMIX_SUCCESS;
+
+    if (!pmix_dstore.store_many) {
+        if (!pmix_dstore.store) {
+            return PMIX_ERR_NOT_SUPPORTED;
+        }
+        for (i = 0; i < n; i++) {
+            if (PMIX_SUCCESS != (rc = pmix_dstore.store(nspace, ranks[i], kvs[i]))) {
+                ret = rc;
+            }
+        }
+        return ret;
+    }
+    return pmix_dstore.store_many(nspace, ranks, kvs, n);
+}
+
+int pmix_dstore_rank_stored(const char *nspace, pmix_rank_t rank)
+{
+    if (!pmix_dstore.rank_stored) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    return pmix_dstore.rank_stored(nspace, rank);
+}
@@ -29,6 +29,13 @@ int pmix_dstore_fetch(const char *nspace, pmix_rank_t rank,
                       const char *key, pmix_value_t **kvs);
 int pmix_dstore_patch_env(char ***env);
 int pmix_dstore_nspace_add(const char *nspace);
+int pmix_dstore_nspace_del(const char *nspace);
+int pmix_dstore_fetch_ptr(const char *nspace, pmix_rank_t rank,
+                          const char *key, pmix_value_t **kvs);
+int pmix_dstore_is_mapped(const void *addr);
+int pmix_dstore_store_many(const char *nspace, pmix_rank_t ranks[],
+                           pmix_kval_t *kvs[], size_t n);
+int pmix_dstore_rank_stored(const char *nspace, pmix_rank_t rank);
 
 /**
  * Initialize the module. Returns an error if the module cannot
@@ -95,6 +102,75 @@ typedef int (*pmix_dstore_base_module_proc_patch_env_fn_t)(char ***env);
 */
 typedef int (*pmix_dstore_base_module_add_nspace_fn_t)(const char *nspace);
 
+/**
+* delete all the data of the namespace and release the
+* resources allocated for it.
+*
+* @param nspace   namespace string
+*
+* @return PMIX_SUCCESS on success.
+*/
+typedef int (*pmix_dstore_base_module_del_nspace_fn_t)(const char *nspace);
+
+/**
+* fetch value in datastore without copying the bytes of a byte
+* object. The module may still return a copy if it cannot point
+* to the stored bytes.
+*
+* @param nspace   namespace string
+*
+* @param rank     rank.
+*
+* @param key      key.
+*
+* @return kvs(key/value pair) and PMIX_SUCCESS on success.
+*/
+typedef int (*pmix_dstore_base_module_fetch_ptr_fn_t)(const char *nspace,
+                                                       pmix_rank_t rank,
+                                                       const char *key,
+                                                       pmix_value_t **kvs);
+
+/**
+* check whether the address points into the memory of the datastore.
+*
+* @param addr     address.
+*
+* @return 1 if it does, 0 otherwise.
+*/
+typedef int (*pmix_dstore_base_module_is_mapped_fn_t)(const void *addr);
+
+/**
+* store a batch of key/value pairs of one namespace in datastore.
+* Same as calling store for every pair, but the module can take
+* its locks and look up the namespace once for the whole batch.
+*
+* @param nspace   namespace string
+*
+* @param ranks    array of ranks.
+*
+* @param kvs      array of key/value pairs, kvs[i] belongs to ranks[i].
+*
+* @param n        number of elements in the arrays.
+*
+* @return PMIX_SUCCESS on success.
+*/
+typedef int (*pmix_dstore_base_module_store_many_fn_t)(const char *nspace,
+                                                       pmix_rank_t ranks[],
+                                                       pmix_kval_t *kvs[],
+                                                       size_t n);
+
+/**
+* check whether the datastore holds any data for a rank.
+*
+* @param nspace   namespace string
+*
+* @param rank     rank, PMIX_RANK_UNDEF checks for any rank.
+*
+* @return PMIX_SUCCESS if it does, PMIX_ERR_NOT_FOUND otherwise.
+*/
+typedef int (*pmix_dstore_base_module_rank_stored_fn_t)(const char *nspace,
+                                                        pmix_rank_t rank);
+
 /**
 * structure for dstore modules
 */
@@ -106,6 +182,11 @@ typedef struct {
     pmix_dstore_base_module_fetch_fn_t       fetch;
     pmix_dstore_base_module_proc_patch_env_fn_t   patch_env;
     pmix_dstore_base_module_add_nspace_fn_t  nspace;
+    pmix_dstore_base_module_del_nspace_fn_t  nspace_del;
+    pmix_dstore_base_module_fetch_ptr_fn_t   fetch_ptr;
+    pmix_dstore_base_module_is_mapped_fn_t   is_mapped;
+    pmix_dstore_base_module_store_many_fn_t  store_many;
+    pmix_dstore_base_module_rank_stored_fn_t rank_stored;
 } pmix_dstore_base_module_t;
 
 END_C_DECLS
@@ -16,6 +16,8 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <sys/file.h>
+#include <sched.h>
+#include <errno.h>
 
 #include <src/include/pmix_config.h>
 #include <pmix_server.h>
@@ -37,9 +39,14 @@
 static int _esh_init(pmix_info_t info[], size_t ninfo);
 static int _esh_finalize(void);
 static int _esh_store(const char *nspace, pmix_rank_t rank, pmix_kval_t *kv);
+static int _esh_store_many(const char *nspace, pmix_rank_t ranks[], pmix_kval_t *kvs[], size_t n);
 static int _esh_fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value_t **kvs);
+static int _esh_fetch_ptr(const char *nspace, pmix_rank_t rank, const char *key, pmix_value_t **kvs);
+static int _esh_is_mapped(const void *addr);
+static int _esh_rank_stored(const char *nspace, pmix_rank_t rank);
 static int _esh_patch_env(char ***env);
 static int _esh_nspace(const char *nspace);
+static int _esh_nspace_del(const char *nspace);
 
 pmix_dstore_base_module_t pmix_dstore_esh_module = {
     "esh",
@@ -49,45 +56,68 @@ pmix_dstore_base_module_t pmix_dstore_esh_module = {
     _esh_fetch,
     _esh_patch_env,
     _esh_nspace,
+    _esh_nspace_del,
+    _esh_fetch_ptr,
+    _esh_is_mapped,
+    _esh_store_many,
+    _esh_rank_stored,
 };
 
 #define ESH_REGION_EXTENSION        "EXTENSION_SLOT"
 #define ESH_REGION_INVALIDATED      "INVALIDATED"
+#define ESH_REGION_INDEX            "INDEX_SLOT"
 #define ESH_ENV_INITIAL_SEG_SIZE    "INITIAL_SEG_SIZE"
 #define ESH_ENV_NS_META_SEG_SIZE    "NS_META_SEG_SIZE"
 #define ESH_ENV_NS_DATA_SEG_SIZE    "NS_DATA_SEG_SIZE"
+#define ESH_ENV_NS_DATA_COMPACT     "NS_DATA_COMPACT"
+#define ESH_ENV_NS_DATA_DEDUP       "NS_DATA_DEDUP"
 #define ESH_ENV_LINEAR              "SM_USE_LINEAR_SEARCH"
+#define ESH_ENV_KEY_INDEX           "SM_USE_KEY_INDEX"
+#define ESH_ENV_FLOCK               "SM_USE_FLOCK"
 
-#define EXT_SLOT_SIZE (PMIX_MAX_KEYLEN + 1 + 2*sizeof(size_t)) /* in ext slot new offset will be stored in case if new data were added for the same process during next commit */
+/* number of attempts of a lock-free fetch before falling back to the lock */
+#define ESH_MAX_READ_RETRIES        100
+
+#define EXT_SLOT_SIZE (_rec_size(ESH_REGION_EXTENSION, sizeof(size_t))) /* in ext slot new offset will be stored in case if new data were added for the same process during next commit */
 #define KVAL_SIZE(size) (PMIX_MAX_KEYLEN + 1 + sizeof(size_t) + size)
+#define ESH_VAL_HDR_SIZE sizeof(size_t)
 
 static int _store_data_for_rank(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_buffer_t *buf);
-static seg_desc_t *_create_new_segment(segment_type type, char *nsname, uint32_t id);
-static seg_desc_t *_attach_new_segment(segment_type type, char *nsname, uint32_t id);
+static seg_desc_t *_create_new_segment(esh_session_t *s, segment_type type, char *nsname, uint32_t id);
+static seg_desc_t *_attach_new_segment(esh_session_t *s, segment_type type, char *nsname, uint32_t id);
 static int _update_ns_elem(ns_track_elem_t *ns_elem, ns_seg_info_t *info);
-static int _put_ns_info_to_initial_segment(const char *nspace, pmix_sm_seg_t *metaseg, pmix_sm_seg_t *dataseg);
-static ns_seg_info_t *_get_ns_info_from_initial_segment(const char *nspace);
-static ns_track_elem_t *_get_track_elem_for_namespace(const char *nspace);
+static int _put_ns_info_to_initial_segment(esh_session_t *s, const char *nspace, pmix_sm_seg_t *metaseg, pmix_sm_seg_t *dataseg);
+static ns_seg_info_t *_get_ns_info_from_initial_segment(esh_session_t *s, const char *nspace);
+static ns_track_elem_t *_get_track_elem_for_namespace(esh_session_t *s, const char *nspace);
+static esh_session_t *_create_session(const char *nspace);
+static esh_session_t *_attach_session(const char *nspace);
+static esh_session_t *_find_session(const char *nspace);
+static esh_session_t *_get_session(const char *nspace, int create);
 static rank_meta_info *_get_rank_meta_info(pmix_rank_t rank, seg_desc_t *segdesc);
 static uint8_t *_get_data_region_by_offset(seg_desc_t *segdesc, size_t offset);
-static void _update_initial_segment_info(void);
+static void _update_initial_segment_info(esh_session_t *s);
 static void _set_constants_from_env(void);
 static void _delete_sm_desc(seg_desc_t *desc);
 static int _pmix_getpagesize(void);
 static inline uint32_t _get_univ_size(const char *nspace);
-
-static seg_desc_t *_global_sm_seg_first;
-static seg_desc_t *_global_sm_seg_last;
-static pmix_list_t _namespace_info_list;
+static inline size_t _rank_meta_idx(pmix_rank_t rank);
+static int _build_rank_index(ns_track_elem_t *ns_info, rank_meta_info *rinfo);
+static uint8_t *_lookup_rank_index(seg_desc_t *data_seg, rank_meta_info *rinfo, const char *key);
+static int _unpack_value(uint8_t *addr, pmix_value_t **kvs, int borrow);
+static int _encode_value(pmix_value_t *val, pmix_buffer_t *buffer);
+static int _fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value_t **kvs, int borrow);
+static int _fetch_data(esh_session_t *s, const char *nspace, pmix_rank_t rank, uint32_t nprocs, const char *key, pmix_value_t **kvs, int borrow, const size_t *gen);
+static void _release_value(pmix_value_t *val, int borrow);
+static inline int _region_is_valid(seg_desc_t *data_seg, uint8_t *addr, size_t size);
+static inline int _rec_is_valid(seg_desc_t *data_seg, uint8_t *addr);
+
+static pmix_list_t _session_list;
 static char *_base_path = NULL;
 static size_t _initial_segment_size = 0;
 static size_t _max_ns_num;
 static size_t _meta_segment_size = 0;
 static size_t _max_meta_elems;
 static size_t _data_segment_size = 0;
-static int _lockfd;
-static char *_lockfile_name;
-static char *_nspace_path = NULL;
 static uid_t jobuid;
 static char setjobuid = 0;
 
@@ -100,23 +130,318 @@ static char setjobuid = 0;
  */
 static int _direct_mode = 0;
 
+/* If _key_index is set, then a per-rank hash index of the keys is
+ * maintained next to the data of every rank, so the fetch doesn't
+ * have to walk all the key-value records of the rank.
+ */
+static int _key_index = 1;
+
+/* Layout of the records in the data segments. The server takes it
+ * from the environment and advertises it in the initial segment, so
+ * clients always use the layout of the server.
+ */
+static int _data_layout = ESH_DATA_LAYOUT_FULL;
+
+/* If _dedup is set, then the server stores every value only once per
+ * data segment and the records of all other ranks holding the same
+ * value refer to that copy. It takes the compact layout, and only
+ * the server has to know about it. The server sets it from the
+ * environment.
+ */
+static int _dedup = 0;
+
+/* only values of this size range are looked up for sharing - smaller
+ * ones save too little for the cost of the lookup */
+#define ESH_DEDUP_MIN_SIZE          24
+#define ESH_DEDUP_MAX_SIZE          1024
+
+/* If _lock_free is set, then clients don't take the lock file to
+ * read the shared memory. Instead they check the generation counter
+ * of the initial segment before and after the fetch and retry it if
+ * the server has modified the data in between. The server always
+ * updates the counter, so both modes can be mixed.
+ */
+static int _lock_free = 1;
+
+/* contention statistics of this process, reported at finalize */
+static struct {
+    size_t stores;
+    size_t fetches;
+    size_t retries;     /* lock-free fetches repeated because of a concurrent store */
+    size_t waits;       /* times a reader found the server in the middle of a store */
+    size_t fallbacks;   /* lock-free fetches given up in favor of the lock */
+    size_t contended;   /* lock acquisitions that had to block */
+} _esh_stats;
+
+static inline volatile size_t *_generation(esh_session_t *s)
+{
+    return &((initial_seg_hdr_t*)s->sm_seg_first->seg_info.seg_base_addr)->generation;
+}
+
+static inline void _write_begin(esh_session_t *s)
+{
+    (*_generation(s))++;
+    __sync_synchronize();
+}
+
+static inline void _write_end(esh_session_t *s)
+{
+    __sync_synchronize();
+    (*_generation(s))++;
+}
+
+/* a lock-free reader may see the shared memory in the middle of an
+ * update - it checks that the generation it started with still holds
+ * before it acts on anything it read from there */
+static inline int _read_valid(esh_session_t *s, const size_t *gen)
+{
+    if (NULL == gen) {
+        return 1;
+    }
+    __sync_synchronize();
+    return *gen == *_generation(s);
+}
+
+static inline void _lock(esh_session_t *s, int operation)
+{
+    if (0 != flock(s->lockfd, operation | LOCK_NB)) {
+        if (EWOULDBLOCK == errno) {
+            _esh_stats.contended++;
+        }
+        flock(s->lockfd, operation);
+    }
+}
+
+/* bytes of shared memory mapped for the nspace */
+static inline size_t _ns_mapped_bytes(ns_track_elem_t *elem)
+{
+    return elem->num_meta_seg * _meta_segment_size +
+           elem->num_data_seg * _data_segment_size;
+}
+
+static inline size_t _align8(size_t n)
+{
+    return (n + 7) & ~((size_t)7);
+}
+
+/* Accessors of the key-value records. They hide the difference
+ * between the full and the compact layout from the code that walks
+ * the data of a rank. */
+static inline size_t _rec_size(const char *key, size_t size)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        return sizeof(esh_rec_hdr_t) + _align8(strnlen(key, PMIX_MAX_KEYLEN) + 1) + _align8(size);
+    }
+    return KVAL_SIZE(size);
+}
+
+static inline const char *_rec_key(uint8_t *addr)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        return (const char *)(addr + sizeof(esh_rec_hdr_t));
+    }
+    return (const char *)addr;
+}
+
+static inline size_t _rec_data_size(uint8_t *addr)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        return ((esh_rec_hdr_t*)addr)->size;
+    }
+    return *(size_t *)(addr + PMIX_MAX_KEYLEN + 1);
+}
+
+static inline uint8_t *_rec_data(uint8_t *addr)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        uint8_t *data = addr + sizeof(esh_rec_hdr_t) + _align8(((esh_rec_hdr_t*)addr)->keylen);
+        if (((esh_rec_hdr_t*)addr)->flags & ESH_REC_SHARED) {
+            return addr - *(size_t *)data;
+        }
+        return data;
+    }
+    return addr + PMIX_MAX_KEYLEN + 1 + sizeof(size_t);
+}
+
+static inline size_t _rec_total_size(uint8_t *addr)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        if (((esh_rec_hdr_t*)addr)->flags & ESH_REC_SHARED) {
+            return sizeof(esh_rec_hdr_t) + _align8(((esh_rec_hdr_t*)addr)->keylen) + sizeof(size_t);
+        }
+        return sizeof(esh_rec_hdr_t) + _align8(((esh_rec_hdr_t*)addr)->keylen) +
+               _align8(((esh_rec_hdr_t*)addr)->size);
+    }
+    return KVAL_SIZE(_rec_data_size(addr));
+}
+
+/* a record can only be overwritten in place if it holds its own
+ * value and no other record refers to it */
+static inline int _rec_is_shared(uint8_t *addr)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        return (0 != (((esh_rec_hdr_t*)addr)->flags & (ESH_REC_SHARED | ESH_REC_REFERENCED)));
+    }
+    return 0;
+}
+
+/* a reader may hold a pointer to the bytes of a byte object, see
+ * _esh_fetch_ptr, so such a record is never overwritten in place */
+static inline int _rec_is_borrowable(uint8_t *addr)
+{
+    size_t type;
+
+    if (ESH_DATA_LAYOUT_COMPACT != _data_layout || ESH_VAL_HDR_SIZE > _rec_data_size(addr)) {
+        return 0;
+    }
+    memcpy(&type, _rec_data(addr), ESH_VAL_HDR_SIZE);
+    return (PMIX_BYTE_OBJECT == type);
+}
+
+static inline int _rec_is(uint8_t *addr, const char *key)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        if (((esh_rec_hdr_t*)addr)->flags & ESH_REC_INVALIDATED) {
+            return (0 == strcmp(key, ESH_REGION_INVALIDATED));
+        }
+    }
+    return (0 == strncmp(_rec_key(addr), key, PMIX_MAX_KEYLEN+1));
+}
+
+static inline void _rec_invalidate(uint8_t *addr)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        ((esh_rec_hdr_t*)addr)->flags |= ESH_REC_INVALIDATED;
+    } else {
+        strncpy((char *)addr, ESH_REGION_INVALIDATED, PMIX_MAX_KEYLEN+1);
+    }
+}
+
+static inline void _rec_write(uint8_t *addr, const char *key, const void *data, size_t size)
+{
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        esh_rec_hdr_t hdr;
+        hdr.size = size;
+        hdr.keylen = strnlen(key, PMIX_MAX_KEYLEN) + 1;
+        hdr.flags = 0;
+        memcpy(addr, &hdr, sizeof(hdr));
+        addr += sizeof(hdr);
+        memset(addr, 0, _align8(hdr.keylen));
+        memcpy(addr, key, hdr.keylen - 1);
+        addr += _align8(hdr.keylen);
+    } else {
+        strncpy((char *)addr, key, PMIX_MAX_KEYLEN+1);
+        memcpy(addr + PMIX_MAX_KEYLEN + 1, &size, sizeof(size_t));
+        addr += PMIX_MAX_KEYLEN + 1 + sizeof(size_t);
+    }
+    memcpy(addr, data, size);
+}
+
+/* write a compact record referring to the value of size bytes
+ * that starts dist bytes before the record */
+static inline void _rec_write_shared(uint8_t *addr, const char *key, size_t size, size_t dist)
+{
+    esh_rec_hdr_t hdr;
+
+    hdr.size = size;
+    hdr.keylen = strnlen(key, PMIX_MAX_KEYLEN) + 1;
+    hdr.flags = ESH_REC_SHARED;
+    memcpy(addr, &hdr, sizeof(hdr));
+    addr += sizeof(hdr);
+    memset(addr, 0, _align8(hdr.keylen));
+    memcpy(addr, key, hdr.keylen - 1);
+    addr += _align8(hdr.keylen);
+    memcpy(addr, &dist, sizeof(size_t));
+}
+
+static void _report_session(esh_session_t *s)
+{
+    ns_track_elem_t *elem;
+    seg_desc_t *seg;
+    size_t total = 0;
+
+    for (seg = s->sm_seg_first; NULL != seg; seg = seg->next) {
+        total += _initial_segment_size;
+    }
+    PMIX_LIST_FOREACH(elem, &s->ns_list, ns_track_elem_t) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "dstore: session %s: nspace %s maps %lu bytes in %lu meta and %lu data segments",
+                            s->ns_name, elem->ns_name, (unsigned long)_ns_mapped_bytes(elem),
+                            (unsigned long)elem->num_meta_seg, (unsigned long)elem->num_data_seg);
+        if (0 < elem->nshared) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                                "dstore: session %s: nspace %s shares the values of %lu records, saving %lu bytes",
+                                s->ns_name, elem->ns_name, (unsigned long)elem->nshared,
+                                (unsigned long)elem->shared_bytes);
+        }
+        total += _ns_mapped_bytes(elem);
+    }
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "dstore: session %s maps %lu bytes in total",
+                        s->ns_name, (unsigned long)total);
+}
+
 static void ncon(ns_track_elem_t *p) {
     memset(p->ns_name, 0, sizeof(p->ns_name));
     p->meta_seg = NULL;
     p->data_seg = NULL;
     p->num_meta_seg = 0;
     p->num_data_seg = 0;
+    p->session = NULL;
+    p->interned = NULL;
+    p->nshared = 0;
+    p->shared_bytes = 0;
 }
 
 static void ndes(ns_track_elem_t *p) {
     _delete_sm_desc(p->meta_seg);
     _delete_sm_desc(p->data_seg);
+    if (NULL != p->interned) {
+        PMIX_RELEASE(p->interned);
+    }
 }
 
 PMIX_CLASS_INSTANCE(ns_track_elem_t,
                     pmix_list_item_t,
                     ncon, ndes);
 
+static void scon(esh_session_t *p) {
+    memset(p->ns_name, 0, sizeof(p->ns_name));
+    p->nspace_path = NULL;
+    p->lockfile = NULL;
+    p->lockfd = -1;
+    p->sm_seg_first = NULL;
+    p->sm_seg_last = NULL;
+    PMIX_CONSTRUCT(&p->ns_list, pmix_list_t);
+}
+
+static void sdes(esh_session_t *p) {
+    /* detach from the segments, the server also unlinks them */
+    PMIX_LIST_DESTRUCT(&p->ns_list);
+    _delete_sm_desc(p->sm_seg_first);
+    if (-1 != p->lockfd) {
+        close(p->lockfd);
+    }
+    if (pmix_globals.server) {
+        if (NULL != p->lockfile) {
+            unlink(p->lockfile);
+        }
+        if (NULL != p->nspace_path) {
+            rmdir(p->nspace_path);
+        }
+    }
+    if (NULL != p->lockfile) {
+        free(p->lockfile);
+    }
+    if (NULL != p->nspace_path) {
+        free(p->nspace_path);
+    }
+}
+
+PMIX_CLASS_INSTANCE(esh_session_t,
+                    pmix_list_item_t,
+                    scon, sdes);
+
 static inline int _is_server(void)
 {
     return (pmix_globals.server);
@@ -147,7 +472,7 @@ static inline const char *_unique_id(void)
 int _esh_init(pmix_info_t info[], size_t ninfo)
 {
     int rc;
-    seg_desc_t *seg;
+    esh_session_t *s;
     size_t n;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
@@ -204,11 +529,6 @@ int _esh_init(pmix_info_t info[], size_t ninfo)
             PMIX_ERROR_LOG(PMIX_ERROR);
             return PMIX_ERROR;
         }
-
-        if (0 > asprintf(&_nspace_path, "%s/%s", _base_path, pmix_globals.myid.nspace)) {
-            PMIX_ERROR_LOG(PMIX_ERROR);
-            return PMIX_ERROR;
-        }
     }
 
     rc = pmix_sm_init();
@@ -217,39 +537,24 @@ int _esh_init(pmix_info_t info[], size_t ninfo)
         return rc;
     }
 
-    PMIX_CONSTRUCT(&_namespace_info_list, pmix_list_t);
-    _global_sm_seg_first = NULL;
-    _global_sm_seg_last = NULL;
+    PMIX_CONSTRUCT(&_session_list, pmix_list_t);
     _set_constants_from_env();
-    _max_ns_num = (_initial_segment_size - sizeof(size_t) - sizeof(int)) / sizeof(ns_seg_info_t);
+    _max_ns_num = (_initial_segment_size - sizeof(initial_seg_hdr_t)) / sizeof(ns_seg_info_t);
     _max_meta_elems = (_meta_segment_size - sizeof(size_t)) / sizeof(rank_meta_info);
 
     if (_is_server()){
         return PMIX_SUCCESS;
     }
     else {
-        /* create a lock file to prevent clients from reading while server is writing to the shared memory.
-        * This situation is quite often, especially in case of direct modex when clients might ask for data
-        * simultaneously.*/
-        if(0 > asprintf(&_lockfile_name, "%s/%s_dstore_sm.lock",
-                        _nspace_path, _unique_id())) {
-            PMIX_ERROR_LOG(PMIX_ERROR);
-            return PMIX_ERROR;
-        }
-        _lockfd = open(_lockfile_name, O_RDONLY);
-
-        if (-1 == _lockfd) {
-            PMIX_ERROR_LOG(PMIX_ERROR);
-            return PMIX_ERROR;
-        }
-
-        seg = _attach_new_segment(INITIAL_SEGMENT, NULL, 0);
-
-        if (NULL != seg) {
-            _global_sm_seg_first = seg;
-            _global_sm_seg_last = _global_sm_seg_first;
+        /* clients start with the session of their own nspace and
+         * attach to the sessions of other nspaces when they need them */
+        s = _attach_session(pmix_globals.myid.nspace);
+        if (NULL != s) {
+            /* follow the layout of the server */
+            _data_layout = ((initial_seg_hdr_t*)s->sm_seg_first->seg_info.seg_base_addr)->data_layout;
             return PMIX_SUCCESS;
         }
+        PMIX_ERROR_LOG(PMIX_ERROR);
     }
 
     return PMIX_ERROR;
@@ -257,29 +562,24 @@ int _esh_init(pmix_info_t info[], size_t ninfo)
 
 int _esh_finalize(void)
 {
+    esh_session_t *s;
+
     PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                          "%s:%d:%s", __FILE__, __LINE__, __func__));
 
-    _delete_sm_desc(_global_sm_seg_first);
-    PMIX_LIST_DESTRUCT(&_namespace_info_list);
-
-    close(_lockfd);
-    if (_is_server()) {
-        if (NULL != _lockfile_name) {
-            unlink(_lockfile_name);
-        }
-        if (NULL != _nspace_path) {
-            rmdir(_nspace_path);
-        }
-    }
-
-    if (NULL != _lockfile_name) {
-        free(_lockfile_name);
-    }
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "dstore: %s mode, %lu stores, %lu fetches, %lu retries, "
+                        "%lu waits, %lu lock fallbacks, %lu contended locks",
+                        _lock_free ? "lock-free" : "flock",
+                        (unsigned long)_esh_stats.stores, (unsigned long)_esh_stats.fetches,
+                        (unsigned long)_esh_stats.retries, (unsigned long)_esh_stats.waits,
+                        (unsigned long)_esh_stats.fallbacks, (unsigned long)_esh_stats.contended);
 
-    if (NULL != _nspace_path) {
-        free(_nspace_path);
+    PMIX_LIST_FOREACH(s, &_session_list, esh_session_t) {
+        _report_session(s);
     }
+    /* this also unlinks all the segments of the server */
+    PMIX_LIST_DESTRUCT(&_session_list);
 
     pmix_sm_finalize();
 
@@ -289,21 +589,45 @@ int _esh_finalize(void)
 
 int _esh_store(const char *nspace, pmix_rank_t rank, pmix_kval_t *kv)
 {
-    int rc;
+    return _esh_store_many(nspace, &rank, &kv, 1);
+}
+
+/* Store a batch of values of one namespace. The lock is taken and
+ * the readers are told about the change only once for the batch */
+static int _esh_store_many(const char *nspace, pmix_rank_t ranks[], pmix_kval_t *kvs[], size_t n)
+{
+    int rc = PMIX_SUCCESS, ret;
+    esh_session_t *s;
     ns_track_elem_t *elem;
     pmix_buffer_t pbkt, xfer;
     ns_seg_info_t ns_info;
+    size_t i;
 
-    if (NULL == kv) {
+    if (NULL == ranks || NULL == kvs) {
         return PMIX_ERROR;
     }
+    for (i = 0; i < n; i++) {
+        if (NULL == kvs[i]) {
+            return PMIX_ERROR;
+        }
+    }
 
     PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
-                         "%s:%d:%s: for %s:%u",
-                         __FILE__, __LINE__, __func__, nspace, rank));
+                         "%s:%d:%s: for %s: %lu values",
+                         __FILE__, __LINE__, __func__, nspace, (unsigned long)n));
 
-    /* set exclusive lock */
-    flock(_lockfd, LOCK_EX);
+    s = _get_session(nspace, 1);
+    if (NULL == s) {
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        return PMIX_ERROR;
+    }
+
+    /* set exclusive lock, it still serializes the server against
+     * clients that read under the lock */
+    _lock(s, LOCK_EX);
+    _esh_stats.stores += n;
+    /* let lock-free readers know that the data is being changed */
+    _write_begin(s);
 
     /* First of all, we go through local track list (list of ns_track_elem_t structures)
      * and look for an element for the target namespace.
@@ -315,11 +639,12 @@ int _esh_store(const char *nspace, pmix_rank_t rank, pmix_kval_t *kv)
      * All this stuff is done inside _get_track_elem_for_namespace function.
      */
 
-    elem = _get_track_elem_for_namespace(nspace);
+    elem = _get_track_elem_for_namespace(s, nspace);
     if (NULL == elem) {
         PMIX_ERROR_LOG(PMIX_ERROR);
+        _write_end(s);
         /* unset lock */
-        flock(_lockfd, LOCK_UN);
+        flock(s->lockfd, LOCK_UN);
         return PMIX_ERROR;
     }
 
@@ -333,8 +658,9 @@ int _esh_store(const char *nspace, pmix_rank_t rank, pmix_kval_t *kv)
         rc = _update_ns_elem(elem, &ns_info);
         if (PMIX_SUCCESS != rc || NULL == elem->meta_seg || NULL == elem->data_seg) {
             PMIX_ERROR_LOG(rc);
+            _write_end(s);
             /* unset lock */
-            flock(_lockfd, LOCK_UN);
+            flock(s->lockfd, LOCK_UN);
             return PMIX_ERROR;
         }
 
@@ -343,11 +669,12 @@ int _esh_store(const char *nspace, pmix_rank_t rank, pmix_kval_t *kv)
         memset(elem->data_seg->seg_info.seg_base_addr, 0, _data_segment_size);
 
         /* put ns's shared segments info to the global meta segment. */
-        rc = _put_ns_info_to_initial_segment(nspace, &elem->meta_seg->seg_info, &elem->data_seg->seg_info);
+        rc = _put_ns_info_to_initial_segment(s, nspace, &elem->meta_seg->seg_info, &elem->data_seg->seg_info);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
+            _write_end(s);
             /* unset lock */
-            flock(_lockfd, LOCK_UN);
+            flock(s->lockfd, LOCK_UN);
             return rc;
         }
     }
@@ -356,35 +683,127 @@ int _esh_store(const char *nspace, pmix_rank_t rank, pmix_kval_t *kv)
      * is not empty, then we look for data for the target rank. If they present, replace it. */
     PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
     PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
-    PMIX_LOAD_BUFFER(&xfer, kv->value->data.bo.bytes, kv->value->data.bo.size);
     pmix_buffer_t *pxfer = &xfer;
-    pmix_bfrop.pack(&pbkt, &pxfer, 1, PMIX_BUFFER);
+    for (i = 0; i < n; i++) {
+        xfer.base_ptr = (char*)kvs[i]->value->data.bo.bytes;
+        xfer.bytes_used = kvs[i]->value->data.bo.size;
+        pbkt.pack_ptr = pbkt.base_ptr;
+        pbkt.unpack_ptr = pbkt.base_ptr;
+        pbkt.bytes_used = 0;
+        pmix_bfrop.pack(&pbkt, &pxfer, 1, PMIX_BUFFER);
+
+        /* the values are independent, so a failure doesn't stop the batch */
+        if (PMIX_SUCCESS != (ret = _store_data_for_rank(elem, ranks[i], &pbkt))) {
+            PMIX_ERROR_LOG(ret);
+            rc = ret;
+        }
+    }
     xfer.base_ptr = NULL;
     xfer.bytes_used = 0;
 
-    rc = _store_data_for_rank(elem, rank, &pbkt);
-
     PMIX_DESTRUCT(&xfer);
     PMIX_DESTRUCT(&pbkt);
 
+    _write_end(s);
     /* unset lock */
-    flock(_lockfd, LOCK_UN);
+    flock(s->lockfd, LOCK_UN);
     return rc;
 }
 
 int _esh_fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value_t **kvs)
 {
-    ns_seg_info_t *ns_info = NULL;
-    int rc;
+    return _fetch(nspace, rank, key, kvs, 0);
+}
+
+/* Same as _esh_fetch, but the bytes of a byte object stored natively
+ * are not copied: the returned value points into the shared memory */
+int _esh_fetch_ptr(const char *nspace, pmix_rank_t rank, const char *key, pmix_value_t **kvs)
+{
+    return _fetch(nspace, rank, key, kvs, 1);
+}
+
+/* check whether the address belongs to any data segment we have
+ * mapped, i.e. it was returned by _esh_fetch_ptr */
+static int _esh_is_mapped(const void *addr)
+{
+    esh_session_t *s;
+    ns_track_elem_t *elem;
+    seg_desc_t *seg;
+    const uint8_t *base;
+
+    PMIX_LIST_FOREACH(s, &_session_list, esh_session_t) {
+        PMIX_LIST_FOREACH(elem, &s->ns_list, ns_track_elem_t) {
+            for (seg = elem->data_seg; NULL != seg; seg = seg->next) {
+                base = (const uint8_t *)seg->seg_info.seg_base_addr;
+                if ((const uint8_t *)addr >= base &&
+                    (const uint8_t *)addr < base + seg->seg_info.seg_size) {
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* check the meta segments for a record of the rank, this lets the
+ * server answer requests for the data of remote ranks without
+ * keeping a copy of it */
+static int _esh_rank_stored(const char *nspace, pmix_rank_t rank)
+{
+    esh_session_t *s;
+    ns_seg_info_t *ns_info;
     ns_track_elem_t *elem;
-    rank_meta_info *rinfo = NULL;
-    size_t kval_cnt;
-    seg_desc_t *meta_seg, *data_seg;
-    uint8_t *addr;
-    pmix_buffer_t buffer;
-    pmix_value_t val;
-    uint32_t nprocs;
     pmix_rank_t cur_rank;
+    uint32_t nprocs = 0;
+    int rc = PMIX_ERR_NOT_FOUND;
+
+    s = _get_session(nspace, 0);
+    if (NULL == s) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (PMIX_RANK_UNDEF == rank) {
+        nprocs = _get_univ_size(nspace);
+    }
+
+    /* set shared lock */
+    _lock(s, LOCK_SH);
+    _update_initial_segment_info(s);
+    ns_info = _get_ns_info_from_initial_segment(s, nspace);
+    if (NULL == ns_info) {
+        goto done;
+    }
+    elem = _get_track_elem_for_namespace(s, nspace);
+    if (NULL == elem || PMIX_SUCCESS != _update_ns_elem(elem, ns_info)) {
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        rc = PMIX_ERROR;
+        goto done;
+    }
+    if (PMIX_RANK_UNDEF != rank) {
+        if (NULL != _get_rank_meta_info(rank, elem->meta_seg)) {
+            rc = PMIX_SUCCESS;
+        }
+        goto done;
+    }
+    /* any rank of the nspace will do */
+    for (cur_rank = 0; cur_rank < nprocs; cur_rank++) {
+        if (NULL != _get_rank_meta_info(cur_rank, elem->meta_seg)) {
+            rc = PMIX_SUCCESS;
+            break;
+        }
+    }
+
+done:
+    /* unset lock */
+    flock(s->lockfd, LOCK_UN);
+    return rc;
+}
+
+static int _fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value_t **kvs, int borrow)
+{
+    int rc, n;
+    esh_session_t *s;
+    uint32_t nprocs;
+    size_t gen;
 
     if (NULL == key) {
         PMIX_OUTPUT_VERBOSE((7, pmix_globals.debug_output,
@@ -402,14 +821,77 @@ int _esh_fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value
 
     if (PMIX_RANK_UNDEF == rank) {
         nprocs = _get_univ_size(nspace);
-        cur_rank = PMIX_RANK_UNDEF;
     } else {
         nprocs = 1;
-        cur_rank = rank;
+    }
+    _esh_stats.fetches++;
+
+    s = _get_session(nspace, 0);
+    if (NULL == s) {
+        PMIX_OUTPUT_VERBOSE((7, pmix_globals.debug_output,
+                    "%s:%d:%s:  no session for ns %s",
+                    __FILE__, __LINE__, __func__, nspace));
+        /* the server has no data of the nspace yet */
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    if (1 == _lock_free) {
+        for (n = 0; n < ESH_MAX_READ_RETRIES; n++) {
+            gen = *_generation(s);
+            __sync_synchronize();
+            if (gen & 1) {
+                /* the server is in the middle of a store */
+                _esh_stats.waits++;
+                sched_yield();
+                continue;
+            }
+            rc = _fetch_data(s, nspace, rank, nprocs, key, kvs, borrow, &gen);
+            if (PMIX_ERR_WOULD_BLOCK == rc) {
+                /* new segments have to be attached first */
+                break;
+            }
+            __sync_synchronize();
+            if (gen == *_generation(s)) {
+                return rc;
+            }
+            /* the data was changed while we were reading it, so
+             * whatever we got may be inconsistent */
+            _esh_stats.retries++;
+            if (kvs && NULL != *kvs) {
+                _release_value(*kvs, borrow);
+                *kvs = NULL;
+            }
+        }
+        /* the server keeps updating the data, so wait for it */
+        _esh_stats.fallbacks++;
     }
 
     /* set shared lock */
-    flock(_lockfd, LOCK_SH);
+    _lock(s, LOCK_SH);
+    rc = _fetch_data(s, nspace, rank, nprocs, key, kvs, borrow, NULL);
+    /* unset lock */
+    flock(s->lockfd, LOCK_UN);
+    return rc;
+}
+
+/* Looks the key up in the shared memory. The caller is responsible
+ * for the synchronization with the server - either it holds the lock,
+ * or it passes the generation it read before the fetch. A lock-free
+ * fetch never attaches new segments, it returns PMIX_ERR_WOULD_BLOCK
+ * so the caller takes the lock instead. */
+static int _fetch_data(esh_session_t *s, const char *nspace, pmix_rank_t rank, uint32_t nprocs, const char *key, pmix_value_t **kvs, int borrow, const size_t *gen)
+{
+    ns_seg_info_t *ns_info = NULL, info;
+    int rc;
+    ns_track_elem_t *elem;
+    rank_meta_info *rinfo = NULL, rmeta;
+    seg_desc_t *tmp;
+    size_t kval_cnt;
+    seg_desc_t *meta_seg, *data_seg;
+    uint8_t *addr;
+    pmix_rank_t cur_rank = rank;
+
+
 
     /* First of all, we go through all initial segments and look at their field.
      * If its 1, then generate name of next initial segment incrementing id by one and attach to it.
@@ -424,36 +906,45 @@ int _esh_fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value
      */
 
     /* first update local information about initial segments. they can be extended, so then we need to attach to new segments. */
-    _update_initial_segment_info();
+    if (NULL == gen) {
+        _update_initial_segment_info(s);
+    } else {
+        for (tmp = s->sm_seg_first; NULL != tmp->next; tmp = tmp->next);
+        if (1 == *((int*)((uint8_t*)(tmp->seg_info.seg_base_addr) + sizeof(size_t)))) {
+            return PMIX_ERR_WOULD_BLOCK;
+        }
+    }
 
     /* get information about shared segments per this namespace from the initial segment. */
-    ns_info = _get_ns_info_from_initial_segment(nspace);
+    ns_info = _get_ns_info_from_initial_segment(s, nspace);
     if (NULL == ns_info) {
         /* no data for this namespace is found in the shared memory. */
         PMIX_OUTPUT_VERBOSE((7, pmix_globals.debug_output,
                     "%s:%d:%s:  no data for ns %s is found in the shared memory.",
                     __FILE__, __LINE__, __func__, nspace));
-        /* unset lock */
-        flock(_lockfd, LOCK_UN);
+        return PMIX_ERROR;
+    }
+    memcpy(&info, ns_info, sizeof(info));
+    if (!_read_valid(s, gen)) {
         return PMIX_ERROR;
     }
 
     /* get ns_track_elem_t object for the target namespace from the local track list. */
-    elem = _get_track_elem_for_namespace(nspace);
+    elem = _get_track_elem_for_namespace(s, nspace);
     if (NULL == elem) {
         PMIX_ERROR_LOG(PMIX_ERROR);
-        /* unset lock */
-        flock(_lockfd, LOCK_UN);
         return PMIX_ERROR;
     }
+    if (NULL != gen && (elem->num_meta_seg < info.num_meta_seg ||
+                        elem->num_data_seg < info.num_data_seg)) {
+        return PMIX_ERR_WOULD_BLOCK;
+    }
     /* need to update tracker:
      * attach to shared memory regions for this namespace and store its info locally
      * to operate with address and detach/unlink afterwards. */
-    rc = _update_ns_elem(elem, ns_info);
+    rc = _update_ns_elem(elem, &info);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(PMIX_ERROR);
-        /* unset lock */
-        flock(_lockfd, LOCK_UN);
         return PMIX_ERROR;
     }
 
@@ -474,6 +965,11 @@ int _esh_fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value
             rc = PMIX_ERR_PROC_ENTRY_NOT_FOUND;
             continue;
         }
+        memcpy(&rmeta, rinfo, sizeof(rmeta));
+        if (!_read_valid(s, gen)) {
+            return PMIX_ERROR;
+        }
+        rinfo = &rmeta;
         addr = _get_data_region_by_offset(data_seg, rinfo->offset);
         if (NULL == addr) {
             PMIX_ERROR_LOG(PMIX_ERROR);
@@ -485,6 +981,19 @@ int _esh_fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value
          * setting to one initiates wrong next logic for unknown reason */
         rc = PMIX_ERROR;
 
+        if (1 == _key_index && 0 != rinfo->idx_offset) {
+            /* look the key up in the index of this rank */
+            addr = _lookup_rank_index(data_seg, rinfo, key);
+            if (NULL == addr) {
+                PMIX_OUTPUT_VERBOSE((7, pmix_globals.debug_output,
+                            "%s:%d:%s:  key %s not found in the index for rank %u",
+                            __FILE__, __LINE__, __func__, key, cur_rank));
+                continue;
+            }
+            rc = _unpack_value(addr, kvs, borrow);
+            goto done;
+        }
+
         while (0 < kval_cnt) {
             /* data is stored in the following format:
              * key[PMIX_MAX_KEYLEN+1]
@@ -493,17 +1002,23 @@ int _esh_fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value
              * next kval pair
              * .....
              * EXTENSION slot which has key = EXTENSION_SLOT and a size_t value for offset to next data address for this process.
+             * See pmix_esh.h for the compact layout of the records.
              */
-            if (0 == strncmp((const char *)addr, ESH_REGION_INVALIDATED, PMIX_MAX_KEYLEN+1)) {
+            if (!_rec_is_valid(data_seg, addr)) {
+                /* a lock-free reader may run into the records which
+                 * are being written by the server, it will retry */
+                rc = PMIX_ERROR;
+                goto done;
+            }
+            if (_rec_is(addr, ESH_REGION_INVALIDATED)) {
                 PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                             "%s:%d:%s: for rank %s:%u, skip %s region",
                             __FILE__, __LINE__, __func__, nspace, cur_rank, ESH_REGION_INVALIDATED));
                 /*skip it */
-                size_t size = *(size_t *)(addr + PMIX_MAX_KEYLEN + 1);
                 /* go to next item, updating address */
-                addr += KVAL_SIZE(size);
-            } else if (0 == strncmp((const char *)addr, ESH_REGION_EXTENSION, PMIX_MAX_KEYLEN+1)) {
-                size_t offset = *(size_t *)(addr + PMIX_MAX_KEYLEN + 1 + sizeof(size_t));
+                addr += _rec_total_size(addr);
+            } else if (_rec_is(addr, ESH_REGION_EXTENSION)) {
+                size_t offset = *(size_t *)_rec_data(addr);
                 PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                             "%s:%d:%s: for rank %s:%u, reached %s with %lu value",
                             __FILE__, __LINE__, __func__, nspace, cur_rank, ESH_REGION_EXTENSION, offset));
@@ -523,44 +1038,26 @@ int _esh_fetch(const char *nspace, pmix_rank_t rank, const char *key, pmix_value
                                 __FILE__, __LINE__, __func__, cur_rank, key));
                     break;
                 }
-            } else if (0 == strncmp((const char *)addr, key, PMIX_MAX_KEYLEN+1)) {
+            } else if (_rec_is(addr, key)) {
                 PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                             "%s:%d:%s: for rank %s:%u, found target key %s",
                             __FILE__, __LINE__, __func__, nspace, cur_rank, key));
                 /* target key is found, get value */
-                size_t size = *(size_t *)(addr + PMIX_MAX_KEYLEN + 1);
-                addr += PMIX_MAX_KEYLEN + 1 + sizeof(size_t);
-                PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
-                PMIX_LOAD_BUFFER(&buffer, addr, size);
-                int cnt = 1;
-                /* unpack value for this key from the buffer. */
-                PMIX_VALUE_CONSTRUCT(&val);
-                if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buffer, &val, &cnt, PMIX_VALUE))) {
-                    PMIX_ERROR_LOG(rc);
-                } else if (PMIX_SUCCESS != (rc = pmix_bfrop.copy((void**)kvs, &val, PMIX_VALUE))) {
-                    PMIX_ERROR_LOG(rc);
-                }
-                PMIX_VALUE_DESTRUCT(&val);
-                buffer.base_ptr = NULL;
-                buffer.bytes_used = 0;
-                PMIX_DESTRUCT(&buffer);
+                rc = _unpack_value(addr, kvs, borrow);
                 goto done;
             } else {
                 char ckey[PMIX_MAX_KEYLEN+1] = {0};
-                strncpy(ckey, (const char *)addr, PMIX_MAX_KEYLEN+1);
-                size_t size = *(size_t *)(addr + PMIX_MAX_KEYLEN + 1);
+                strncpy(ckey, _rec_key(addr), PMIX_MAX_KEYLEN);
                 PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                             "%s:%d:%s: for rank %s:%u, skip key %s look for key %s", __FILE__, __LINE__, __func__, nspace, cur_rank, ckey, key));
                 /* go to next item, updating address */
-                addr += KVAL_SIZE(size);
+                addr += _rec_total_size(addr);
                 kval_cnt--;
             }
         }
     }
 
 done:
-    /* unset lock */
-    flock(_lockfd, LOCK_UN);
     return rc;
 }
 
@@ -574,66 +1071,192 @@ static int _esh_patch_env(char ***env)
     return pmix_setenv(PMIX_DSTORE_ESH_BASE_PATH, _base_path, true, env);
 }
 
-static int _esh_nspace(const char *nspace)
+/* Create the session of the nspace. The initial segment is created
+ * before the lock file, so a client that opens the lock file of the
+ * session always finds the segment. */
+static esh_session_t *_create_session(const char *nspace)
 {
     struct stat st = {0};
-    seg_desc_t *seg;
+    esh_session_t *s;
+
+    s = PMIX_NEW(esh_session_t);
+    strncpy(s->ns_name, nspace, sizeof(s->ns_name)-1);
 
-    if (0 > asprintf(&_nspace_path, "%s/%s", _base_path, nspace)) {
+    if (0 > asprintf(&s->nspace_path, "%s/%s", _base_path, nspace)) {
+        PMIX_RELEASE(s);
         PMIX_ERROR_LOG(PMIX_ERROR);
-        return PMIX_ERROR;
+        return NULL;
     }
 
-    if (stat(_nspace_path, &st) == -1){
-        if (0 != mkdir(_nspace_path, 0770)) {
-            return PMIX_ERROR;
+    if (stat(s->nspace_path, &st) == -1){
+        if (0 != mkdir(s->nspace_path, 0770)) {
+            PMIX_RELEASE(s);
+            return NULL;
         }
     }
 
     if (setjobuid) {
-        if (chown(_nspace_path, (uid_t) jobuid, (gid_t) -1) < 0){
+        if (chown(s->nspace_path, (uid_t) jobuid, (gid_t) -1) < 0){
             PMIX_ERROR_LOG(PMIX_ERROR);
         }
     }
 
-    if (0 > asprintf(&_lockfile_name, "%s/%s_dstore_sm.lock", _nspace_path, _unique_id())) {
+    s->sm_seg_first = _create_new_segment(s, INITIAL_SEGMENT, NULL, 0);
+
+    if (NULL == s->sm_seg_first) {
+        PMIX_RELEASE(s);
         PMIX_ERROR_LOG(PMIX_ERROR);
-        return PMIX_ERROR;
+        return NULL;
+    }
+    s->sm_seg_last = s->sm_seg_first;
+    ((initial_seg_hdr_t*)s->sm_seg_first->seg_info.seg_base_addr)->data_layout = _data_layout;
+
+    if (0 > asprintf(&s->lockfile, "%s/%s_dstore_sm.lock", s->nspace_path, _unique_id())) {
+        PMIX_RELEASE(s);
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        return NULL;
     }
 
-    _lockfd = open(_lockfile_name, O_CREAT | O_RDWR | O_EXCL, 0600);
+    s->lockfd = open(s->lockfile, O_CREAT | O_RDWR | O_EXCL, 0600);
     /* if previous launch was crashed, the lockfile might not be deleted and unlocked,
      * so we delete it and create a new one. */
-    if (-1 == _lockfd) {
-        unlink(_lockfile_name);
-        _lockfd = open(_lockfile_name, O_CREAT | O_RDWR, 0600);
+    if (-1 == s->lockfd) {
+        unlink(s->lockfile);
+        s->lockfd = open(s->lockfile, O_CREAT | O_RDWR, 0600);
     }
 
-    if ( setjobuid && (_lockfd != -1)) {
-        if (chown(_lockfile_name, (uid_t) jobuid, (gid_t) -1) < 0) {
+    if ( setjobuid && (s->lockfd != -1)) {
+        if (chown(s->lockfile, (uid_t) jobuid, (gid_t) -1) < 0) {
+            PMIX_RELEASE(s);
             PMIX_ERROR_LOG(PMIX_ERROR);
-            return PMIX_ERROR;
+            return NULL;
         }
         /* set the mode as required */
-        if (0 != chmod(_lockfile_name, S_IRUSR | S_IWGRP | S_IRGRP)) {
+        if (0 != chmod(s->lockfile, S_IRUSR | S_IWGRP | S_IRGRP)) {
+            PMIX_RELEASE(s);
             PMIX_ERROR_LOG(PMIX_ERROR);
-            return PMIX_ERROR;
+            return NULL;
         }
     }
 
-    seg = _create_new_segment(INITIAL_SEGMENT, NULL, 0);
+    pmix_list_append(&_session_list, &s->super);
 
-    if (NULL == seg) {
+    return s;
+}
+
+/* Attach to the session the server created for the nspace. A missing
+ * lock file only means the server has no data of the nspace yet, so
+ * it is not an error. */
+static esh_session_t *_attach_session(const char *nspace)
+{
+    esh_session_t *s;
+
+    s = PMIX_NEW(esh_session_t);
+    strncpy(s->ns_name, nspace, sizeof(s->ns_name)-1);
+    if (0 > asprintf(&s->nspace_path, "%s/%s", _base_path, nspace)) {
+        PMIX_RELEASE(s);
         PMIX_ERROR_LOG(PMIX_ERROR);
+        return NULL;
+    }
+    /* the lock file prevents clients from reading while server is writing to the shared memory.
+    * This situation is quite often, especially in case of direct modex when clients might ask for data
+    * simultaneously.*/
+    if(0 > asprintf(&s->lockfile, "%s/%s_dstore_sm.lock",
+                    s->nspace_path, _unique_id())) {
+        PMIX_RELEASE(s);
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        return NULL;
+    }
+    s->lockfd = open(s->lockfile, O_RDONLY);
+
+    if (-1 == s->lockfd) {
+        PMIX_RELEASE(s);
+        return NULL;
+    }
+
+    s->sm_seg_first = _attach_new_segment(s, INITIAL_SEGMENT, NULL, 0);
+
+    if (NULL == s->sm_seg_first) {
+        PMIX_RELEASE(s);
+        return NULL;
+    }
+    s->sm_seg_last = s->sm_seg_first;
+    pmix_list_append(&_session_list, &s->super);
+
+    return s;
+}
+
+static esh_session_t *_find_session(const char *nspace)
+{
+    esh_session_t *s;
+
+    PMIX_LIST_FOREACH(s, &_session_list, esh_session_t) {
+        if (0 == strncmp(nspace, s->ns_name, PMIX_MAX_NSLEN+1)) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+static int _esh_nspace(const char *nspace)
+{
+    /* every nspace gets its own session, so the lock and
+     * the segments of different jobs don't interfere */
+    if (NULL != _find_session(nspace)) {
+        return PMIX_SUCCESS;
+    }
+    if (NULL == _create_session(nspace)) {
         return PMIX_ERROR;
     }
+    return PMIX_SUCCESS;
+}
+
+static int _esh_nspace_del(const char *nspace)
+{
+    esh_session_t *s;
+
+    PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
+                         "%s:%d:%s: for %s",
+                         __FILE__, __LINE__, __func__, nspace));
 
-    _global_sm_seg_first = seg;
-    _global_sm_seg_last = _global_sm_seg_first;
+    if (!_is_server()) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
 
+    if (NULL == (s = _find_session(nspace))) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    _report_session(s);
+    pmix_list_remove_item(&_session_list, &s->super);
+    /* The session holds the data of this nspace only, so its segments
+     * are unlinked right away. The local clients of the nspace are gone
+     * by the time it is deregistered, and those still attached keep
+     * their mappings until they detach, so the memory is reclaimed once
+     * the last one does. */
+    PMIX_RELEASE(s);
     return PMIX_SUCCESS;
 }
 
+/* Find the session holding the data of the nspace. The data of every
+ * nspace, including the remote ones, lives in a session of its own.
+ * The server creates it with the first store if create is set, a
+ * client attaches to it once the server has created it. */
+static esh_session_t *_get_session(const char *nspace, int create)
+{
+    esh_session_t *s;
+
+    if (NULL != (s = _find_session(nspace))) {
+        return s;
+    }
+    if (!_is_server()) {
+        return _attach_session(nspace);
+    }
+    if (create) {
+        return _create_session(nspace);
+    }
+    return NULL;
+}
+
 static void _set_constants_from_env()
 {
     char *str;
@@ -666,11 +1289,31 @@ static void _set_constants_from_env()
     if (0 == _data_segment_size) {
         _data_segment_size = NS_DATA_SEG_SIZE;
     }
+    if (NULL != (str = getenv(ESH_ENV_NS_DATA_COMPACT))) {
+        if (1 == strtoul(str, NULL, 10)) {
+            _data_layout = ESH_DATA_LAYOUT_COMPACT;
+        }
+    }
+    if (NULL != (str = getenv(ESH_ENV_NS_DATA_DEDUP))) {
+        if (1 == strtoul(str, NULL, 10)) {
+            _dedup = 1;
+        }
+    }
     if (NULL != (str = getenv(ESH_ENV_LINEAR))) {
         if (1 == strtoul(str, NULL, 10)) {
             _direct_mode = 1;
         }
     }
+    if (NULL != (str = getenv(ESH_ENV_KEY_INDEX))) {
+        if (0 == strtoul(str, NULL, 10)) {
+            _key_index = 0;
+        }
+    }
+    if (NULL != (str = getenv(ESH_ENV_FLOCK))) {
+        if (1 == strtoul(str, NULL, 10)) {
+            _lock_free = 0;
+        }
+    }
 }
 
 static void _delete_sm_desc(seg_desc_t *desc)
@@ -701,7 +1344,7 @@ static int _pmix_getpagesize(void)
 #endif
 }
 
-static seg_desc_t *_create_new_segment(segment_type type, char *nsname, uint32_t id)
+static seg_desc_t *_create_new_segment(esh_session_t *s, segment_type type, char *nsname, uint32_t id)
 {
     int rc;
     char file_name[PMIX_PATH_MAX];
@@ -715,15 +1358,15 @@ static seg_desc_t *_create_new_segment(segment_type type, char *nsname, uint32_t
     switch (type) {
         case INITIAL_SEGMENT:
             size = _initial_segment_size;
-            snprintf(file_name, PMIX_PATH_MAX, "%s/%s_initial-pmix_shared-segment-%u", _nspace_path, _unique_id(), id);
+            snprintf(file_name, PMIX_PATH_MAX, "%s/%s_initial-pmix_shared-segment-%u", s->nspace_path, _unique_id(), id);
             break;
         case NS_META_SEGMENT:
             size = _meta_segment_size;
-            snprintf(file_name, PMIX_PATH_MAX, "%s/%s_smseg-%s-%u", _nspace_path, _unique_id(), nsname, id);
+            snprintf(file_name, PMIX_PATH_MAX, "%s/%s_smseg-%s-%u", s->nspace_path, _unique_id(), nsname, id);
             break;
         case NS_DATA_SEGMENT:
             size = _data_segment_size;
-            snprintf(file_name, PMIX_PATH_MAX, "%s/%s_smdataseg-%s-%d", _nspace_path, _unique_id(), nsname, id);
+            snprintf(file_name, PMIX_PATH_MAX, "%s/%s_smdataseg-%s-%d", s->nspace_path, _unique_id(), nsname, id);
             break;
         default:
             PMIX_ERROR_LOG(PMIX_ERROR);
@@ -755,7 +1398,7 @@ static seg_desc_t *_create_new_segment(segment_type type, char *nsname, uint32_t
     return new_seg;
 }
 
-static seg_desc_t *_attach_new_segment(segment_type type, char *nsname, uint32_t id)
+static seg_desc_t *_attach_new_segment(esh_session_t *s, segment_type type, char *nsname, uint32_t id)
 {
     int rc;
     seg_desc_t *new_seg = NULL;
@@ -771,15 +1414,15 @@ static seg_desc_t *_attach_new_segment(segment_type type, char *nsname, uint32_t
     switch (type) {
         case INITIAL_SEGMENT:
             new_seg->seg_info.seg_size = _initial_segment_size;
-            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/%s_initial-pmix_shared-segment-%u", _nspace_path, _unique_id(), id);
+            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/%s_initial-pmix_shared-segment-%u", s->nspace_path, _unique_id(), id);
             break;
         case NS_META_SEGMENT:
             new_seg->seg_info.seg_size = _meta_segment_size;
-            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/%s_smseg-%s-%u", _nspace_path, _unique_id(), nsname, id);
+            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/%s_smseg-%s-%u", s->nspace_path, _unique_id(), nsname, id);
             break;
         case NS_DATA_SEGMENT:
             new_seg->seg_info.seg_size = _data_segment_size;
-            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/%s_smdataseg-%s-%d", _nspace_path, _unique_id(), nsname, id);
+            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/%s_smdataseg-%s-%d", s->nspace_path, _unique_id(), nsname, id);
             break;
         default:
             PMIX_ERROR_LOG(PMIX_ERROR);
@@ -814,9 +1457,9 @@ static int _update_ns_elem(ns_track_elem_t *ns_elem, ns_seg_info_t *info)
     /* synchronize number of meta segments for the target namespace. */
     for (i = ns_elem->num_meta_seg; i < info->num_meta_seg; i++) {
         if (_is_server()) {
-            seg = _create_new_segment(NS_META_SEGMENT, info->ns_name, i);
+            seg = _create_new_segment(ns_elem->session, NS_META_SEGMENT, info->ns_name, i);
         } else {
-            seg = _attach_new_segment(NS_META_SEGMENT, info->ns_name, i);
+            seg = _attach_new_segment(ns_elem->session, NS_META_SEGMENT, info->ns_name, i);
         }
         if (NULL == seg) {
             PMIX_ERROR_LOG(PMIX_ERROR);
@@ -840,13 +1483,13 @@ static int _update_ns_elem(ns_track_elem_t *ns_elem, ns_seg_info_t *info)
     /* synchronize number of data segments for the target namespace. */
     for (i = ns_elem->num_data_seg; i < info->num_data_seg; i++) {
         if (_is_server()) {
-            seg = _create_new_segment(NS_DATA_SEGMENT, info->ns_name, i);
+            seg = _create_new_segment(ns_elem->session, NS_DATA_SEGMENT, info->ns_name, i);
             if (seg) {
                 offs = sizeof(size_t);//shift on offset field itself
                 memcpy(seg->seg_info.seg_base_addr, &offs, sizeof(size_t));
             }
         } else {
-            seg = _attach_new_segment(NS_DATA_SEGMENT, info->ns_name, i);
+            seg = _attach_new_segment(ns_elem->session, NS_DATA_SEGMENT, info->ns_name, i);
         }
         if (NULL == seg) {
             PMIX_ERROR_LOG(PMIX_ERROR);
@@ -864,7 +1507,7 @@ static int _update_ns_elem(ns_track_elem_t *ns_elem, ns_seg_info_t *info)
     return PMIX_SUCCESS;
 }
 
-static seg_desc_t *extend_segment(seg_desc_t *segdesc, char *nspace)
+static seg_desc_t *extend_segment(esh_session_t *s, seg_desc_t *segdesc, char *nspace)
 {
     seg_desc_t *tmp, *seg;
 
@@ -877,7 +1520,7 @@ static seg_desc_t *extend_segment(seg_desc_t *segdesc, char *nspace)
         tmp = tmp->next;
     }
     /* create another segment, the old one is full. */
-    seg = _create_new_segment(segdesc->type, nspace, tmp->id + 1);
+    seg = _create_new_segment(s, segdesc->type, nspace, tmp->id + 1);
     if (NULL == seg) {
         PMIX_ERROR_LOG(PMIX_ERROR);
         return NULL;
@@ -888,43 +1531,43 @@ static seg_desc_t *extend_segment(seg_desc_t *segdesc, char *nspace)
     return seg;
 }
 
-static int _put_ns_info_to_initial_segment(const char *nspace, pmix_sm_seg_t *metaseg, pmix_sm_seg_t *dataseg)
+static int _put_ns_info_to_initial_segment(esh_session_t *s, const char *nspace, pmix_sm_seg_t *metaseg, pmix_sm_seg_t *dataseg)
 {
     ns_seg_info_t elem;
     size_t num_elems;
-    num_elems = *((size_t*)(_global_sm_seg_last->seg_info.seg_base_addr));
-    seg_desc_t *last_seg = _global_sm_seg_last;
+    num_elems = *((size_t*)(s->sm_seg_last->seg_info.seg_base_addr));
+    seg_desc_t *last_seg = s->sm_seg_last;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                          "%s:%d:%s", __FILE__, __LINE__, __func__));
 
     if (_max_ns_num == num_elems) {
-        if (NULL == (last_seg = extend_segment(last_seg, NULL))) {
+        if (NULL == (last_seg = extend_segment(s, last_seg, NULL))) {
             PMIX_ERROR_LOG(PMIX_ERROR);
             return PMIX_ERROR;
         }
         /* mark previous segment as full */
         int full = 1;
-        memcpy((uint8_t*)(_global_sm_seg_last->seg_info.seg_base_addr + sizeof(size_t)), &full, sizeof(int));
-        _global_sm_seg_last = last_seg;
-        memset(_global_sm_seg_last->seg_info.seg_base_addr, 0, _initial_segment_size);
+        memcpy((uint8_t*)(s->sm_seg_last->seg_info.seg_base_addr + sizeof(size_t)), &full, sizeof(int));
+        s->sm_seg_last = last_seg;
+        memset(s->sm_seg_last->seg_info.seg_base_addr, 0, _initial_segment_size);
     }
     memset(elem.ns_name, 0, sizeof(elem.ns_name));
     strncpy(elem.ns_name, nspace, sizeof(elem.ns_name)-1);
     elem.num_meta_seg = 1;
     elem.num_data_seg = 1;
-    memcpy((uint8_t*)(_global_sm_seg_last->seg_info.seg_base_addr) + sizeof(size_t) + sizeof(int) + num_elems * sizeof(ns_seg_info_t),
+    memcpy((uint8_t*)(s->sm_seg_last->seg_info.seg_base_addr) + sizeof(initial_seg_hdr_t) + num_elems * sizeof(ns_seg_info_t),
             &elem, sizeof(ns_seg_info_t));
     num_elems++;
-    memcpy((uint8_t*)(_global_sm_seg_last->seg_info.seg_base_addr), &num_elems, sizeof(size_t));
+    memcpy((uint8_t*)(s->sm_seg_last->seg_info.seg_base_addr), &num_elems, sizeof(size_t));
     return PMIX_SUCCESS;
 }
 
 /* clients should sync local info with information from initial segment regularly */
-static void _update_initial_segment_info(void)
+static void _update_initial_segment_info(esh_session_t *s)
 {
     seg_desc_t *tmp;
-    tmp = _global_sm_seg_first;
+    tmp = s->sm_seg_first;
 
     PMIX_OUTPUT_VERBOSE((2, pmix_globals.debug_output,
                          "%s:%d:%s", __FILE__, __LINE__, __func__));
@@ -933,7 +1576,7 @@ static void _update_initial_segment_info(void)
     do {
         /* check if current segment was marked as full but no more next segment is in the chain */
         if (NULL == tmp->next && 1 == *((int*)((uint8_t*)(tmp->seg_info.seg_base_addr) + sizeof(size_t)))) {
-            tmp->next = _attach_new_segment(INITIAL_SEGMENT, NULL, tmp->id+1);
+            tmp->next = _attach_new_segment(s, INITIAL_SEGMENT, NULL, tmp->id+1);
         }
         tmp = tmp->next;
     }
@@ -941,7 +1584,7 @@ static void _update_initial_segment_info(void)
 }
 
 /* this function will be used by clients to get ns data from the initial segment and add them to the tracker list */
-static ns_seg_info_t *_get_ns_info_from_initial_segment(const char *nspace)
+static ns_seg_info_t *_get_ns_info_from_initial_segment(esh_session_t *s, const char *nspace)
 {
     int rc;
     size_t i;
@@ -953,14 +1596,18 @@ static ns_seg_info_t *_get_ns_info_from_initial_segment(const char *nspace)
     PMIX_OUTPUT_VERBOSE((2, pmix_globals.debug_output,
                          "%s:%d:%s", __FILE__, __LINE__, __func__));
 
-    tmp = _global_sm_seg_first;
+    tmp = s->sm_seg_first;
 
     rc = 1;
     /* go through all global segments */
     do {
         num_elems = *((size_t*)(tmp->seg_info.seg_base_addr));
+        /* a lock-free reader may see a count that is being written */
+        if (_max_ns_num < num_elems) {
+            num_elems = _max_ns_num;
+        }
         for (i = 0; i < num_elems; i++) {
-            cur_elem = (ns_seg_info_t*)((uint8_t*)(tmp->seg_info.seg_base_addr) + sizeof(size_t) + sizeof(int) + i * sizeof(ns_seg_info_t));
+            cur_elem = (ns_seg_info_t*)((uint8_t*)(tmp->seg_info.seg_base_addr) + sizeof(initial_seg_hdr_t) + i * sizeof(ns_seg_info_t));
             if (0 == (rc = strncmp(cur_elem->ns_name, nspace, strlen(nspace)+1))) {
                 break;
             }
@@ -975,7 +1622,7 @@ static ns_seg_info_t *_get_ns_info_from_initial_segment(const char *nspace)
     return elem;
 }
 
-static ns_track_elem_t *_get_track_elem_for_namespace(const char *nspace)
+static ns_track_elem_t *_get_track_elem_for_namespace(esh_session_t *s, const char *nspace)
 {
     ns_track_elem_t *new_elem = NULL;
 
@@ -984,7 +1631,7 @@ static ns_track_elem_t *_get_track_elem_for_namespace(const char *nspace)
                          __FILE__, __LINE__, __func__, nspace));
 
     /* check if this namespace is already being tracked to avoid duplicating data. */
-    PMIX_LIST_FOREACH(new_elem, &_namespace_info_list, ns_track_elem_t) {
+    PMIX_LIST_FOREACH(new_elem, &s->ns_list, ns_track_elem_t) {
         if (0 == strncmp(nspace, new_elem->ns_name, PMIX_MAX_NSLEN+1)) {
             /* data for this namespace should be already stored in shared memory region. */
             /* so go and just put new data. */
@@ -1002,8 +1649,9 @@ static ns_track_elem_t *_get_track_elem_for_namespace(const char *nspace)
      * to operate with address and detach/unlink afterwards. */
     new_elem = PMIX_NEW(ns_track_elem_t);
     strncpy(new_elem->ns_name, nspace, sizeof(new_elem->ns_name)-1);
+    new_elem->session = s;
 
-    pmix_list_append(&_namespace_info_list, &new_elem->super);
+    pmix_list_append(&s->ns_list, &new_elem->super);
 
     return new_elem;
 }
@@ -1027,6 +1675,9 @@ static rank_meta_info *_get_rank_meta_info(pmix_rank_t rank, seg_desc_t *segdesc
         /* go through all existing meta segments for this namespace */
         do {
             num_elems = *((size_t*)(tmp->seg_info.seg_base_addr));
+            if (_max_meta_elems < num_elems) {
+                num_elems = _max_meta_elems;
+            }
             for (i = 0; i < num_elems; i++) {
                 cur_elem = (rank_meta_info*)((uint8_t*)(tmp->seg_info.seg_base_addr) + sizeof(size_t) + i * sizeof(rank_meta_info));
                 if (rank == cur_elem->rank) {
@@ -1040,8 +1691,8 @@ static rank_meta_info *_get_rank_meta_info(pmix_rank_t rank, seg_desc_t *segdesc
     } else {
         /* directly compute index of meta segment (id) and relative offset (rel_offset)
          * inside this segment for fast lookup a rank_meta_info object for the requested rank. */
-        id = rank/_max_meta_elems;
-        rel_offset = (rank%_max_meta_elems) * sizeof(rank_meta_info) + sizeof(size_t);
+        id = _rank_meta_idx(rank)/_max_meta_elems;
+        rel_offset = (_rank_meta_idx(rank)%_max_meta_elems) * sizeof(rank_meta_info) + sizeof(size_t);
         /* go through all existing meta segments for this namespace.
          * Stop at id number if it exists. */
         while (NULL != tmp->next && 0 != id) {
@@ -1090,7 +1741,7 @@ static int set_rank_meta_info(ns_track_elem_t *ns_info, rank_meta_info *rinfo)
                         "%s:%d:%s: extend meta segment for nspace %s",
                         __FILE__, __LINE__, __func__, ns_info->ns_name));
             /* extend meta segment, so create a new one */
-            tmp = extend_segment(tmp, ns_info->ns_name);
+            tmp = extend_segment(ns_info->session, tmp, ns_info->ns_name);
             if (NULL == tmp) {
                 PMIX_ERROR_LOG(PMIX_ERROR);
                 return PMIX_ERROR;
@@ -1098,7 +1749,7 @@ static int set_rank_meta_info(ns_track_elem_t *ns_info, rank_meta_info *rinfo)
             ns_info->num_meta_seg++;
             memset(tmp->seg_info.seg_base_addr, 0, sizeof(rank_meta_info));
             /* update number of meta segments for namespace in initial_segment */
-            ns_seg_info_t *elem = _get_ns_info_from_initial_segment(ns_info->ns_name);
+            ns_seg_info_t *elem = _get_ns_info_from_initial_segment(ns_info->session, ns_info->ns_name);
             if (NULL == elem) {
                 PMIX_ERROR_LOG(PMIX_ERROR);
                 return PMIX_ERROR;
@@ -1115,8 +1766,8 @@ static int set_rank_meta_info(ns_track_elem_t *ns_info, rank_meta_info *rinfo)
     } else {
         /* directly compute index of meta segment (id) and relative offset (rel_offset)
          * inside this segment for fast lookup a rank_meta_info object for the requested rank. */
-        id = rinfo->rank/_max_meta_elems;
-        rel_offset = (rinfo->rank % _max_meta_elems) * sizeof(rank_meta_info) + sizeof(size_t);
+        id = _rank_meta_idx(rinfo->rank)/_max_meta_elems;
+        rel_offset = (_rank_meta_idx(rinfo->rank) % _max_meta_elems) * sizeof(rank_meta_info) + sizeof(size_t);
         count = id;
         /* go through all existing meta segments for this namespace.
          * Stop at id number if it exists. */
@@ -1128,7 +1779,7 @@ static int set_rank_meta_info(ns_track_elem_t *ns_info, rank_meta_info *rinfo)
         if ((int)ns_info->num_meta_seg < (id+1)) {
             while ((int)ns_info->num_meta_seg != (id+1)) {
                 /* extend meta segment, so create a new one */
-                tmp = extend_segment(tmp, ns_info->ns_name);
+                tmp = extend_segment(ns_info->session, tmp, ns_info->ns_name);
                 if (NULL == tmp) {
                     PMIX_ERROR_LOG(PMIX_ERROR);
                     return PMIX_ERROR;
@@ -1137,7 +1788,7 @@ static int set_rank_meta_info(ns_track_elem_t *ns_info, rank_meta_info *rinfo)
                 ns_info->num_meta_seg++;
             }
             /* update number of meta segments for namespace in initial_segment */
-            ns_seg_info_t *elem = _get_ns_info_from_initial_segment(ns_info->ns_name);
+            ns_seg_info_t *elem = _get_ns_info_from_initial_segment(ns_info->session, ns_info->ns_name);
             if (NULL == elem) {
                 PMIX_ERROR_LOG(PMIX_ERROR);
                 return PMIX_ERROR;
@@ -1197,7 +1848,7 @@ static size_t get_free_offset(seg_desc_t *data_seg)
 
 static int put_empty_ext_slot(seg_desc_t *dataseg)
 {
-    size_t global_offset, rel_offset, data_ended, sz, val;
+    size_t global_offset, rel_offset, data_ended, val;
     uint8_t *addr;
     global_offset = get_free_offset(dataseg);
     rel_offset = global_offset % _data_segment_size;
@@ -1205,11 +1856,8 @@ static int put_empty_ext_slot(seg_desc_t *dataseg)
         return PMIX_ERROR;
     }
     addr = _get_data_region_by_offset(dataseg, global_offset);
-    strncpy((char *)addr, ESH_REGION_EXTENSION, PMIX_MAX_KEYLEN+1);
     val = 0;
-    sz = sizeof(size_t);
-    memcpy(addr + PMIX_MAX_KEYLEN + 1, &sz, sz);
-    memcpy(addr + PMIX_MAX_KEYLEN + 1 + sizeof(size_t), &val, sz);
+    _rec_write(addr, ESH_REGION_EXTENSION, &val, sizeof(size_t));
 
     /* update offset at the beginning of current segment */
     data_ended = rel_offset + EXT_SLOT_SIZE;
@@ -1218,14 +1866,65 @@ static int put_empty_ext_slot(seg_desc_t *dataseg)
     return PMIX_SUCCESS;
 }
 
-static size_t put_data_to_the_end(ns_track_elem_t *ns_info, seg_desc_t *dataseg, char *key, void *buffer, size_t size)
+/* look for a record holding the same value in the last data segment
+ * and put a record referring to it to the end of that segment. Returns
+ * the offset of the new record, 0 if the value has to be stored */
+static size_t put_shared_to_the_end(ns_track_elem_t *ns_info, seg_desc_t *tmp, int id, size_t offset,
+                                    char *key, void *buffer, size_t size)
+{
+    size_t rec_offset, shared_size, data_ended;
+    uint8_t *base, *addr, *orig;
+    void *ptr = NULL;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(ns_info->interned, buffer, size, &ptr)) {
+        return 0;
+    }
+    rec_offset = (size_t)(uintptr_t)ptr;
+    if (rec_offset / _data_segment_size != (size_t)id) {
+        /* the copy is in an earlier segment */
+        return 0;
+    }
+    base = (uint8_t*)tmp->seg_info.seg_base_addr;
+    shared_size = sizeof(esh_rec_hdr_t) + _align8(strnlen(key, PMIX_MAX_KEYLEN) + 1) + sizeof(size_t);
+    if (offset + shared_size + EXT_SLOT_SIZE > _data_segment_size) {
+        return 0;
+    }
+    orig = base + rec_offset % _data_segment_size;
+    addr = base + offset;
+    _rec_write_shared(addr, key, size, (size_t)(addr - _rec_data(orig)));
+    ((esh_rec_hdr_t*)orig)->flags |= ESH_REC_REFERENCED;
+    ns_info->nshared++;
+    ns_info->shared_bytes += _rec_size(key, size) - shared_size;
+
+    /* update offset at the beginning of current segment */
+    data_ended = offset + shared_size;
+    memcpy(base, &data_ended, sizeof(size_t));
+    return offset + id * _data_segment_size;
+}
+
+/* the record is about to be overwritten in place, so it must no
+ * longer be offered as the copy of the value it holds */
+static void _forget_value(ns_track_elem_t *ns_info, uint8_t *addr)
+{
+    void *ptr = NULL;
+
+    if (NULL == ns_info->interned) {
+        return;
+    }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(ns_info->interned, _rec_data(addr),
+                                                      _rec_data_size(addr), &ptr) &&
+        addr == _get_data_region_by_offset(ns_info->data_seg, (size_t)(uintptr_t)ptr)) {
+        pmix_hash_table_remove_value_ptr(ns_info->interned, _rec_data(addr), _rec_data_size(addr));
+    }
+}
+
+static size_t put_data_to_the_end(ns_track_elem_t *ns_info, seg_desc_t *dataseg, char *key, void *buffer, size_t size, int intern)
 {
     size_t offset;
     seg_desc_t *tmp;
     int id = 0;
     size_t global_offset, data_ended;
     uint8_t *addr;
-    size_t sz;
 
     PMIX_OUTPUT_VERBOSE((2, pmix_globals.debug_output,
                          "%s:%d:%s: key %s",
@@ -1239,19 +1938,33 @@ static size_t put_data_to_the_end(ns_track_elem_t *ns_info, seg_desc_t *dataseg,
     global_offset = get_free_offset(dataseg);
     offset = global_offset % _data_segment_size;
 
+    /* only values are shared */
+    if (intern && _dedup && ESH_DATA_LAYOUT_COMPACT == _data_layout &&
+        ESH_DEDUP_MIN_SIZE <= size && ESH_DEDUP_MAX_SIZE >= size) {
+        if (NULL == ns_info->interned) {
+            ns_info->interned = PMIX_NEW(pmix_hash_table_t);
+            pmix_hash_table_init(ns_info->interned, 256);
+        }
+        if (0 != (global_offset = put_shared_to_the_end(ns_info, tmp, id, offset, key, buffer, size))) {
+            return global_offset;
+        }
+    } else {
+        intern = 0;
+    }
+
     /* We should provide additional space at the end of segment to place EXTENSION_SLOT to have an ability to enlarge data for this rank.*/
-    if (sizeof(size_t) + KVAL_SIZE(size) + EXT_SLOT_SIZE > _data_segment_size) {
+    if (sizeof(size_t) + _rec_size(key, size) + EXT_SLOT_SIZE > _data_segment_size) {
         /* this is an error case: segment is so small that cannot place evem a single key-value pair.
          * warn a user about it and fail. */
         offset = 0; /* offset cannot be 0 in normal case, so we use this value to indicate a problem. */
         pmix_output(0, "PLEASE set NS_DATA_SEG_SIZE to value which is larger when %lu.",
-                sizeof(size_t) + PMIX_MAX_KEYLEN + 1 + sizeof(size_t) + size + EXT_SLOT_SIZE);
+                sizeof(size_t) + _rec_size(key, size) + EXT_SLOT_SIZE);
         return offset;
     }
-    if (offset + KVAL_SIZE(size) + EXT_SLOT_SIZE > _data_segment_size)  {
+    if (offset + _rec_size(key, size) + EXT_SLOT_SIZE > _data_segment_size)  {
         id++;
         /* create a new data segment. */
-        tmp = extend_segment(tmp, ns_info->ns_name);
+        tmp = extend_segment(ns_info->session, tmp, ns_info->ns_name);
         if (NULL == tmp) {
             PMIX_ERROR_LOG(PMIX_ERROR);
             offset = 0; /* offset cannot be 0 in normal case, so we use this value to indicate a problem. */
@@ -1259,7 +1972,7 @@ static size_t put_data_to_the_end(ns_track_elem_t *ns_info, seg_desc_t *dataseg,
         }
         ns_info->num_data_seg++;
         /* update_ns_info_in_initial_segment */
-        ns_seg_info_t *elem = _get_ns_info_from_initial_segment(ns_info->ns_name);
+        ns_seg_info_t *elem = _get_ns_info_from_initial_segment(ns_info->session, ns_info->ns_name);
         if (NULL == elem) {
             PMIX_ERROR_LOG(PMIX_ERROR);
             return PMIX_ERROR;
@@ -1270,13 +1983,15 @@ static size_t put_data_to_the_end(ns_track_elem_t *ns_info, seg_desc_t *dataseg,
     }
     global_offset = offset + id * _data_segment_size;
     addr = (uint8_t*)(tmp->seg_info.seg_base_addr)+offset;
-    strncpy((char *)addr, key, PMIX_MAX_KEYLEN+1);
-    sz = size;
-    memcpy(addr + PMIX_MAX_KEYLEN + 1, &sz, sizeof(size_t));
-    memcpy(addr + PMIX_MAX_KEYLEN + 1 + sizeof(size_t), buffer, size);
+    _rec_write(addr, key, buffer, size);
+    if (intern) {
+        /* this is the copy of the value to refer to from now on */
+        pmix_hash_table_set_value_ptr(ns_info->interned, buffer, size,
+                                      (void*)(uintptr_t)global_offset);
+    }
 
     /* update offset at the beginning of current segment */
-    data_ended = offset + KVAL_SIZE(size);
+    data_ended = offset + _rec_size(key, size);
     addr = (uint8_t*)(tmp->seg_info.seg_base_addr);
     memcpy(addr, &data_ended, sizeof(size_t));
     PMIX_OUTPUT_VERBOSE((2, pmix_globals.debug_output,
@@ -1300,7 +2015,7 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
     datadesc = ns_info->data_seg;
     /* pack value to the buffer */
     buffer = PMIX_NEW(pmix_buffer_t);
-    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(buffer, kval->value, 1, PMIX_VALUE))) {
+    if (PMIX_SUCCESS != (rc = _encode_value(kval->value, buffer))) {
         PMIX_RELEASE(buffer);
         PMIX_ERROR_LOG(rc);
         return rc;
@@ -1311,7 +2026,7 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
         /* there is no data blob for this rank yet, so add it. */
         size_t free_offset;
         free_offset = get_free_offset(datadesc);
-        offset = put_data_to_the_end(ns_info, datadesc, kval->key, buffer->base_ptr, size);
+        offset = put_data_to_the_end(ns_info, datadesc, kval->key, buffer->base_ptr, size, 1);
         if (0 == offset) {
             /* this is an error */
             PMIX_RELEASE(buffer);
@@ -1328,17 +2043,15 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
              * It should be equal in the normal case. It it's not true, then it means that
              * segment was extended, and we put data to the next segment, so we now need to
              * put extension slot at the end of previous segment with a "reference" to a new_offset */
-            size_t sz = sizeof(size_t);
             addr = _get_data_region_by_offset(datadesc, free_offset);
-            strncpy((char *)addr, ESH_REGION_EXTENSION, PMIX_MAX_KEYLEN+1);
-            memcpy(addr + PMIX_MAX_KEYLEN + 1, &sz, sizeof(size_t));
-            memcpy(addr + PMIX_MAX_KEYLEN + 1 + sizeof(size_t), &offset, sizeof(size_t));
+            _rec_write(addr, ESH_REGION_EXTENSION, &offset, sizeof(size_t));
         }
         if (NULL == *rinfo) {
             *rinfo = (rank_meta_info*)malloc(sizeof(rank_meta_info));
             (*rinfo)->rank = rank;
             (*rinfo)->offset = offset;
             (*rinfo)->count = 0;
+            (*rinfo)->idx_offset = 0;
         }
         (*rinfo)->count++;
     } else if (NULL != *rinfo) {
@@ -1365,8 +2078,8 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
              * .....
              * extension slot which has key = EXTENSION_SLOT and a size_t value for offset to next data address for this process.
              */
-            if (0 == strncmp((const char *)addr, ESH_REGION_EXTENSION, PMIX_MAX_KEYLEN+1)) {
-                offset = *(size_t *)(addr + PMIX_MAX_KEYLEN + 1 + sizeof(size_t));
+            if (_rec_is(addr, ESH_REGION_EXTENSION)) {
+                offset = *(size_t *)_rec_data(addr);
                 if (0 < offset) {
                     PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                                 "%s:%d:%s: for rank %u, replace flag %d %s is filled with %lu value",
@@ -1381,21 +2094,27 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
                 } else {
                     /* should not be, we should be out of cycle when this happens */
                 }
-            } else if (0 == strncmp((const char *)addr, kval->key, PMIX_MAX_KEYLEN+1)) {
+            } else if (_rec_is(addr, kval->key)) {
                 PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                             "%s:%d:%s: for rank %u, replace flag %d found target key %s",
                             __FILE__, __LINE__, __func__, rank, data_exist, kval->key));
                 /* target key is found, compare value sizes */
-                size_t cur_size = *(size_t *)(addr + PMIX_MAX_KEYLEN + 1);
-                if (cur_size != size) {
+                size_t cur_size = _rec_data_size(addr);
+                if (cur_size == size && 0 == memcmp(_rec_data(addr), buffer->base_ptr, size)) {
+                    /* the same value is stored again, e.g. with the whole blob
+                     * of the rank, so leave the record alone */
+                    add_to_the_end = 0;
+                    break;
+                }
+                if (cur_size != size || _rec_is_shared(addr) || _rec_is_borrowable(addr)) {
                 //if (1) { /* if we want to test replacing values for existing keys. */
                     /* invalidate current value and store another one at the end of data region. */
-                    strncpy((char *)addr, ESH_REGION_INVALIDATED, PMIX_MAX_KEYLEN+1);
+                    _rec_invalidate(addr);
                     /* decrementing count, it will be incremented back when we add a new value for this key at the end of region. */
                     (*rinfo)->count--;
                     kval_cnt--;
                     /* go to next item, updating address */
-                    addr += KVAL_SIZE(cur_size);
+                    addr += _rec_total_size(addr);
                     PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                                 "%s:%d:%s: for rank %u, replace flag %d mark key %s regions as invalidated. put new data at the end.",
                                 __FILE__, __LINE__, __func__, rank, data_exist, kval->key));
@@ -1404,29 +2123,25 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
                                 "%s:%d:%s: for rank %u, replace flag %d replace data for key %s type %d in place",
                                 __FILE__, __LINE__, __func__, rank, data_exist, kval->key, kval->value->type));
                     /* replace old data with new one. */
-                    addr += PMIX_MAX_KEYLEN + 1;
-                    memcpy(addr, &size, sizeof(size_t));
-                    addr += sizeof(size_t);
-                    memset(addr, 0, cur_size);
-                    memcpy(addr, buffer->base_ptr, size);
-                    addr += cur_size;
+                    _forget_value(ns_info, addr);
+                    _rec_write(addr, kval->key, buffer->base_ptr, size);
+                    addr += _rec_total_size(addr);
                     add_to_the_end = 0;
                     break;
                 }
             } else {
                 char ckey[PMIX_MAX_KEYLEN+1] = {0};
-                strncpy(ckey, (const char *)addr, PMIX_MAX_KEYLEN+1);
+                strncpy(ckey, _rec_key(addr), PMIX_MAX_KEYLEN);
                 PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                             "%s:%d:%s: for rank %u, replace flag %d skip %s key, look for %s key",
                             __FILE__, __LINE__, __func__, rank, data_exist, ckey, kval->key));
                 /* Skip it: key is "INVALIDATED" or key is valid but different from target one. */
-                if (0 != strncmp(ESH_REGION_INVALIDATED, ckey, PMIX_MAX_KEYLEN+1)) {
+                if (!_rec_is(addr, ESH_REGION_INVALIDATED)) {
                     /* count only valid items */
                     kval_cnt--;
                 }
-                size_t size = *(size_t *)(addr + PMIX_MAX_KEYLEN + 1);
                 /* go to next item, updating address */
-                addr += KVAL_SIZE(size);
+                addr += _rec_total_size(addr);
             }
         }
         if (1 == add_to_the_end) {
@@ -1437,7 +2152,7 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
             size_t free_offset;
             free_offset = get_free_offset(datadesc);
             /* add to the end */
-            offset = put_data_to_the_end(ns_info, datadesc, kval->key, buffer->base_ptr, size);
+            offset = put_data_to_the_end(ns_info, datadesc, kval->key, buffer->base_ptr, size, 1);
             if (0 == offset) {
                 PMIX_RELEASE(buffer);
                 PMIX_ERROR_LOG(PMIX_ERROR);
@@ -1448,11 +2163,11 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
              * data for different ranks, and that's why next element is EXTENSION_SLOT.
              * We put new data to the end of data region and just update EXTENSION_SLOT value by new offset.
              */
-            if (0 == strncmp((const char *)addr, ESH_REGION_EXTENSION, PMIX_MAX_KEYLEN+1)) {
+            if (_rec_is(addr, ESH_REGION_EXTENSION)) {
                 PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
                             "%s:%d:%s: for rank %u, replace flag %d %s should be filled with offset %lu value",
                             __FILE__, __LINE__, __func__, rank, data_exist, ESH_REGION_EXTENSION, offset));
-                memcpy(addr + PMIX_MAX_KEYLEN + 1 + sizeof(size_t), &offset, sizeof(size_t));
+                memcpy(_rec_data(addr), &offset, sizeof(size_t));
             } else {
                 /* (2) - we point to the first free offset, no more data is stored further in this segment.
                  * There is no EXTENSION_SLOT by this addr since we continue pushing data for the same rank,
@@ -1462,10 +2177,7 @@ static int pmix_sm_store(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix_kval_t
                  * forcibly and store new offset in its value. */
                 if (free_offset != offset) {
                     /* segment was extended, need to put extension slot by free_offset indicating new_offset */
-                    size_t sz = sizeof(size_t);
-                    strncpy((char *)addr, ESH_REGION_EXTENSION, PMIX_MAX_KEYLEN+1);
-                    memcpy(addr + PMIX_MAX_KEYLEN + 1, &sz, sz);
-                    memcpy(addr + PMIX_MAX_KEYLEN + 1 + sizeof(size_t), &offset, sz);
+                    _rec_write(addr, ESH_REGION_EXTENSION, &offset, sizeof(size_t));
                 }
             }
             PMIX_OUTPUT_VERBOSE((10, pmix_globals.debug_output,
@@ -1568,6 +2280,19 @@ static int _store_data_for_rank(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix
             PMIX_ERROR_LOG(rc);
             return rc;
         }
+        /* new records were added, so refresh the key index of this
+         * rank. It is placed behind the EXTENSION_SLOT, thus it is not
+         * a part of the data chain of the rank. */
+        if (1 == _key_index && NULL != rinfo) {
+            rc = _build_rank_index(ns_info, rinfo);
+            if (PMIX_SUCCESS != rc) {
+                if (0 == data_exist) {
+                    free(rinfo);
+                }
+                PMIX_ERROR_LOG(rc);
+                return rc;
+            }
+        }
     }
 
     /* if this is the first data posted for this rank, then
@@ -1582,25 +2307,379 @@ static int _store_data_for_rank(ns_track_elem_t *ns_info, pmix_rank_t rank, pmix
     return rc;
 }
 
+/* size of the natively stored value of the type, 0 if values of
+ * the type are not stored natively */
+static inline size_t _native_size(pmix_data_type_t type)
+{
+    switch (type) {
+        case PMIX_BOOL:
+            return sizeof(bool);
+        case PMIX_BYTE:
+        case PMIX_INT8:
+        case PMIX_UINT8:
+            return sizeof(uint8_t);
+        case PMIX_INT16:
+        case PMIX_UINT16:
+            return sizeof(uint16_t);
+        case PMIX_INT:
+        case PMIX_UINT:
+            return sizeof(int);
+        case PMIX_INT32:
+        case PMIX_UINT32:
+            return sizeof(uint32_t);
+        case PMIX_INT64:
+        case PMIX_UINT64:
+            return sizeof(uint64_t);
+        case PMIX_SIZE:
+            return sizeof(size_t);
+        case PMIX_PID:
+            return sizeof(pid_t);
+        case PMIX_FLOAT:
+            return sizeof(float);
+        case PMIX_DOUBLE:
+            return sizeof(double);
+        case PMIX_TIMEVAL:
+            return sizeof(struct timeval);
+        case PMIX_TIME:
+            return sizeof(time_t);
+        case PMIX_STATUS:
+            return sizeof(pmix_status_t);
+        case PMIX_PROC_RANK:
+            return sizeof(pmix_rank_t);
+        default:
+            return 0;
+    }
+}
+
+/* Put the value into the buffer in the format of the data segments */
+static int _encode_value(pmix_value_t *val, pmix_buffer_t *buffer)
+{
+    pmix_buffer_t packed;
+    size_t type, size;
+    const void *src;
+    uint8_t *data;
+    int rc;
+
+    if (ESH_DATA_LAYOUT_COMPACT != _data_layout) {
+        return pmix_bfrop.pack(buffer, val, 1, PMIX_VALUE);
+    }
+
+    PMIX_CONSTRUCT(&packed, pmix_buffer_t);
+    type = val->type;
+    if (PMIX_STRING == val->type && NULL != val->data.string) {
+        src = val->data.string;
+        size = strlen(val->data.string) + 1;
+    } else if (PMIX_BYTE_OBJECT == val->type) {
+        src = val->data.bo.bytes;
+        size = val->data.bo.size;
+    } else if (0 < (size = _native_size(val->type))) {
+        src = &val->data;
+    } else {
+        /* store everything else packed */
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&packed, val, 1, PMIX_VALUE))) {
+            PMIX_DESTRUCT(&packed);
+            return rc;
+        }
+        type = PMIX_VALUE;
+        src = packed.base_ptr;
+        size = packed.bytes_used;
+    }
+
+    data = (uint8_t*)malloc(ESH_VAL_HDR_SIZE + size);
+    if (NULL == data) {
+        PMIX_DESTRUCT(&packed);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy(data, &type, ESH_VAL_HDR_SIZE);
+    if (0 < size) {
+        memcpy(data + ESH_VAL_HDR_SIZE, src, size);
+    }
+    size += ESH_VAL_HDR_SIZE;
+    PMIX_LOAD_BUFFER(buffer, data, size);
+    PMIX_DESTRUCT(&packed);
+    return PMIX_SUCCESS;
+}
+
+/* Create the value from its native copy in the data segment. If
+ * borrow is set, the bytes of a byte object are left in place. */
+static int _decode_native(pmix_data_type_t type, uint8_t *addr, size_t size, pmix_value_t **kvs, int borrow)
+{
+    pmix_value_t *val;
+
+    PMIX_VALUE_CREATE(val, 1);
+    if (NULL == val) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    val->type = type;
+    if (PMIX_STRING == type) {
+        val->data.string = strndup((const char *)addr, size);
+    } else if (PMIX_BYTE_OBJECT == type && borrow) {
+        val->data.bo.bytes = (char*)addr;
+        val->data.bo.size = size;
+    } else if (PMIX_BYTE_OBJECT == type) {
+        if (0 < size) {
+            val->data.bo.bytes = (char*)malloc(size);
+            if (NULL == val->data.bo.bytes) {
+                PMIX_VALUE_RELEASE(val);
+                return PMIX_ERR_OUT_OF_RESOURCE;
+            }
+            memcpy(val->data.bo.bytes, addr, size);
+        }
+        val->data.bo.size = size;
+    } else if (size == _native_size(type)) {
+        memcpy(&val->data, addr, size);
+    } else {
+        PMIX_VALUE_RELEASE(val);
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    *kvs = val;
+    return PMIX_SUCCESS;
+}
+
+/* release the value returned by _fetch without touching the
+ * borrowed bytes */
+static void _release_value(pmix_value_t *val, int borrow)
+{
+    if (borrow && PMIX_BYTE_OBJECT == val->type && _esh_is_mapped(val->data.bo.bytes)) {
+        val->data.bo.bytes = NULL;
+        val->data.bo.size = 0;
+    }
+    PMIX_VALUE_RELEASE(val);
+}
+
+static int _unpack_value(uint8_t *addr, pmix_value_t **kvs, int borrow)
+{
+    pmix_buffer_t buffer;
+    pmix_value_t val;
+    int rc, cnt = 1;
+    size_t size = _rec_data_size(addr);
+
+    addr = _rec_data(addr);
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        size_t type;
+        if (ESH_VAL_HDR_SIZE > size) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        memcpy(&type, addr, ESH_VAL_HDR_SIZE);
+        addr += ESH_VAL_HDR_SIZE;
+        size -= ESH_VAL_HDR_SIZE;
+        if (PMIX_VALUE != type) {
+            /* no need to unpack and copy it */
+            return _decode_native((pmix_data_type_t)type, addr, size, kvs, borrow);
+        }
+    }
+    PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(&buffer, addr, size);
+    /* unpack value for this key from the buffer. */
+    PMIX_VALUE_CONSTRUCT(&val);
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buffer, &val, &cnt, PMIX_VALUE))) {
+        PMIX_ERROR_LOG(rc);
+    } else if (PMIX_SUCCESS != (rc = pmix_bfrop.copy((void**)kvs, &val, PMIX_VALUE))) {
+        PMIX_ERROR_LOG(rc);
+    }
+    PMIX_VALUE_DESTRUCT(&val);
+    buffer.base_ptr = NULL;
+    buffer.bytes_used = 0;
+    PMIX_DESTRUCT(&buffer);
+    return rc;
+}
+
+static inline uint32_t _key_hash(const char *key)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < PMIX_MAX_KEYLEN && '\0' != key[i]; i++) {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* The index is stored as a data record with the INDEX_SLOT key:
+ * size_t capacity
+ * rank_key_idx_t[capacity] - open-addressed table with linear probing,
+ * an entry with zero offset is empty.
+ */
+static int _build_rank_index(ns_track_elem_t *ns_info, rank_meta_info *rinfo)
+{
+    seg_desc_t *datadesc = ns_info->data_seg;
+    size_t cap, size, cur_size, offset, kval_cnt, i;
+    rank_key_idx_t *table;
+    uint8_t *addr, *payload;
+    uint32_t hash;
+
+    /* keep the load factor at or below one half */
+    cap = 8;
+    while (cap < 2 * rinfo->count) {
+        cap <<= 1;
+    }
+    size = sizeof(size_t) + cap * sizeof(rank_key_idx_t);
+    payload = (uint8_t*)calloc(1, size);
+    if (NULL == payload) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy(payload, &cap, sizeof(size_t));
+    table = (rank_key_idx_t*)(payload + sizeof(size_t));
+
+    /* walk the records of this rank the same way the fetch does */
+    offset = rinfo->offset;
+    addr = _get_data_region_by_offset(datadesc, offset);
+    kval_cnt = rinfo->count;
+    while (0 < kval_cnt && NULL != addr) {
+        if (_rec_is(addr, ESH_REGION_EXTENSION)) {
+            offset = *(size_t *)_rec_data(addr);
+            if (0 == offset) {
+                break;
+            }
+            addr = _get_data_region_by_offset(datadesc, offset);
+            continue;
+        }
+        cur_size = _rec_total_size(addr);
+        if (!_rec_is(addr, ESH_REGION_INVALIDATED)) {
+            hash = _key_hash(_rec_key(addr));
+            i = hash & (cap - 1);
+            while (0 != table[i].offset) {
+                i = (i + 1) & (cap - 1);
+            }
+            table[i].hash = hash;
+            table[i].offset = offset;
+            kval_cnt--;
+        }
+        offset += cur_size;
+        addr += cur_size;
+    }
+
+    /* reuse the previous index of this rank if it is large enough */
+    if (0 != rinfo->idx_offset) {
+        addr = _get_data_region_by_offset(datadesc, rinfo->idx_offset);
+        if (NULL != addr && _rec_data_size(addr) >= size) {
+            memcpy(_rec_data(addr), payload, size);
+            free(payload);
+            return PMIX_SUCCESS;
+        }
+    }
+    offset = put_data_to_the_end(ns_info, datadesc, ESH_REGION_INDEX, payload, size, 0);
+    free(payload);
+    if (0 == offset) {
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        return PMIX_ERROR;
+    }
+    rinfo->idx_offset = offset;
+    return PMIX_SUCCESS;
+}
+
+static uint8_t *_lookup_rank_index(seg_desc_t *data_seg, rank_meta_info *rinfo, const char *key)
+{
+    rank_key_idx_t *table;
+    uint8_t *addr;
+    size_t cap, i, n;
+    uint32_t hash;
+
+    addr = _get_data_region_by_offset(data_seg, rinfo->idx_offset);
+    if (NULL == addr || !_rec_is_valid(data_seg, addr)) {
+        return NULL;
+    }
+    addr = _rec_data(addr);
+    cap = *(size_t *)addr;
+    /* the index may be rebuilt while a lock-free reader probes it */
+    if (0 == cap || 0 != (cap & (cap - 1)) ||
+        !_region_is_valid(data_seg, addr, sizeof(size_t) + cap * sizeof(rank_key_idx_t))) {
+        return NULL;
+    }
+    table = (rank_key_idx_t*)(addr + sizeof(size_t));
+
+    hash = _key_hash(key);
+    i = hash & (cap - 1);
+    for (n = 0; n < cap && 0 != table[i].offset; n++) {
+        if (hash == table[i].hash) {
+            addr = _get_data_region_by_offset(data_seg, table[i].offset);
+            if (NULL != addr && _rec_is_valid(data_seg, addr) && _rec_is(addr, key)) {
+                return addr;
+            }
+        }
+        i = (i + 1) & (cap - 1);
+    }
+    return NULL;
+}
+
+/* check that the region lies within one of the data segments */
+static inline int _region_is_valid(seg_desc_t *data_seg, uint8_t *addr, size_t size)
+{
+    seg_desc_t *tmp;
+
+    for (tmp = data_seg; NULL != tmp; tmp = tmp->next) {
+        uint8_t *base = (uint8_t*)tmp->seg_info.seg_base_addr;
+        if (addr >= base && addr < base + _data_segment_size) {
+            return (size <= (size_t)(base + _data_segment_size - addr));
+        }
+    }
+    return 0;
+}
+
+/* check that the record header is sane and the whole record lies
+ * within one data segment */
+static inline int _rec_is_valid(seg_desc_t *data_seg, uint8_t *addr)
+{
+    size_t hdr_size;
+
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout) {
+        hdr_size = sizeof(esh_rec_hdr_t);
+    } else {
+        hdr_size = PMIX_MAX_KEYLEN + 1 + sizeof(size_t);
+    }
+    if (!_region_is_valid(data_seg, addr, hdr_size)) {
+        return 0;
+    }
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout &&
+        PMIX_MAX_KEYLEN + 1 < ((esh_rec_hdr_t*)addr)->keylen) {
+        return 0;
+    }
+    if (_data_segment_size < _rec_data_size(addr)) {
+        return 0;
+    }
+    if (!_region_is_valid(data_seg, addr, _rec_total_size(addr))) {
+        return 0;
+    }
+    /* the value of a shared record has to precede it */
+    if (ESH_DATA_LAYOUT_COMPACT == _data_layout &&
+        (((esh_rec_hdr_t*)addr)->flags & ESH_REC_SHARED)) {
+        return (_rec_data(addr) < addr &&
+                _region_is_valid(data_seg, _rec_data(addr), _rec_data_size(addr)));
+    }
+    return 1;
+}
+
+/* the job-level data is stored under the wildcard rank, so reserve
+ * the first meta slot for it and shift the real ranks by one */
+static inline size_t _rank_meta_idx(pmix_rank_t rank)
+{
+    if (PMIX_RANK_WILDCARD == rank) {
+        return 0;
+    }
+    return (size_t)rank + 1;
+}
+
 static inline uint32_t _get_univ_size(const char *nspace)
 {
     pmix_value_t *val = NULL;
     uint32_t nprocs = 0;
-    pmix_nspace_t *ns, *nptr;
+    pmix_nspace_t *nptr;
 
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(nspace);
 
     if (nptr && (PMIX_SUCCESS == pmix_hash_fetch(&nptr->internal, PMIX_RANK_WILDCARD, PMIX_UNIV_SIZE, &val))) {
         if (val->type == PMIX_UINT32) {
             nprocs = val->data.uint32;
         }
         PMIX_VALUE_RELEASE(val);
+    } else if (PMIX_SUCCESS == _esh_fetch(nspace, PMIX_RANK_WILDCARD, PMIX_UNIV_SIZE, &val)) {
+        /* the job-level data may only be available from the dstore */
+        if (val->type == PMIX_UINT32) {
+            nprocs = val->data.uint32;
+        }
+        PMIX_VALUE_RELEASE(val);
     }
 
     return nprocs;
@@ -14,6 +14,7 @@
 #include <src/include/pmix_config.h>
 
 
+#include "src/class/pmix_hash_table.h"
 #include "pmix_dstore.h"
 #include "src/sm/pmix_sm.h"
 
@@ -34,9 +35,26 @@ typedef enum {
 /* initial segment format:
  * size_t num_elems;
  * int full; //indicate to client that it needs to attach to the next segment
+ * int data_layout; //format of the data segments, used in the first segment only
+ * size_t generation; //used in the first segment only, see below
  * ns_seg_info_t ns_seg_info[max_ns_num];
  */
 
+/* The generation counter of the first initial segment serializes
+ * lock-free readers against the server: it is odd while the server
+ * modifies the shared memory, so a reader that observes an odd or
+ * changed value during a fetch has to retry it. */
+typedef struct {
+    size_t num_elems;
+    int full;
+    int data_layout;
+    volatile size_t generation;
+} initial_seg_hdr_t;
+
+/* layouts of the key-value records in the data segments */
+#define ESH_DATA_LAYOUT_FULL     0
+#define ESH_DATA_LAYOUT_COMPACT  1
+
 typedef struct {
     char ns_name[PMIX_MAX_NSLEN+1];
     size_t num_meta_seg;/* read by clients to attach to this number of segments. */
@@ -52,8 +70,53 @@ typedef struct {
     size_t rank;
     size_t offset;
     size_t count;
+    size_t idx_offset;  /* offset of the key index for this rank, 0 if none */
 } rank_meta_info;
 
+/* data segment format:
+ * size_t free_offset; //in the first data segment only
+ * records of the ranks, see below
+ *
+ * full record format:
+ * char key[PMIX_MAX_KEYLEN+1];
+ * size_t size;
+ * byte buffer containing the packed pmix_value
+ *
+ * compact record format:
+ * esh_rec_hdr_t hdr;
+ * char key[hdr.keylen]; //NULL-terminated, padded to 8 bytes
+ * size_t type; //data type of the value
+ * byte buffer of hdr.size - 8 bytes, padded to 8 bytes. Scalars, strings
+ *     and byte objects are stored natively, any other value is stored as
+ *     a packed pmix_value and has the PMIX_VALUE type.
+ *
+ * A compact record with the ESH_REC_SHARED flag doesn't hold its value,
+ * it refers to an identical value stored earlier in the same data segment:
+ * esh_rec_hdr_t hdr; //hdr.size is the size of the referred value
+ * char key[hdr.keylen]; //NULL-terminated, padded to 8 bytes
+ * size_t dist; //the value starts dist bytes before this record
+ * The record holding the value is flagged ESH_REC_REFERENCED and is
+ * never overwritten in place. Neither is a record of a byte object,
+ * whose bytes a reader may still be pointing to.
+ */
+
+typedef struct {
+    size_t size;        /* size of the value */
+    uint32_t keylen;    /* length of the key with the terminating NULL */
+    uint32_t flags;
+} esh_rec_hdr_t;
+
+#define ESH_REC_INVALIDATED 0x1
+#define ESH_REC_SHARED      0x2
+#define ESH_REC_REFERENCED  0x4
+
+/* entry of the per-rank open-addressed key index: the hash of the
+ * key and the offset of its key-value record in the data segments */
+typedef struct {
+    uint32_t hash;
+    size_t offset;
+} rank_key_idx_t;
+
 /* this structs are used to store information about
  * shared segments addresses locally at each process,
  * so they are common for different types of segments
@@ -68,6 +131,8 @@ struct seg_desc_t {
     seg_desc_t *next;
 };
 
+typedef struct esh_session_t esh_session_t;
+
 typedef struct {
     pmix_list_item_t super;
     char ns_name[PMIX_MAX_NSLEN+1];
@@ -75,9 +140,31 @@ typedef struct {
     size_t num_data_seg;
     seg_desc_t *meta_seg;
     seg_desc_t *data_seg;
+    esh_session_t *session; /* the session this nspace's segments belong to */
+    pmix_hash_table_t *interned; /* server only: offsets of the records holding
+                                  * the values stored so far, by value */
+    size_t nshared;         /* number of records that share a value */
+    size_t shared_bytes;    /* bytes saved by sharing the values */
 } ns_track_elem_t;
 PMIX_CLASS_DECLARATION(ns_track_elem_t);
 
+/* A session is the directory of a local nspace with its own lock
+ * file and chain of initial segments. The server creates one for
+ * every nspace registered with it and removes it with all the
+ * segments when the nspace is deleted, clients attach to the
+ * session of their own nspace only. */
+struct esh_session_t {
+    pmix_list_item_t super;
+    char ns_name[PMIX_MAX_NSLEN+1];
+    char *nspace_path;
+    char *lockfile;
+    int lockfd;
+    seg_desc_t *sm_seg_first;
+    seg_desc_t *sm_seg_last;
+    pmix_list_t ns_list;    /* ns_track_elem_t of the nspaces stored in this session */
+};
+PMIX_CLASS_DECLARATION(esh_session_t);
+
 extern pmix_dstore_base_module_t pmix_dstore_esh_module;
 
 END_C_DECLS
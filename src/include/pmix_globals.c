@@ -34,6 +34,8 @@
 #include <sys/types.h>
 #endif
 #include <ctype.h>
+#include <time.h>
+#include <sys/time.h>
 #include PMIX_EVENT_HEADER
 
 #include "src/buffer_ops/types.h"
@@ -52,17 +54,91 @@ pmix_globals_t pmix_globals = {
     .cache_remote = NULL
 };
 
+pmix_wait_t pmix_wait = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+    .spin = PMIX_WAIT_SPIN_MAX,
+    .spun = 0,
+    .slept = 0
+};
+
+void pmix_wait_sleep(void)
+{
+    struct timeval tv;
+    struct timespec ts;
+
+    gettimeofday(&tv, NULL);
+    tv.tv_usec += PMIX_WAIT_TIMEOUT_USEC;
+    ts.tv_sec = tv.tv_sec + tv.tv_usec / 1000000;
+    ts.tv_nsec = (tv.tv_usec % 1000000) * 1000;
+    (void)pthread_cond_timedwait(&pmix_wait.cond, &pmix_wait.lock, &ts);
+}
+
+void pmix_wait_adapt(bool slept)
+{
+    /* if we had to sleep anyway, polling was a waste of cpu, so do
+     * less of it the next time - and more if polling paid off */
+    if (slept) {
+        pmix_wait.slept++;
+        if (PMIX_WAIT_SPIN_MIN < pmix_wait.spin) {
+            pmix_wait.spin /= 2;
+        }
+    } else {
+        pmix_wait.spun++;
+        if (PMIX_WAIT_SPIN_MAX > pmix_wait.spin) {
+            pmix_wait.spin *= 2;
+        }
+    }
+}
+
+
+pmix_nspace_t *pmix_nspace_lookup(const char *nspace)
+{
+    pmix_nspace_t *nptr = NULL;
+
+    if (NULL == nspace) {
+        return NULL;
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_globals.nspace_idx, nspace,
+                                                      strnlen(nspace, PMIX_MAX_NSLEN),
+                                                      (void**)&nptr)) {
+        return NULL;
+    }
+    return nptr;
+}
+
+void pmix_nspace_add(pmix_nspace_t *nptr)
+{
+    pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+    /* the first object of a name wins, as it would on the list */
+    if (NULL == pmix_nspace_lookup(nptr->nspace)) {
+        pmix_hash_table_set_value_ptr(&pmix_globals.nspace_idx, nptr->nspace,
+                                      strnlen(nptr->nspace, PMIX_MAX_NSLEN), nptr);
+    }
+}
+
+void pmix_nspace_remove(pmix_nspace_t *nptr)
+{
+    pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+    if (nptr == pmix_nspace_lookup(nptr->nspace)) {
+        pmix_hash_table_remove_value_ptr(&pmix_globals.nspace_idx, nptr->nspace,
+                                         strnlen(nptr->nspace, PMIX_MAX_NSLEN));
+    }
+}
 
 void pmix_globals_init(void)
 {
     memset(&pmix_globals.myid, 0, sizeof(pmix_proc_t));
     PMIX_CONSTRUCT(&pmix_globals.nspaces, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_globals.nspace_idx, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.nspace_idx, 256);
     PMIX_CONSTRUCT(&pmix_globals.events, pmix_events_t);
 }
 
 void pmix_globals_finalize(void)
 {
     PMIX_LIST_DESTRUCT(&pmix_globals.nspaces);
+    PMIX_DESTRUCT(&pmix_globals.nspace_idx);
     if (NULL != pmix_globals.cache_local) {
         PMIX_RELEASE(pmix_globals.cache_local);
     }
@@ -145,6 +221,10 @@ static void info_con(pmix_rank_info_t *info)
     info->nptr = NULL;
     info->rank = PMIX_RANK_WILDCARD;
     info->modex_recvd = false;
+    info->ncommits = 0;
+    info->commit_bytes = 0;
+    info->local_cap = 0;
+    info->remote_cap = 0;
     info->proc_cnt = 0;
     info->server_object = NULL;
 }
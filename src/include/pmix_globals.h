@@ -28,6 +28,8 @@
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif
+#include <pthread.h>
+#include <sched.h>
 #include PMIX_EVENT_HEADER
 
 #include <pmix_common.h>
@@ -82,6 +84,16 @@ typedef enum {
     PMIX_COLLECT_MAX
 } pmix_collect_t;
 
+/* the points in the life of a fence that get timestamped */
+typedef enum {
+    PMIX_FENCE_TS_FIRST,            // first local participant arrived
+    PMIX_FENCE_TS_LAST,             // last local participant arrived
+    PMIX_FENCE_TS_HOST,             // contribution handed to the host
+    PMIX_FENCE_TS_CB,               // host's result reached the progress thread
+    PMIX_FENCE_TS_DONE,             // local participants were sent the reply
+    PMIX_FENCE_TS_MAX
+} pmix_fence_ts_t;
+
 /* define a process type */
 typedef enum {
     PMIX_PROC_UNDEF,
@@ -99,6 +111,12 @@ typedef struct {
     size_t nbytes;
 } pmix_usock_hdr_t;
 
+/* peers that agreed on a buffer encoding newer than V1 when they
+ * connected follow each header with a byte giving the encoding
+ * the payload was packed with */
+#define PMIX_USOCK_XHDR_SIZE    (sizeof(pmix_usock_hdr_t) + 1)
+#define PMIX_USOCK_XHDR(p)      (PMIX_BFROP_BUFFER_V1 < (p)->bfrop_version)
+
 /* internally used object for transferring data
  * to/from the server and for storing in the
  * hash tables */
@@ -121,6 +139,7 @@ typedef struct {
     pmix_list_item_t super;
     pmix_event_t ev;
     pmix_usock_hdr_t hdr;
+    char xhdr[PMIX_USOCK_XHDR_SIZE];   // the header as sent to peers that take the encoding byte
     pmix_buffer_t *data;
     bool hdr_sent;
     char *sdptr;
@@ -135,6 +154,8 @@ typedef struct {
     struct pmix_peer_t *peer;
     int sd;
     pmix_usock_hdr_t hdr;
+    char xhdr[PMIX_USOCK_XHDR_SIZE];   // the header as recvd from peers that send the encoding byte
+    uint8_t version;                   // encoding the payload was packed with
     char *data;
     bool hdr_recvd;
     char *rdptr;
@@ -174,6 +195,10 @@ typedef struct pmix_rank_info_t {
     uid_t uid;
     gid_t gid;
     bool modex_recvd;
+    size_t ncommits;           // #commits received from this rank
+    size_t commit_bytes;       // total bytes of data committed by this rank
+    size_t local_cap;          // allocated size of the stored local modex blob
+    size_t remote_cap;         // allocated size of the stored remote modex blob
     int proc_cnt;              // #clones of this rank we know about
     void *server_object;       // pointer to rank-specific object provided by server
 } pmix_rank_info_t;
@@ -191,6 +216,7 @@ typedef struct pmix_peer_t {
     void *server_object;
     int index;
     int sd;
+    uint8_t bfrop_version;      /**< newest buffer encoding the peer reads */
     pmix_event_t send_event;    /**< registration with event thread for send events */
     bool send_ev_active;
     pmix_event_t recv_event;    /**< registration with event thread for recv events */
@@ -245,8 +271,9 @@ PMIX_CLASS_DECLARATION(pmix_query_caddy_t);
 typedef struct {
     pmix_list_item_t super;
     pmix_cmd_t type;
-    pmix_proc_t *pcs;               // copy of the original array of participants
+    pmix_proc_t *pcs;               // sorted copy of the original array of participants
     size_t   npcs;                  // number of procs in the array
+    uint64_t sig;                   // signature of the type and participants
     volatile bool active;           // flag for waiting for completion
     bool def_complete;              // all local procs have been registered and the trk definition is complete
     pmix_list_t ranks;              // list of pmix_rank_info_t of the local participants
@@ -258,6 +285,7 @@ typedef struct {
     pmix_collect_t collect_type;    // whether or not data is to be returned at completion
     pmix_modex_cbfunc_t modexcbfunc;
     pmix_op_cbfunc_t op_cbfunc;
+    double ts[PMIX_FENCE_TS_MAX];   // progress of a fence, see pmix_fence_ts_t
 } pmix_server_trkr_t;
 PMIX_CLASS_DECLARATION(pmix_server_trkr_t);
 
@@ -314,11 +342,57 @@ PMIX_CLASS_DECLARATION(pmix_info_caddy_t);
 } while (0)
 
 
-#define PMIX_WAIT_FOR_COMPLETION(a)             \
-    do {                                        \
-        while ((a)) {                           \
-            usleep(10);                         \
-        }                                       \
+/* Blocking calls wait for the progress thread to reset their flag.
+ * The waiting thread polls the flag for a short while first as most
+ * requests complete quickly, and then sleeps on the wait object until
+ * the flag is reset with PMIX_WAKEUP_THREAD. The number of polls adapts
+ * to how long the recent requests took. A flag that is reset by plain
+ * assignment is still noticed within PMIX_WAIT_TIMEOUT_USEC. */
+#define PMIX_WAIT_SPIN_MIN          1
+#define PMIX_WAIT_SPIN_MAX          1024
+#define PMIX_WAIT_TIMEOUT_USEC      1000
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    volatile int spin;      // current number of polls before sleeping
+    size_t spun;            // #waits completed while polling
+    size_t slept;           // #waits that had to sleep
+} pmix_wait_t;
+
+extern pmix_wait_t pmix_wait;
+
+/* sleep on the wait object until woken up or timed out, the
+ * caller holds pmix_wait.lock */
+void pmix_wait_sleep(void);
+
+/* adapt the number of polls to the outcome of a wait */
+void pmix_wait_adapt(bool slept);
+
+#define PMIX_WAIT_FOR_COMPLETION(a)                     \
+    do {                                                \
+        int _pmix_spin = pmix_wait.spin;                \
+        while ((a) && 0 < _pmix_spin--) {               \
+            sched_yield();                              \
+        }                                               \
+        if ((a)) {                                      \
+            pthread_mutex_lock(&pmix_wait.lock);        \
+            while ((a)) {                               \
+                pmix_wait_sleep();                      \
+            }                                           \
+            pthread_mutex_unlock(&pmix_wait.lock);      \
+            pmix_wait_adapt(true);                      \
+        } else {                                        \
+            pmix_wait_adapt(false);                     \
+        }                                               \
+    } while (0)
+
+#define PMIX_WAKEUP_THREAD(a)                           \
+    do {                                                \
+        pthread_mutex_lock(&pmix_wait.lock);            \
+        (a) = false;                                    \
+        pthread_cond_broadcast(&pmix_wait.cond);        \
+        pthread_mutex_unlock(&pmix_wait.lock);          \
     } while (0)
 
 
@@ -339,6 +413,7 @@ typedef struct {
     bool server;
     bool connected;
     pmix_list_t nspaces;                 // list of pmix_nspace_t for the nspaces we know about
+    pmix_hash_table_t nspace_idx;        // index of nspaces by name
     pmix_buffer_t *cache_local;          // data PUT by me to local scope
     pmix_buffer_t *cache_remote;         // data PUT by me to remote scope
 } pmix_globals_t;
@@ -350,6 +425,19 @@ void pmix_globals_init(void);
 /*  finalize the pmix_global structure */
 void pmix_globals_finalize(void);
 
+/* find an nspace we know about by name, returns NULL if
+ * there is no such nspace */
+pmix_nspace_t *pmix_nspace_lookup(const char *nspace);
+
+/* add an nspace to the list of the nspaces we know about and
+ * index it by name - the name must already be set and must not
+ * be changed while the nspace is on the list */
+void pmix_nspace_add(pmix_nspace_t *nptr);
+
+/* remove an nspace from the list and the index, the caller
+ * is responsible for releasing it */
+void pmix_nspace_remove(pmix_nspace_t *nptr);
+
 extern pmix_globals_t pmix_globals;
 
 END_C_DECLS
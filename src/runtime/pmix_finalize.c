@@ -111,6 +111,7 @@ void pmix_rte_finalize(void)
     /* clean out the globals */
     PMIX_RELEASE(pmix_globals.mypeer);
     PMIX_LIST_DESTRUCT(&pmix_globals.nspaces);
+    PMIX_DESTRUCT(&pmix_globals.nspace_idx);
     if (NULL != pmix_globals.cache_local) {
         PMIX_RELEASE(pmix_globals.cache_local);
     }
@@ -151,6 +151,8 @@ int pmix_rte_init(pmix_proc_type_t type,
     pmix_globals.proc_type = type;
     memset(&pmix_globals.myid, 0, sizeof(pmix_proc_t));
     PMIX_CONSTRUCT(&pmix_globals.nspaces, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_globals.nspace_idx, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.nspace_idx, 256);
     PMIX_CONSTRUCT(&pmix_globals.events, pmix_events_t);
     /* get our effective id's */
     pmix_globals.uid = geteuid();
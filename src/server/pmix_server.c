@@ -54,6 +54,7 @@
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/show_help.h"
+#include "src/util/compress.h"
 #include "src/mca/base/base.h"
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/pinstalldirs/base/base.h"
@@ -79,6 +80,7 @@ static char *systmpdir = NULL;
 static void server_message_handler(struct pmix_peer_t *pr, pmix_usock_hdr_t *hdr,
                                    pmix_buffer_t *buf, void *cbdata);
 static inline int _my_client(const char *nspace, pmix_rank_t rank);
+static inline bool _my_nspace_client(pmix_nspace_t *nptr, pmix_rank_t rank);
 
 /* queue a message to be sent to one of our procs - must
  * provide the following params:
@@ -102,8 +104,7 @@ void pmix_server_queue_message(int fd, short args, void *cbdata)
     snd->hdr.nbytes = (queue->buf)->bytes_used;
     snd->data = (queue->buf);
     /* always start with the header */
-    snd->sdptr = (char*)&snd->hdr;
-    snd->sdbytes = sizeof(pmix_usock_hdr_t);
+    pmix_usock_load_hdr(queue->peer, snd);
 
     /* if there is no message on-deck, put this one there */
     if (NULL == (queue->peer)->send_msg) {
@@ -127,6 +128,7 @@ static pmix_status_t initialize_server_base(pmix_server_module_t *module)
     char * pmix_pid;
     pmix_listener_t *listener;
     pmix_status_t ret;
+    int n;
 
     /* initialize the output system */
     if (!pmix_output_init()) {
@@ -175,10 +177,26 @@ static pmix_status_t initialize_server_base(pmix_server_module_t *module)
     PMIX_CONSTRUCT(&pmix_server_globals.clients, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_server_globals.clients, 1, INT_MAX, 1);
     PMIX_CONSTRUCT(&pmix_server_globals.collectives, pmix_list_t);
-    PMIX_CONSTRUCT(&pmix_server_globals.remote_pnd, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.trackers, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.trackers, 32);
+    PMIX_CONSTRUCT(&pmix_server_globals.remote_pnd, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.remote_pnd, 256);
+    pmix_server_globals.nremote_pnd = 0;
+    pmix_server_globals.max_remote_pnd = 0;
     PMIX_CONSTRUCT(&pmix_server_globals.gdata, pmix_buffer_t);
     PMIX_CONSTRUCT(&pmix_server_globals.events, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.local_reqs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.local_idx, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.local_idx, 256);
+    pmix_server_globals.max_local_reqs = 0;
+    /* the host has to tell us it can carry compressed modex data */
+    pmix_server_globals.compress_modex = false;
+    pmix_server_globals.compress_min = PMIX_SERVER_COMPRESS_MIN_DEFAULT;
+    pmix_server_globals.dedup_modex = false;
+    for (n=0; n < PMIX_FENCE_PHASES; n++) {
+        pmix_timing_hist_init(&pmix_server_globals.fence_hist[n]);
+    }
+    pmix_server_globals.fence_stats = false;
     PMIX_CONSTRUCT(&pmix_server_globals.notifications, pmix_ring_buffer_t);
     PMIX_CONSTRUCT(&pmix_server_globals.listeners, pmix_list_t);
     pmix_ring_buffer_init(&pmix_server_globals.notifications, 256);
@@ -242,6 +260,46 @@ static pmix_status_t initialize_server_base(pmix_server_module_t *module)
     return PMIX_SUCCESS;
 }
 
+/* take a size from any of the integer types a host may have given it as */
+static pmix_status_t _get_size(const pmix_value_t *val, size_t *sz)
+{
+    switch (val->type) {
+        case PMIX_SIZE:
+            *sz = val->data.size;
+            break;
+        case PMIX_UINT:
+            *sz = val->data.uint;
+            break;
+        case PMIX_UINT32:
+            *sz = val->data.uint32;
+            break;
+        case PMIX_UINT64:
+            *sz = val->data.uint64;
+            break;
+        case PMIX_INT:
+            if (0 > val->data.integer) {
+                return PMIX_ERR_BAD_PARAM;
+            }
+            *sz = val->data.integer;
+            break;
+        case PMIX_INT32:
+            if (0 > val->data.int32) {
+                return PMIX_ERR_BAD_PARAM;
+            }
+            *sz = val->data.int32;
+            break;
+        case PMIX_INT64:
+            if (0 > val->data.int64) {
+                return PMIX_ERR_BAD_PARAM;
+            }
+            *sz = val->data.int64;
+            break;
+        default:
+            return PMIX_ERR_BAD_PARAM;
+    }
+    return PMIX_SUCCESS;
+}
+
 PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module,
                                            pmix_info_t info[], size_t ninfo)
 {
@@ -351,9 +409,51 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module,
                 /* push this onto our protected list of keys not
                  * to be passed to the clients */
                 pmix_argv_append_nosize(&protected, PMIX_SERVER_TOOL_SUPPORT);
+            } else if (0 == strcmp(info[n].key, PMIX_SERVER_COMPRESS_MODEX)) {
+                /* the host can carry compressed collective modex data
+                 * between all of its servers */
+                if (PMIX_UNDEF == info[n].value.type || info[n].value.data.flag) {
+                    pmix_server_globals.compress_modex = true;
+                }
+                /* push this onto our protected list of keys not
+                 * to be passed to the clients */
+                pmix_argv_append_nosize(&protected, PMIX_SERVER_COMPRESS_MODEX);
+            } else if (0 == strcmp(info[n].key, PMIX_SERVER_COMPRESS_MIN)) {
+                /* the threshold is a size, but take it from any
+                 * integer the host may have used */
+                if (PMIX_SUCCESS != _get_size(&info[n].value, &pmix_server_globals.compress_min)) {
+                    pmix_output(0, "pmix:server %s given as a negative value or as %s - using %lu bytes",
+                                PMIX_SERVER_COMPRESS_MIN, PMIx_Data_type_string(info[n].value.type),
+                                (unsigned long)pmix_server_globals.compress_min);
+                }
+                /* push this onto our protected list of keys not
+                 * to be passed to the clients */
+                pmix_argv_append_nosize(&protected, PMIX_SERVER_COMPRESS_MIN);
+            } else if (0 == strcmp(info[n].key, PMIX_SERVER_DEDUP_MODEX)) {
+                /* all servers can expand interned collective modex data */
+                if (PMIX_UNDEF == info[n].value.type || info[n].value.data.flag) {
+                    pmix_server_globals.dedup_modex = true;
+                }
+                /* push this onto our protected list of keys not
+                 * to be passed to the clients */
+                pmix_argv_append_nosize(&protected, PMIX_SERVER_DEDUP_MODEX);
+            } else if (0 == strcmp(info[n].key, PMIX_SERVER_FENCE_STATS)) {
+                if (PMIX_UNDEF == info[n].value.type || info[n].value.data.flag) {
+                    pmix_server_globals.fence_stats = true;
+                }
+                /* push this onto our protected list of keys not
+                 * to be passed to the clients */
+                pmix_argv_append_nosize(&protected, PMIX_SERVER_FENCE_STATS);
             }
         }
     }
+#if !PMIX_HAVE_ZLIB
+    if (pmix_server_globals.compress_modex) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "pmix:server built without zlib - collective modex data will not be compressed");
+        pmix_server_globals.compress_modex = false;
+    }
+#endif
     if (tool_support) {
         /* Get up to 30 chars of hostname.*/
         gethostname(myhostname, myhostnamelen);
@@ -500,6 +600,9 @@ static void cleanup_server_state(void)
 {
     int i;
     pmix_peer_t *peer;
+    pmix_list_t *reqs;
+    void *key, *node;
+    size_t keylen;
 
     for (i=0; i < pmix_server_globals.clients.size; i++) {
         if (NULL != (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, i))) {
@@ -507,8 +610,25 @@ static void cleanup_server_state(void)
         }
     }
     PMIX_DESTRUCT(&pmix_server_globals.clients);
+    PMIX_DESTRUCT(&pmix_server_globals.trackers);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
-    PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix:server %lu remote requests pending (max %lu), "
+                        "%lu local requests pending (max %lu)",
+                        (unsigned long)pmix_server_globals.nremote_pnd,
+                        (unsigned long)pmix_server_globals.max_remote_pnd,
+                        (unsigned long)pmix_list_get_size(&pmix_server_globals.local_reqs),
+                        (unsigned long)pmix_server_globals.max_local_reqs);
+    if (PMIX_SUCCESS == pmix_hash_table_get_first_key_ptr(&pmix_server_globals.remote_pnd,
+                                                          &key, &keylen, (void**)&reqs, &node)) {
+        do {
+            PMIX_LIST_RELEASE(reqs);
+        } while (PMIX_SUCCESS == pmix_hash_table_get_next_key_ptr(&pmix_server_globals.remote_pnd,
+                                                                  &key, &keylen, (void**)&reqs,
+                                                                  node, &node));
+    }
+    PMIX_DESTRUCT(&pmix_server_globals.remote_pnd);
+    PMIX_DESTRUCT(&pmix_server_globals.local_idx);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
     PMIX_DESTRUCT(&pmix_server_globals.gdata);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.listeners);
@@ -556,6 +676,20 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     libevent_global_shutdown();
 #endif
 
+    /* report how long the fences took */
+    if (0 < pmix_server_globals.fence_hist[PMIX_FENCE_PHASES - 1].count) {
+        char *stats = pmix_server_fence_stats();
+        if (NULL != stats) {
+            if (pmix_server_globals.fence_stats) {
+                pmix_output(0, "pmix:server fence latencies\n%s", stats);
+            } else {
+                pmix_output_verbose(2, pmix_globals.debug_output,
+                                    "pmix:server fence latencies\n%s", stats);
+            }
+            free(stats);
+        }
+    }
+
     pmix_usock_finalize();
 
 #if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
@@ -568,10 +702,197 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     return PMIX_SUCCESS;
 }
 
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+static pmix_status_t _rank_blob_append(pmix_hash_table_t *ht, pmix_rank_t rank,
+                                       pmix_kval_t *kv, pmix_buffer_t *payload)
+{
+    pmix_buffer_t *bptr = NULL;
+    pmix_status_t rc;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(ht, (uint64_t)rank, (void**)&bptr) ||
+        NULL == bptr) {
+        bptr = PMIX_NEW(pmix_buffer_t);
+        pmix_hash_table_set_value_uint64(ht, (uint64_t)rank, bptr);
+    }
+    if (NULL != kv) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(bptr, kv, 1, PMIX_KVAL))) {
+            return rc;
+        }
+    }
+    if (NULL != payload) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.copy_payload(bptr, payload))) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* publish the job-level data for an nspace into the dstore so that
+ * our local clients can read it in place from the shared memory
+ * segments instead of each of them receiving, and then unpacking,
+ * their own copy of the job_info buffer. The contents are first
+ * collected per rank so that each rank is stored only once */
+static pmix_status_t _job_data_store(const char *nspace, pmix_buffer_t *job_data)
+{
+    pmix_buffer_t buf, buf2, *bptr;
+    pmix_hash_table_t rbufs;
+    pmix_kval_t *kptr, kv, kvn;
+    pmix_value_t val;
+    pmix_rank_t rank;
+    pmix_status_t rc;
+    int32_t cnt;
+    char *data, *nsname, **procs;
+    size_t sz, nnodes, i, j;
+    uint64_t id;
+    void *node;
+
+    PMIX_CONSTRUCT(&rbufs, pmix_hash_table_t);
+    pmix_hash_table_init(&rbufs, 256);
+
+    /* walk a view of the job_info - the original is still needed
+     * for serving remote and cross-nspace requests */
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    data = job_data->base_ptr;
+    sz = job_data->bytes_used;
+    PMIX_LOAD_BUFFER(&buf, data, sz);
+    buf.type = job_data->type;
+
+    /* skip the nspace name */
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, &nsname, &cnt, PMIX_STRING))) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    free(nsname);
+
+    PMIX_CONSTRUCT(&kvn, pmix_kval_t);
+    kvn.value = &val;
+    cnt = 1;
+    kptr = PMIX_NEW(pmix_kval_t);
+    while (PMIX_SUCCESS == (rc = pmix_bfrop.unpack(&buf, kptr, &cnt, PMIX_KVAL))) {
+        if (0 == strcmp(kptr->key, PMIX_PROC_BLOB)) {
+            PMIX_CONSTRUCT(&buf2, pmix_buffer_t);
+            data = (char*)kptr->value->data.bo.bytes;
+            sz = kptr->value->data.bo.size;
+            PMIX_LOAD_BUFFER(&buf2, data, sz);
+            buf2.type = buf.type;
+            cnt = 1;
+            if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf2, &rank, &cnt, PMIX_PROC_RANK))) {
+                PMIX_ERROR_LOG(rc);
+                buf2.base_ptr = NULL;
+                PMIX_DESTRUCT(&buf2);
+                break;
+            }
+            /* the rank itself is served as a key, followed by the
+             * already-packed values for that rank */
+            kvn.key = PMIX_RANK;
+            val.type = PMIX_PROC_RANK;
+            val.data.rank = rank;
+            rc = _rank_blob_append(&rbufs, rank, &kvn, &buf2);
+            buf2.base_ptr = NULL;  // owned by kptr
+            PMIX_DESTRUCT(&buf2);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                break;
+            }
+        } else if (0 == strcmp(kptr->key, PMIX_MAP_BLOB)) {
+            /* keep the map itself so clients can rebuild their
+             * node list, and give every rank its hostname */
+            if (PMIX_SUCCESS != (rc = _rank_blob_append(&rbufs, PMIX_RANK_WILDCARD, kptr, NULL))) {
+                PMIX_ERROR_LOG(rc);
+                break;
+            }
+            PMIX_CONSTRUCT(&buf2, pmix_buffer_t);
+            data = (char*)kptr->value->data.bo.bytes;
+            sz = kptr->value->data.bo.size;
+            PMIX_LOAD_BUFFER(&buf2, data, sz);
+            buf2.type = buf.type;
+            cnt = 1;
+            if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf2, &nnodes, &cnt, PMIX_SIZE))) {
+                PMIX_ERROR_LOG(rc);
+                buf2.base_ptr = NULL;
+                PMIX_DESTRUCT(&buf2);
+                break;
+            }
+            for (i=0; i < nnodes && PMIX_SUCCESS == rc; i++) {
+                cnt = 1;
+                PMIX_CONSTRUCT(&kv, pmix_kval_t);
+                if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf2, &kv, &cnt, PMIX_KVAL))) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_DESTRUCT(&kv);
+                    break;
+                }
+                kvn.key = PMIX_HOSTNAME;
+                val.type = PMIX_STRING;
+                val.data.string = kv.key;
+                procs = pmix_argv_split(kv.value->data.string, ',');
+                for (j=0; NULL != procs[j]; j++) {
+                    rank = strtol(procs[j], NULL, 10);
+                    if (PMIX_SUCCESS != (rc = _rank_blob_append(&rbufs, rank, &kvn, NULL))) {
+                        PMIX_ERROR_LOG(rc);
+                        break;
+                    }
+                }
+                pmix_argv_free(procs);
+                PMIX_DESTRUCT(&kv);
+            }
+            buf2.base_ptr = NULL;  // owned by kptr
+            PMIX_DESTRUCT(&buf2);
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+        } else {
+            /* job-level value - served under the wildcard rank */
+            if (PMIX_SUCCESS != (rc = _rank_blob_append(&rbufs, PMIX_RANK_WILDCARD, kptr, NULL))) {
+                PMIX_ERROR_LOG(rc);
+                break;
+            }
+        }
+        PMIX_RELEASE(kptr);
+        cnt = 1;
+        kptr = PMIX_NEW(pmix_kval_t);
+    }
+    PMIX_RELEASE(kptr);
+    kvn.key = NULL;
+    kvn.value = NULL;
+    PMIX_DESTRUCT(&kvn);
+    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
+        rc = PMIX_SUCCESS;
+    }
+
+    /* push each rank's collection into the dstore */
+    if (PMIX_SUCCESS == pmix_hash_table_get_first_key_uint64(&rbufs, &id, (void**)&bptr, &node)) {
+        do {
+            if (PMIX_SUCCESS == rc) {
+                PMIX_CONSTRUCT(&kv, pmix_kval_t);
+                kv.key = "jobinfo";
+                kv.value = &val;
+                val.type = PMIX_BYTE_OBJECT;
+                val.data.bo.bytes = bptr->base_ptr;
+                val.data.bo.size = bptr->bytes_used;
+                if (PMIX_SUCCESS != (rc = pmix_dstore_store(nspace, (pmix_rank_t)id, &kv))) {
+                    PMIX_ERROR_LOG(rc);
+                }
+                kv.key = NULL;
+                kv.value = NULL;
+                PMIX_DESTRUCT(&kv);
+            }
+            PMIX_RELEASE(bptr);
+        } while (PMIX_SUCCESS == pmix_hash_table_get_next_key_uint64(&rbufs, &id, (void**)&bptr, node, &node));
+    }
+
+  cleanup:
+    buf.base_ptr = NULL;  // protect the job_info
+    PMIX_DESTRUCT(&buf);
+    PMIX_DESTRUCT(&rbufs);
+    return rc;
+}
+#endif /* PMIX_ENABLE_DSTORE */
+
 static void _register_nspace(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
-    pmix_nspace_t *nptr, *tmp;
+    pmix_nspace_t *nptr;
     pmix_status_t rc;
     size_t i, j, size;
     int rank;
@@ -586,34 +907,46 @@ static void _register_nspace(int sd, short args, void *cbdata)
                         "pmix:server _register_nspace");
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            /* release any existing packed data - we will replace it */
-            if (0 < nptr->server->job_info.bytes_used) {
-                PMIX_DESTRUCT(&nptr->server->job_info);
-                PMIX_CONSTRUCT(&nptr->server->job_info, pmix_buffer_t);
-            }
-            break;
+    nptr = pmix_nspace_lookup(cd->proc.nspace);
+    if (NULL != nptr) {
+        /* release any existing packed data - we will replace it */
+        if (0 < nptr->server->job_info.bytes_used) {
+            PMIX_DESTRUCT(&nptr->server->job_info);
+            PMIX_CONSTRUCT(&nptr->server->job_info, pmix_buffer_t);
         }
-    }
-    if (NULL == nptr) {
+    } else {
         nptr = PMIX_NEW(pmix_nspace_t);
         (void)strncpy(nptr->nspace, cd->proc.nspace, PMIX_MAX_NSLEN);
         nptr->server = PMIX_NEW(pmix_server_nspace_t);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_add(nptr);
     }
     nptr->server->nlocalprocs = cd->nlocalprocs;
     /* see if we have everyone */
     if (nptr->server->nlocalprocs == pmix_list_get_size(&nptr->server->ranks)) {
         nptr->server->all_registered = true;
     }
+    /* size the job info from what we were given so it is allocated
+     * once - only the expanded maps and proc data may need more */
+    size = strlen(nptr->nspace) + PMIX_KVAL_PACK_OVERHEAD;
+    for (i=0; i < cd->ninfo; i++) {
+        size += strlen(cd->info[i].key) + PMIX_KVAL_PACK_OVERHEAD;
+        if (PMIX_STRING == cd->info[i].value.type &&
+            NULL != cd->info[i].value.data.string) {
+            size += strlen(cd->info[i].value.data.string);
+        }
+    }
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.reserve(&nptr->server->job_info, size))) {
+        PMIX_ERROR_LOG(rc);
+        pmix_nspace_remove(nptr);
+        PMIX_RELEASE(nptr);
+        goto release;
+    }
+
     /* pack the name of the nspace */
     msg = nptr->nspace;
     if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&nptr->server->job_info, &msg, 1, PMIX_STRING))) {
         PMIX_ERROR_LOG(rc);
-        pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_remove(nptr);
         PMIX_RELEASE(nptr);
         goto release;
     }
@@ -675,7 +1008,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
             rank = iptr[0].value.data.rank;
             if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf2, &rank, 1, PMIX_PROC_RANK))) {
                 PMIX_ERROR_LOG(rc);
-                pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+                pmix_nspace_remove(nptr);
                 PMIX_RELEASE(nptr);
                 PMIX_DESTRUCT(&buf2);
                 goto release;
@@ -686,7 +1019,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
                 kv.value = &iptr[j].value;
                 if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf2, &kv, 1, PMIX_KVAL))) {
                     PMIX_ERROR_LOG(rc);
-                    pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+                    pmix_nspace_remove(nptr);
                     PMIX_RELEASE(nptr);
                     PMIX_DESTRUCT(&buf2);
                     goto release;
@@ -700,7 +1033,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
             val.data.bo.size = buf2.bytes_used;
             if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&nptr->server->job_info, &kv, 1, PMIX_KVAL))) {
                 PMIX_ERROR_LOG(rc);
-                pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+                pmix_nspace_remove(nptr);
                 PMIX_RELEASE(nptr);
                 PMIX_DESTRUCT(&buf2);
                 goto release;
@@ -712,7 +1045,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
             kv.value = &cd->info[i].value;
             if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&nptr->server->job_info, &kv, 1, PMIX_KVAL))) {
                 PMIX_ERROR_LOG(rc);
-                pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+                pmix_nspace_remove(nptr);
                 PMIX_RELEASE(nptr);
                 goto release;
             }
@@ -725,6 +1058,11 @@ static void _register_nspace(int sd, short args, void *cbdata)
         PMIX_ERROR_LOG(rc);
         goto release;
     }
+    /* clients read their job-level data from the dstore */
+    if (PMIX_SUCCESS != (rc = _job_data_store(cd->proc.nspace, &nptr->server->job_info))) {
+        PMIX_ERROR_LOG(rc);
+        goto release;
+    }
 #endif
 
  release:
@@ -768,18 +1106,25 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_nspace_t *tmp;
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    pmix_status_t rc;
+#endif
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix:server _deregister_nspace %s",
                         cd->proc.nspace);
 
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    /* release the shared memory of the nspace */
+    if (PMIX_SUCCESS != (rc = pmix_dstore_nspace_del(cd->proc.nspace))) {
+        PMIX_ERROR_LOG(rc);
+    }
+#endif /* PMIX_ENABLE_DSTORE */
+
     /* see if we already have this nspace */
-    PMIX_LIST_FOREACH(tmp, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            pmix_list_remove_item(&pmix_globals.nspaces, &tmp->super);
-            PMIX_RELEASE(tmp);
-            break;
-        }
+    if (NULL != (tmp = pmix_nspace_lookup(cd->proc.nspace))) {
+        pmix_nspace_remove(tmp);
+        PMIX_RELEASE(tmp);
     }
 
     if (NULL != cd->opcbfunc) {
@@ -821,6 +1166,8 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
     /* we don't need to check for non-NULL APIs here as
      * that was already done when the tracker was created */
     if (PMIX_FENCENB_CMD == trk->type) {
+        /* the participants had all arrived before they were known */
+        trk->ts[PMIX_FENCE_TS_LAST] = pmix_timing_now();
         /* if the user asked us to collect data, then we have
          * to provide any locally collected data to the host
          * server so they can circulate it - only take data
@@ -869,6 +1216,7 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
         }
         PMIX_UNLOAD_BUFFER(&bucket, data, sz);
         PMIX_DESTRUCT(&bucket);
+        trk->ts[PMIX_FENCE_TS_HOST] = pmix_timing_now();
         pmix_host_server.fence_nb(trk->pcs, trk->npcs,
                                   trk->info, trk->ninfo,
                                   data, sz, trk->modexcbfunc, trk);
@@ -883,7 +1231,7 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
     } else {
         /* unknown type */
         PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_remove_tracker(trk);
         PMIX_RELEASE(trk);
     }
     PMIX_RELEASE(tcd);
@@ -893,7 +1241,7 @@ static void _register_client(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_rank_info_t *info, *iptr, *iptr2;
-    pmix_nspace_t *nptr, *tmp;
+    pmix_nspace_t *nptr;
     pmix_server_trkr_t *trk;
     pmix_trkr_caddy_t *tcd;
     bool all_def;
@@ -904,19 +1252,13 @@ static void _register_client(int sd, short args, void *cbdata)
                         cd->proc.nspace, cd->proc.rank);
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         nptr = PMIX_NEW(pmix_nspace_t);
         (void)strncpy(nptr->nspace, cd->proc.nspace, PMIX_MAX_NSLEN);
         /* add the server object */
         nptr->server = PMIX_NEW(pmix_server_nspace_t);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_add(nptr);
     }
     /* setup a peer object for this client - since the host server
      * only deals with the original processes and not any clones,
@@ -1035,20 +1377,14 @@ static void _deregister_client(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_rank_info_t *info;
-    pmix_nspace_t *nptr, *tmp;
+    pmix_nspace_t *nptr;
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix:server _deregister_client for nspace %s rank %d",
                         cd->proc.nspace, cd->proc.rank);
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         /* nothing to do */
         goto cleanup;
@@ -1092,7 +1428,7 @@ PMIX_EXPORT void PMIx_server_deregister_client(const pmix_proc_t *proc,
 /* setup the envars for a child process */
 PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char ***env)
 {
-    char rankstr[128];
+    char rankstr[128], *verstr;
     pmix_listener_t *lt;
 
     pmix_output_verbose(2, pmix_globals.debug_output,
@@ -1109,6 +1445,18 @@ PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char *
         if (NULL != lt->uri && NULL != lt->varname) {
             pmix_setenv(lt->varname, lt->uri, true, env);
         }
+        if (NULL != lt->uri && NULL != lt->varname &&
+            0 == strcmp(lt->varname, "PMIX_SERVER_URI")) {
+            /* let them know they can offer us a buffer encoding when
+             * they connect. The offer is tied to our uri, so that a
+             * descendant inheriting it doesn't make it to a server
+             * that can't answer it */
+            if (0 > asprintf(&verstr, "%d:%s", PMIX_BFROP_BUFFER_NEWEST, lt->uri)) {
+                return PMIX_ERR_NOMEM;
+            }
+            pmix_setenv("PMIX_BFROP_VERSION", verstr, true, env);
+            free(verstr);
+        }
     }
     /* pass our active security mode */
     pmix_setenv("PMIX_SECURITY_MODE", security_mode, true, env);
@@ -1130,7 +1478,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_rank_info_t *info, *iptr;
-    pmix_nspace_t *nptr, *ns;
+    pmix_nspace_t *nptr;
     pmix_buffer_t pbkt;
     pmix_value_t *val;
     char *data = NULL;
@@ -1145,13 +1493,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
      * could cause this request to arrive prior to us having
      * been informed of it - so first check to see if we know
      * about this nspace yet */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(ns->nspace, cd->proc.nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         /* we don't know this namespace yet, and so we obviously
          * haven't received the data from this proc yet - defer
@@ -1159,8 +1501,8 @@ static void _dmodex_req(int sd, short args, void *cbdata)
         dcd = PMIX_NEW(pmix_dmdx_remote_t);
         PMIX_RETAIN(cd);
         dcd->cd = cd;
-        pmix_list_append(&pmix_server_globals.remote_pnd, &dcd->super);
-        cd->active = false;  // ensure the request doesn't hang
+        pmix_pending_remote_add(dcd);
+        PMIX_WAKEUP_THREAD(cd->active);  // ensure the request doesn't hang
         return;
     }
 
@@ -1178,8 +1520,8 @@ static void _dmodex_req(int sd, short args, void *cbdata)
         dcd = PMIX_NEW(pmix_dmdx_remote_t);
         PMIX_RETAIN(cd);
         dcd->cd = cd;
-        pmix_list_append(&pmix_server_globals.remote_pnd, &dcd->super);
-        cd->active = false;  // ensure the request doesn't hang
+        pmix_pending_remote_add(dcd);
+        PMIX_WAKEUP_THREAD(cd->active);  // ensure the request doesn't hang
         return;
     }
 
@@ -1191,8 +1533,8 @@ static void _dmodex_req(int sd, short args, void *cbdata)
         dcd = PMIX_NEW(pmix_dmdx_remote_t);
         PMIX_RETAIN(cd);
         dcd->cd = cd;
-        pmix_list_append(&pmix_server_globals.remote_pnd, &dcd->super);
-        cd->active = false;  // ensure the request doesn't hang
+        pmix_pending_remote_add(dcd);
+        PMIX_WAKEUP_THREAD(cd->active);  // ensure the request doesn't hang
         return;
     }
 
@@ -1215,7 +1557,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
     if (NULL != data) {
         free(data);
     }
-    cd->active = false;
+    PMIX_WAKEUP_THREAD(cd->active);
 }
 
 PMIX_EXPORT pmix_status_t PMIx_server_dmodex_request(const pmix_proc_t *proc,
@@ -1251,22 +1593,16 @@ PMIX_EXPORT pmix_status_t PMIx_server_dmodex_request(const pmix_proc_t *proc,
 static void _store_internal(int sd, short args, void *cbdata)
 {
     pmix_shift_caddy_t *cd = (pmix_shift_caddy_t*)cbdata;
-    pmix_nspace_t *ns, *nsptr;
+    pmix_nspace_t *ns;
 
-    ns = NULL;
-    PMIX_LIST_FOREACH(nsptr, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strncmp(cd->nspace, nsptr->nspace, PMIX_MAX_NSLEN)) {
-            ns = nsptr;
-            break;
-        }
-    }
+    ns = pmix_nspace_lookup(cd->nspace);
     if (NULL == ns) {
         /* shouldn't be possible */
         cd->status = PMIX_ERR_NOT_FOUND;
     } else {
         cd->status = pmix_hash_store(&ns->internal, cd->rank, cd->kv);
     }
-    cd->active = false;
+    PMIX_WAKEUP_THREAD(cd->active);
  }
 
 PMIX_EXPORT pmix_status_t PMIx_Store_internal(const pmix_proc_t *proc,
@@ -1682,7 +2018,7 @@ static void op_cbfunc(pmix_status_t status, void *cbdata)
 static void _spcb(int sd, short args, void *cbdata)
 {
     pmix_shift_caddy_t *cd = (pmix_shift_caddy_t*)cbdata;
-    pmix_nspace_t *nptr, *ns;
+    pmix_nspace_t *nptr;
     pmix_buffer_t *reply;
     pmix_status_t rc;
 
@@ -1691,19 +2027,13 @@ static void _spcb(int sd, short args, void *cbdata)
     if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(reply, &cd->status, 1, PMIX_STATUS))) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(cd->cd);
-        cd->active = false;
+        PMIX_WAKEUP_THREAD(cd->active);
         return;
     }
     if (PMIX_SUCCESS == cd->status) {
         /* add any job-related info we have on that nspace - this will
          * include the name of the nspace */
-        nptr = NULL;
-        PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-            if (0 == strcmp(ns->nspace, cd->nspace)) {
-                nptr = ns;
-                break;
-            }
-        }
+        nptr = pmix_nspace_lookup(cd->nspace);
         if (NULL == nptr) {
             /* shouldn't happen */
             PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
@@ -1718,7 +2048,7 @@ static void _spcb(int sd, short args, void *cbdata)
     PMIX_SERVER_QUEUE_REPLY(cd->cd->peer, cd->cd->hdr.tag, reply);
     /* cleanup */
     PMIX_RELEASE(cd->cd);
-    cd->active = false;
+    PMIX_WAKEUP_THREAD(cd->active);
 }
 
 static void spawn_cbfunc(pmix_status_t status, char *nspace, void *cbdata)
@@ -1774,18 +2104,207 @@ static void lookup_cbfunc(pmix_status_t status, pmix_pdata_t pdata[], size_t nda
     PMIX_RELEASE(cd);
 }
 
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+/* values of one nspace waiting to be put in the dstore together */
+typedef struct {
+    pmix_nspace_t *nptr;
+    pmix_rank_t *ranks;
+    pmix_kval_t **kvs;
+    size_t n;
+    size_t size;
+} _store_batch_t;
+
+static void _batch_flush(_store_batch_t *batch)
+{
+    pmix_status_t rc;
+    size_t i;
+
+    if (0 == batch->n) {
+        return;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_dstore_store_many(batch->nptr->nspace, batch->ranks,
+                                                     batch->kvs, batch->n))) {
+        PMIX_ERROR_LOG(rc);
+    }
+    for (i = 0; i < batch->n; i++) {
+        PMIX_RELEASE(batch->kvs[i]);
+    }
+    batch->n = 0;
+}
+
+static pmix_status_t _batch_add(_store_batch_t *batch, pmix_nspace_t *nptr,
+                                pmix_rank_t rank, pmix_kval_t *kv)
+{
+    void *ptr;
+
+    if (batch->nptr != nptr) {
+        _batch_flush(batch);
+        batch->nptr = nptr;
+    }
+    if (batch->n == batch->size) {
+        batch->size = (0 == batch->size) ? 64 : 2 * batch->size;
+        if (NULL == (ptr = realloc(batch->ranks, batch->size * sizeof(pmix_rank_t)))) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        batch->ranks = (pmix_rank_t*)ptr;
+        if (NULL == (ptr = realloc(batch->kvs, batch->size * sizeof(pmix_kval_t*)))) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        batch->kvs = (pmix_kval_t**)ptr;
+    }
+    PMIX_RETAIN(kv);
+    batch->ranks[batch->n] = rank;
+    batch->kvs[batch->n] = kv;
+    batch->n++;
+    return PMIX_SUCCESS;
+}
+#endif /* PMIX_ENABLE_DSTORE */
+
+/* uncompress the rest of a server's contribution to the collective
+ * modex data into a buffer of its own */
+static pmix_status_t _unpack_compressed(pmix_buffer_t *xfer, pmix_buffer_t **ubuf)
+{
+    pmix_byte_object_t bo;
+    uint8_t *udata;
+    size_t usize;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(xfer, &usize, &cnt, PMIX_SIZE))) {
+        return rc;
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(xfer, &bo, &cnt, PMIX_BYTE_OBJECT))) {
+        return rc;
+    }
+    rc = pmix_uncompress_block((uint8_t*)bo.bytes, bo.size, &udata, usize);
+    if (NULL != bo.bytes) {
+        free(bo.bytes);
+    }
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "server:modex_cbfunc uncompressed %lu bytes to %lu",
+                        (unsigned long)bo.size, (unsigned long)usize);
+    *ubuf = PMIX_NEW(pmix_buffer_t);
+    PMIX_LOAD_BUFFER(*ubuf, udata, usize);
+    return PMIX_SUCCESS;
+}
+
+/* unpack the distinct kvals that follow the rank blobs of
+ * a server's interned contribution to the collective modex data */
+static pmix_status_t _unpack_interned(pmix_buffer_t *xfer, pmix_byte_object_t **kvs,
+                                      uint32_t *nkvs)
+{
+    int32_t cnt;
+    pmix_status_t rc;
+
+    *kvs = NULL;
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(xfer, nkvs, &cnt, PMIX_UINT32))) {
+        return rc;
+    }
+    if (0 == *nkvs) {
+        return PMIX_SUCCESS;
+    }
+    if (INT32_MAX < *nkvs) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    if (NULL == (*kvs = (pmix_byte_object_t*)calloc(*nkvs, sizeof(pmix_byte_object_t)))) {
+        return PMIX_ERR_NOMEM;
+    }
+    cnt = *nkvs;
+    return pmix_bfrop.unpack(xfer, *kvs, &cnt, PMIX_BYTE_OBJECT);
+}
+
+static void _release_interned(pmix_byte_object_t **kvs, uint32_t *nkvs)
+{
+    uint32_t n;
+
+    if (NULL == *kvs) {
+        return;
+    }
+    for (n=0; n < *nkvs; n++) {
+        if (NULL != (*kvs)[n].bytes) {
+            free((*kvs)[n].bytes);
+        }
+    }
+    free(*kvs);
+    *kvs = NULL;
+    *nkvs = 0;
+}
+
+/* put the kvals referenced by an interned rank blob back together
+ * into the packed kvals the blob stood for */
+static pmix_status_t _expand_interned(pmix_buffer_t *bpscope, pmix_byte_object_t *kvs,
+                                      uint32_t nkvs, pmix_byte_object_t *bo)
+{
+    uint32_t *idx;
+    size_t nidx = 0, maxidx, n;
+    int32_t cnt = 1;
+    pmix_status_t rc;
+
+    bo->bytes = NULL;
+    bo->size = 0;
+    /* each index takes at least four bytes */
+    maxidx = bpscope->bytes_used / sizeof(uint32_t);
+    if (0 == maxidx) {
+        return PMIX_SUCCESS;
+    }
+    if (NULL == (idx = (uint32_t*)malloc(maxidx * sizeof(uint32_t)))) {
+        return PMIX_ERR_NOMEM;
+    }
+    while (nidx < maxidx &&
+           PMIX_SUCCESS == (rc = pmix_bfrop.unpack(bpscope, &idx[nidx], &cnt, PMIX_UINT32))) {
+        if (nkvs <= idx[nidx]) {
+            free(idx);
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        bo->size += kvs[idx[nidx]].size;
+        nidx++;
+        cnt = 1;
+    }
+    if (0 < bo->size) {
+        if (NULL == (bo->bytes = (char*)malloc(bo->size))) {
+            free(idx);
+            bo->size = 0;
+            return PMIX_ERR_NOMEM;
+        }
+        bo->size = 0;
+        for (n=0; n < nidx; n++) {
+            memcpy(bo->bytes + bo->size, kvs[idx[n]].bytes, kvs[idx[n]].size);
+            bo->size += kvs[idx[n]].size;
+        }
+    }
+    free(idx);
+    return PMIX_SUCCESS;
+}
+
 static void _mdxcbfunc(int sd, short argc, void *cbdata)
 {
     pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
     pmix_server_trkr_t *tracker = scd->tracker;
-    pmix_buffer_t xfer, *bptr, *databuf, *bpscope, *reply;
-    pmix_nspace_t *nptr, *ns;
+    pmix_buffer_t xfer, *bptr, *databuf, *bpscope, *reply, *ubuf, *src;
+    pmix_byte_object_t *kvs = NULL;
+    uint32_t nkvs = 0;
+    pmix_nspace_t *nptr = NULL;
     pmix_server_caddy_t *cd;
     char *nspace;
     int rank;
     pmix_status_t rc = PMIX_SUCCESS;
     int32_t cnt = 1;
     char byte;
+    bool local;
+    size_t nbytes = 0;
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    _store_batch_t batch = {NULL, NULL, NULL, 0, 0};
+#endif
+
+    /* the tracker belongs to this thread, so the time the host
+     * called back is taken here rather than in its thread */
+    tracker->ts[PMIX_FENCE_TS_CB] = pmix_timing_now();
 
     /* pass the blobs being returned */
     PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
@@ -1805,6 +2324,13 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
     /* if data was returned, unpack and store it */
     while (PMIX_SUCCESS == (rc = pmix_bfrop.unpack(&xfer, &byte, &cnt, PMIX_BYTE))) {
         pmix_collect_t ctype = (pmix_collect_t)byte;
+        unsigned char flags = 0;
+
+        // A server may have interned and/or compressed the rest of its contribution
+        if (PMIX_COLLECT_YES == ((unsigned char)byte & ~(PMIX_COLLECT_COMPRESSED | PMIX_COLLECT_INTERNED))) {
+            ctype = PMIX_COLLECT_YES;
+            flags = (unsigned char)byte & (PMIX_COLLECT_COMPRESSED | PMIX_COLLECT_INTERNED);
+        }
 
         // Check that this blob was accumulated with the same data collection setting
         if (ctype != tracker->collect_type) {
@@ -1818,8 +2344,27 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
         }
 
         // Extract the node-wise blob containing rank data
+        ubuf = NULL;
+        src = &xfer;
+        if (PMIX_COLLECT_COMPRESSED & flags) {
+            if (PMIX_SUCCESS != (rc = _unpack_compressed(&xfer, &ubuf))) {
+                PMIX_ERROR_LOG(rc);
+                goto finish_collective;
+            }
+            src = ubuf;
+        }
         cnt = 1;
-        if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&xfer, &databuf, &cnt, PMIX_BUFFER))) {
+        rc = pmix_bfrop.unpack(src, &databuf, &cnt, PMIX_BUFFER);
+        if (PMIX_SUCCESS == rc && (PMIX_COLLECT_INTERNED & flags) &&
+            PMIX_SUCCESS != (rc = _unpack_interned(src, &kvs, &nkvs))) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(databuf);
+            _release_interned(&kvs, &nkvs);
+        }
+        if (NULL != ubuf) {
+            PMIX_RELEASE(ubuf);
+        }
+        if (PMIX_SUCCESS != rc) {
             rc = PMIX_ERR_DATA_VALUE_NOT_FOUND;
             goto finish_collective;
         }
@@ -1829,19 +2374,16 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
         while (PMIX_SUCCESS == (rc = pmix_bfrop.unpack(databuf, &bptr, &cnt, PMIX_BUFFER))) {
             /* unpack the nspace */
             cnt = 1;
-            if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(bptr, &nspace, &cnt, PMIX_STRING))) {
+            if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack_view(bptr, &nspace, &cnt, PMIX_STRING))) {
                 PMIX_ERROR_LOG(rc);
                 goto finish_collective;
             }
             pmix_output_verbose(2, pmix_globals.debug_output,
                                 "server:modex_cbfunc unpacked blob for npsace %s", nspace);
-            /* find the nspace object */
-            nptr = NULL;
-            PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-                if (0 == strcmp(nspace, ns->nspace)) {
-                    nptr = ns;
-                    break;
-                }
+            /* find the nspace object - the blobs of an nspace
+             * usually come one after another */
+            if (NULL == nptr || 0 != strcmp(nspace, nptr->nspace)) {
+                nptr = pmix_nspace_lookup(nspace);
             }
 
             if (NULL == nptr) {
@@ -1868,24 +2410,39 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
             }
             pmix_output_verbose(2, pmix_globals.debug_output,
                                 "client:unpack fence received blob for rank %d", rank);
+            /* don't store blobs to the sm dstore from local clients */
+            local = _my_nspace_client(nptr, rank);
             /* there may be multiple blobs for this rank, each from a different scope */
             cnt = 1;
             while (PMIX_SUCCESS == (rc = pmix_bfrop.unpack(bptr, &bpscope, &cnt, PMIX_BUFFER))) {
-                /* don't store blobs to the sm dstore from local clients */
-                if (_my_client(nptr->nspace, rank)) {
+                if (local) {
+                    PMIX_RELEASE(bpscope);
                     continue;
                 }
                 pmix_kval_t *kp = PMIX_NEW(pmix_kval_t);
                 kp->key = strdup("modex");
                 PMIX_VALUE_CREATE(kp->value, 1);
                 kp->value->type = PMIX_BYTE_OBJECT;
-                PMIX_UNLOAD_BUFFER(bpscope, kp->value->data.bo.bytes, kp->value->data.bo.size);
+                if (PMIX_COLLECT_INTERNED & flags) {
+                    rc = _expand_interned(bpscope, kvs, nkvs, &kp->value->data.bo);
+                    PMIX_RELEASE(bpscope);
+                    if (PMIX_SUCCESS != rc) {
+                        PMIX_ERROR_LOG(rc);
+                        PMIX_RELEASE(kp);
+                        goto finish_collective;
+                    }
+                } else {
+                    PMIX_UNLOAD_BUFFER(bpscope, kp->value->data.bo.bytes, kp->value->data.bo.size);
+                    PMIX_RELEASE(bpscope);
+                }
+                nbytes += kp->value->data.bo.size;
                 /* store it in the appropriate hash */
                 if (PMIX_SUCCESS != (rc = pmix_hash_store(&nptr->server->remote, rank, kp))) {
                     PMIX_ERROR_LOG(rc);
                 }
 #if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
-                if (PMIX_SUCCESS != (rc = pmix_dstore_store(nptr->nspace, rank, kp))) {
+                /* the dstore takes the values of an nspace in batches */
+                if (PMIX_SUCCESS != (rc = _batch_add(&batch, nptr, rank, kp))) {
                     PMIX_ERROR_LOG(rc);
                 }
 #endif /* PMIX_ENABLE_DSTORE */
@@ -1900,10 +2457,11 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
                  */
                 goto finish_collective;
             }
-            PMIX_RELEASE(bpscope);
             PMIX_RELEASE(bptr);
             cnt = 1;
         }
+        PMIX_RELEASE(databuf);
+        _release_interned(&kvs, &nkvs);
         if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
             goto finish_collective;
         } else {
@@ -1917,8 +2475,26 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
     }
 
   finish_collective:
-    /* setup the reply, starting with the returned status */
+    _release_interned(&kvs, &nkvs);
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    /* store whatever is still pending, even on error */
+    _batch_flush(&batch);
+    free(batch.ranks);
+    free(batch.kvs);
+#endif /* PMIX_ENABLE_DSTORE */
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "server:modex_cbfunc stored %lu bytes of remote data",
+                        (unsigned long)nbytes);
+    /* setup the reply, starting with the returned status. The one
+     * buffer goes to every local participant, so pack it in the
+     * encoding all of them can read */
     reply = PMIX_NEW(pmix_buffer_t);
+    reply->version = PMIX_BFROP_BUFFER_NEWEST;
+    PMIX_LIST_FOREACH(cd, &tracker->local_cbs, pmix_server_caddy_t) {
+        if (cd->peer->bfrop_version < reply->version) {
+            reply->version = cd->peer->bfrop_version;
+        }
+    }
     if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(reply, &rc, 1, PMIX_STATUS))) {
         PMIX_ERROR_LOG(rc);
         goto cleanup;
@@ -1932,6 +2508,8 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
                             cd->peer->info->nptr->nspace, cd->peer->info->rank);
         PMIX_SERVER_QUEUE_REPLY(cd->peer, cd->hdr.tag, reply);
     }
+    tracker->ts[PMIX_FENCE_TS_DONE] = pmix_timing_now();
+    pmix_server_fence_stats_add(tracker);
 
   cleanup:
     /* Protect data from being free'd because RM pass
@@ -1944,7 +2522,7 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
     PMIX_DESTRUCT(&xfer);
 
     PMIX_RELEASE(reply);  // maintain accounting
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_remove_tracker(tracker);
     PMIX_RELEASE(tracker);
 
     /* we are done */
@@ -1970,7 +2548,6 @@ static void modex_cbfunc(pmix_status_t status, const char *data, size_t ndata, v
         }
         return;
     }
-
     /* need to thread-shift this callback as it accesses global data */
     scd = PMIX_NEW(pmix_shift_caddy_t);
     scd->status = status;
@@ -2061,16 +2638,14 @@ static void _cnct(int sd, short args, void *cbdata)
         /* loop across all participating nspaces and include their
          * job-related info */
         for (i=0; NULL != nspaces[i]; i++) {
-            PMIX_LIST_FOREACH(nptr, &pmix_globals.nspaces, pmix_nspace_t) {
-                if (0 != strcmp(nspaces[i], nptr->nspace)) {
-                    continue;
-                }
-                job_info_ptr = &nptr->server->job_info;
-                if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(reply, &job_info_ptr, 1, PMIX_BUFFER))) {
-                    PMIX_ERROR_LOG(rc);
-                    pmix_argv_free(nspaces);
-                    goto cleanup;
-                }
+            if (NULL == (nptr = pmix_nspace_lookup(nspaces[i]))) {
+                continue;
+            }
+            job_info_ptr = &nptr->server->job_info;
+            if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(reply, &job_info_ptr, 1, PMIX_BUFFER))) {
+                PMIX_ERROR_LOG(rc);
+                pmix_argv_free(nspaces);
+                goto cleanup;
             }
         }
         pmix_argv_free(nspaces);
@@ -2087,7 +2662,7 @@ static void _cnct(int sd, short args, void *cbdata)
 
   cleanup:
     PMIX_RELEASE(reply);  // maintain accounting
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_remove_tracker(tracker);
     PMIX_RELEASE(tracker);
 
     /* we are done */
@@ -2216,6 +2791,9 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
     pmix_buffer_t *reply;
     pmix_regevents_info_t *reginfo;
     pmix_peer_events_info_t *prev;
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    char *msg;
+#endif
 
     /* retrieve the cmd */
     cnt = 1;
@@ -2229,7 +2807,14 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
 
     if (PMIX_REQ_CMD == cmd) {
         reply = PMIX_NEW(pmix_buffer_t);
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+        /* the job-level data is already in the dstore, so
+         * all the client needs is the name of its nspace */
+        msg = peer->info->nptr->nspace;
+        pmix_bfrop.pack(reply, &msg, 1, PMIX_STRING);
+#else
         pmix_bfrop.copy_payload(reply, &(peer->info->nptr->server->job_info));
+#endif /* PMIX_ENABLE_DSTORE */
         pmix_bfrop.copy_payload(reply, &(pmix_server_globals.gdata));
         PMIX_SERVER_QUEUE_REPLY(peer, tag, reply);
         return PMIX_SUCCESS;
@@ -2423,3 +3008,17 @@ static inline int _my_client(const char *nspace, pmix_rank_t rank)
 
     return local;
 }
+
+/* same as _my_client, but only a rank registered as local for the
+ * nspace can be a client, so check that cheaply first */
+static inline bool _my_nspace_client(pmix_nspace_t *nptr, pmix_rank_t rank)
+{
+    pmix_rank_info_t *info;
+
+    PMIX_LIST_FOREACH(info, &nptr->server->ranks, pmix_rank_info_t) {
+        if (info->rank == rank) {
+            return (0 != _my_client(nptr->nspace, rank));
+        }
+    }
+    return false;
+}
@@ -96,6 +96,42 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
                                           pmix_dmdx_local_t **lcd);
 
 
+/* the local requests are kept on a list and indexed by
+ * the proc whose data they are waiting for */
+static pmix_dmdx_local_t *_local_req_find(const char *nspace, pmix_rank_t rank)
+{
+    pmix_proc_t key;
+    pmix_dmdx_local_t *lcd = NULL;
+
+    PMIX_PENDING_KEY(&key, nspace, rank);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_server_globals.local_idx,
+                                                      &key, sizeof(key), (void**)&lcd)) {
+        return NULL;
+    }
+    return lcd;
+}
+
+static void _local_req_add(pmix_dmdx_local_t *lcd)
+{
+    pmix_proc_t key;
+
+    PMIX_PENDING_KEY(&key, lcd->proc.nspace, lcd->proc.rank);
+    pmix_hash_table_set_value_ptr(&pmix_server_globals.local_idx, &key, sizeof(key), lcd);
+    pmix_list_append(&pmix_server_globals.local_reqs, &lcd->super);
+    if (pmix_server_globals.max_local_reqs < pmix_list_get_size(&pmix_server_globals.local_reqs)) {
+        pmix_server_globals.max_local_reqs = pmix_list_get_size(&pmix_server_globals.local_reqs);
+    }
+}
+
+static void _local_req_remove(pmix_dmdx_local_t *lcd)
+{
+    pmix_proc_t key;
+
+    PMIX_PENDING_KEY(&key, lcd->proc.nspace, lcd->proc.rank);
+    pmix_hash_table_remove_value_ptr(&pmix_server_globals.local_idx, &key, sizeof(key));
+    pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+}
+
 /* declare a function whose sole purpose is to
  * free data that we provided to our host server
  * when servicing dmodex requests */
@@ -118,7 +154,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     pmix_rank_t rank;
     char *cptr;
     char nspace[PMIX_MAX_NSLEN+1];
-    pmix_nspace_t *ns, *nptr;
+    pmix_nspace_t *nptr;
     pmix_info_t *info=NULL;
     size_t ninfo=0;
     pmix_dmdx_local_t *lcd;
@@ -136,12 +172,11 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
 
     /* retrieve the nspace and rank of the requested proc */
     cnt = 1;
-    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(buf, &cptr, &cnt, PMIX_STRING))) {
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack_view(buf, &cptr, &cnt, PMIX_STRING))) {
         PMIX_ERROR_LOG(rc);
         return rc;
     }
     (void)strncpy(nspace, cptr, PMIX_MAX_NSLEN);
-    free(cptr);
     cnt = 1;
     if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(buf, &rank, &cnt, PMIX_PROC_RANK))) {
         PMIX_ERROR_LOG(rc);
@@ -175,13 +210,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     }
 
     /* find the nspace object for this client */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(nspace);
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "%s:%d EXECUTE GET FOR %s:%d ON BEHALF OF %s:%d",
@@ -280,7 +309,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
         /* if we don't have direct modex feature, just respond with "not found" */
         cbfunc(PMIX_ERR_NOT_FOUND, NULL, 0, cbdata, NULL, NULL);
         PMIX_INFO_FREE(info, ninfo);
-        pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+        _local_req_remove(lcd);
         PMIX_LIST_DESTRUCT(&lcd->loc_reqs);
         PMIX_RELEASE(lcd);
         rc = PMIX_ERR_NOT_FOUND;
@@ -295,7 +324,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
                                           void *cbdata,
                                           pmix_dmdx_local_t **ld)
 {
-    pmix_dmdx_local_t *lcd, *cd;
+    pmix_dmdx_local_t *lcd;
     pmix_dmdx_request_t *req;
     pmix_status_t rc;
 
@@ -304,15 +333,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
 
     /* see if we already have an existing request for data
      * from this namespace/rank */
-    lcd = NULL;
-    PMIX_LIST_FOREACH(cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-        if (0 != strncmp(nspace, cd->proc.nspace, PMIX_MAX_NSLEN) ||
-                rank != cd->proc.rank ) {
-            continue;
-        }
-        lcd = cd;
-        break;
-    }
+    lcd = _local_req_find(nspace, rank);
     if (NULL != lcd) {
         /* we already have a request, so just track that someone
          * else wants data from the same target */
@@ -330,7 +351,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
     lcd->proc.rank = rank;
     lcd->info = info;
     lcd->ninfo = ninfo;
-    pmix_list_append(&pmix_server_globals.local_reqs, &lcd->super);
+    _local_req_add(lcd);
     rc = PMIX_ERR_NOT_FOUND;  // indicates that we created a new request tracker
 
   complete:
@@ -379,7 +400,7 @@ void pmix_pending_nspace_requests(pmix_nspace_t *nptr)
                     pmix_list_remove_item(&cd->loc_reqs, &req->super);
                     PMIX_RELEASE(req);
                 }
-                pmix_list_remove_item(&pmix_server_globals.local_reqs, &cd->super);
+                _local_req_remove(cd);
                 PMIX_RELEASE(cd);
             }
         }
@@ -426,6 +447,16 @@ static pmix_status_t _satisfy_request(pmix_nspace_t *nptr, pmix_rank_t rank,
             }
         }
     }
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    /* the client picks up the data of a remote proc from the dstore,
+     * so it is written there again only if the dstore lost it - the
+     * copy in the remote table is kept for that */
+    if (PMIX_RANK_UNDEF != rank && !local &&
+        PMIX_SUCCESS == pmix_dstore_rank_stored(nptr->nspace, rank)) {
+        hts[0] = NULL;
+        found++;
+    }
+#endif /* PMIX_ENABLE_DSTORE */
 
     if (NULL != scope) {
         *scope = local;
@@ -521,18 +552,9 @@ static pmix_status_t _satisfy_request(pmix_nspace_t *nptr, pmix_rank_t rank,
 pmix_status_t pmix_pending_resolve(pmix_nspace_t *nptr, pmix_rank_t rank,
                                    pmix_status_t status, pmix_dmdx_local_t *lcd)
 {
-    pmix_dmdx_local_t *cd;
-
     /* find corresponding request (if exists) */
     if (NULL == lcd && NULL != nptr) {
-        PMIX_LIST_FOREACH(cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-            if (0 != strncmp(nptr->nspace, cd->proc.nspace, PMIX_MAX_NSLEN) ||
-                    rank != cd->proc.rank) {
-                continue;
-            }
-            lcd = cd;
-            break;
-        }
+        lcd = _local_req_find(nptr->nspace, rank);
     }
 
     /* If somebody was interested in this rank */
@@ -558,7 +580,7 @@ pmix_status_t pmix_pending_resolve(pmix_nspace_t *nptr, pmix_rank_t rank,
             }
         }
         /* remove all requests to this rank and cleanup the corresponding structure */
-        pmix_list_remove_item(&pmix_server_globals.local_reqs, (pmix_list_item_t*)lcd);
+        _local_req_remove(lcd);
         PMIX_RELEASE(lcd);
     }
     return PMIX_SUCCESS;
@@ -569,7 +591,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
 {
     pmix_dmdx_reply_caddy_t *caddy = (pmix_dmdx_reply_caddy_t *)cbdata;
     pmix_kval_t *kp;
-    pmix_nspace_t *ns, *nptr;
+    pmix_nspace_t *nptr;
     pmix_status_t rc;
 
     pmix_output_verbose(2, pmix_globals.debug_output,
@@ -578,13 +600,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
                     caddy->lcd->proc.nspace, caddy->lcd->proc.rank);
 
     /* find the nspace object for this client */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strcmp(caddy->lcd->proc.nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(caddy->lcd->proc.nspace);
 
     if (NULL == nptr) {
         /* should be impossible */
@@ -616,6 +632,12 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
         if (PMIX_SUCCESS != (rc = pmix_hash_store(&nptr->server->remote, caddy->lcd->proc.rank, kp))) {
             PMIX_ERROR_LOG(rc);
         }
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+        /* and in the dstore, where the clients will look for it */
+        if (PMIX_SUCCESS != (rc = pmix_dstore_store(nptr->nspace, caddy->lcd->proc.rank, kp))) {
+            PMIX_ERROR_LOG(rc);
+        }
+#endif /* PMIX_ENABLE_DSTORE */
         PMIX_RELEASE(kp);  // maintain acctg
     }
 
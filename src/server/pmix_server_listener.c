@@ -420,7 +420,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     nptr = PMIX_NEW(pmix_nspace_t);
     (void)strncpy(nptr->nspace, cd->proc.nspace, PMIX_MAX_NSLEN);
     nptr->server = PMIX_NEW(pmix_server_nspace_t);
-    pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+    pmix_nspace_add(nptr);
     /* add this tool rank to the nspace */
     info = PMIX_NEW(pmix_rank_info_t);
     PMIX_RETAIN(nptr);
@@ -438,7 +438,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
         PMIX_RELEASE(pnd);
         PMIX_RELEASE(cd);
         PMIX_RELEASE(peer);
-        pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_remove(nptr);
         PMIX_RELEASE(nptr);  // will release the info object
         /* probably cannot send an error reply if we are out of memory */
         return;
@@ -474,13 +474,17 @@ static void cnct_cbfunc(pmix_status_t status,
 }
 
 /* Parse init-ack message:
- *    NSPACE<0><rank>VERSION<0>[CRED<0>]
+ *    NSPACE<0><rank>VERSION<0>[CRED<0>][<bfrop version>]
+ * clients only follow the credential with the newest buffer
+ * encoding they read if we told them we would answer, and then
+ * send an empty credential if they have none
  */
 static pmix_status_t parse_connect_ack (char *msg,
                                         pmix_listener_protocol_t protocol,
                                         int len,
                                         char **nspace, pmix_rank_t *rank,
-                                        char **version, char **cred)
+                                        char **version, char **cred,
+                                        bool *offered, uint8_t *bfrop_version)
 {
     int msglen;
 
@@ -514,12 +518,24 @@ static pmix_status_t parse_connect_ack (char *msg,
     }
 
     PMIX_STRNLEN(msglen, msg, len);
-    if (msglen < len)
+    if (msglen < len) {
         *cred = msg;
-    else {
+        msg += msglen + 1;
+        len -= msglen + 1;
+    } else {
         *cred = NULL;
     }
 
+    *offered = false;
+    *bfrop_version = PMIX_BFROP_BUFFER_V1;
+    if (NULL != *cred && 0 < len) {
+        *offered = true;
+        *bfrop_version = (uint8_t)msg[0];
+        if ('\0' == **cred) {
+            *cred = NULL;
+        }
+    }
+
     return PMIX_SUCCESS;
 }
 
@@ -534,13 +550,15 @@ static pmix_status_t pmix_server_authenticate(pmix_pending_connection_t *pnd,
     pmix_status_t rc;
     pmix_rank_t rank=PMIX_RANK_UNDEF;
     pmix_usock_hdr_t hdr;
-    pmix_nspace_t *nptr, *tmp;
+    pmix_nspace_t *nptr;
     pmix_rank_info_t *info;
     pmix_peer_t *psave = NULL;
     bool found;
     pmix_proc_t proc;
     uid_t uid;
     gid_t gid;
+    bool offered;
+    uint8_t bfrop_version;
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "RECV CONNECT ACK FROM PEER ON SOCKET %d",
@@ -575,7 +593,8 @@ static pmix_status_t pmix_server_authenticate(pmix_pending_connection_t *pnd,
         return PMIX_ERR_UNREACH;
     }
     if (PMIX_SUCCESS != (rc = parse_connect_ack(msg, pnd->protocol, hdr.nbytes, &nspace,
-                                                &rank, &version, &cred))) {
+                                                &rank, &version, &cred,
+                                                &offered, &bfrop_version))) {
         pmix_output_verbose(2, pmix_globals.debug_output,
                             "error parsing connect-ack from client ON SOCKET %d", pnd->sd);
         free(msg);
@@ -595,13 +614,7 @@ static pmix_status_t pmix_server_authenticate(pmix_pending_connection_t *pnd,
          * and so we will assume that all versions are compatible. */
 
         /* see if we know this nspace */
-        nptr = NULL;
-        PMIX_LIST_FOREACH(tmp, &pmix_globals.nspaces, pmix_nspace_t) {
-            if (0 == strcmp(tmp->nspace, nspace)) {
-                nptr = tmp;
-                break;
-            }
-        }
+        nptr = pmix_nspace_lookup(nspace);
         if (NULL == nptr) {
             /* we don't know this namespace, reject it */
             free(msg);
@@ -703,6 +716,20 @@ static pmix_status_t pmix_server_authenticate(pmix_pending_connection_t *pnd,
             PMIX_RELEASE(psave);
             return rc;
         }
+        /* if they offered a buffer encoding, tell them the one
+         * we will both use */
+        if (offered) {
+            if (PMIX_BFROP_BUFFER_NEWEST < bfrop_version) {
+                bfrop_version = PMIX_BFROP_BUFFER_NEWEST;
+            }
+            if (PMIX_SUCCESS != (rc = pmix_usock_send_blocking(pnd->sd, (char*)&bfrop_version, 1))) {
+                PMIX_ERROR_LOG(rc);
+                pmix_pointer_array_set_item(&pmix_server_globals.clients, psave->index, NULL);
+                PMIX_RELEASE(psave);
+                return rc;
+            }
+            psave->bfrop_version = bfrop_version;
+        }
 
         pmix_output_verbose(2, pmix_globals.debug_output,
                             "connect-ack from client completed");
@@ -45,17 +45,25 @@
 #endif
 #include PMIX_EVENT_HEADER
 
+#include "src/include/hash_string.h"
 #include "src/class/pmix_list.h"
 #include "src/buffer_ops/buffer_ops.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
+#include "src/util/timings.h"
+#include "src/util/compress.h"
+#include "src/runtime/pmix_rte.h"
 #include "src/usock/usock.h"
 #include "src/sec/pmix_sec.h"
 
 #include "pmix_server_ops.h"
 
+/* upper bound on the bytes a fence contribution adds to the
+ * blob passed to the host beyond its data and nspace name */
+#define PMIX_FENCE_RANK_OVERHEAD 64
+
 pmix_server_module_t pmix_host_server = {0};
 
 pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *buf,
@@ -121,6 +129,46 @@ pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *buf,
     return rc;
 }
 
+/* defer a request from a remote server for the data of one of
+ * our local procs until that proc commits it */
+void pmix_pending_remote_add(pmix_dmdx_remote_t *dcd)
+{
+    pmix_proc_t key;
+    pmix_list_t *reqs = NULL;
+
+    PMIX_PENDING_KEY(&key, dcd->cd->proc.nspace, dcd->cd->proc.rank);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_server_globals.remote_pnd,
+                                                      &key, sizeof(key), (void**)&reqs) ||
+        NULL == reqs) {
+        reqs = PMIX_NEW(pmix_list_t);
+        pmix_hash_table_set_value_ptr(&pmix_server_globals.remote_pnd,
+                                      &key, sizeof(key), reqs);
+    }
+    pmix_list_append(reqs, &dcd->super);
+    pmix_server_globals.nremote_pnd++;
+    if (pmix_server_globals.max_remote_pnd < pmix_server_globals.nremote_pnd) {
+        pmix_server_globals.max_remote_pnd = pmix_server_globals.nremote_pnd;
+    }
+}
+
+/* remove the requests waiting for the data of the given proc and
+ * return them, or NULL if there are none - the caller is responsible
+ * for releasing the list */
+pmix_list_t *pmix_pending_remote_take(const char *nspace, pmix_rank_t rank)
+{
+    pmix_proc_t key;
+    pmix_list_t *reqs = NULL;
+
+    PMIX_PENDING_KEY(&key, nspace, rank);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_server_globals.remote_pnd,
+                                                      &key, sizeof(key), (void**)&reqs)) {
+        return NULL;
+    }
+    pmix_hash_table_remove_value_ptr(&pmix_server_globals.remote_pnd, &key, sizeof(key));
+    pmix_server_globals.nremote_pnd -= pmix_list_get_size(reqs);
+    return reqs;
+}
+
 pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
 {
     int32_t cnt;
@@ -132,10 +180,11 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     pmix_nspace_t *nptr;
     pmix_rank_info_t *info;
     pmix_dmdx_remote_t *dcd, *dcdnext;
+    pmix_list_t *reqs;
     pmix_buffer_t *pbkt;
     pmix_value_t *val;
     char *data;
-    size_t sz;
+    size_t sz, newcap, *cap;
 
     /* shorthand */
     info = peer->info;
@@ -168,25 +217,33 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
             PMIX_ERROR_LOG(rc);
             return rc;
         }
-        /* see if we already have info for this proc */
-        if (PMIX_SUCCESS == pmix_hash_fetch(ht, info->rank, "modex", &val) && NULL != val) {
-            /* create the new data storage */
-            kp = PMIX_NEW(pmix_kval_t);
-            kp->key = strdup("modex");
-            PMIX_VALUE_CREATE(kp->value, 1);
-            kp->value->type = PMIX_BYTE_OBJECT;
-            /* get space for the new new data blob */
-            kp->value->data.bo.bytes = (char*)malloc(b2->bytes_used + val->data.bo.size);
-            memcpy(kp->value->data.bo.bytes, val->data.bo.bytes, val->data.bo.size);
-            memcpy(kp->value->data.bo.bytes+val->data.bo.size, b2->base_ptr, b2->bytes_used);
-            kp->value->data.bo.size = val->data.bo.size + b2->bytes_used;
-            /* release the storage */
-            PMIX_VALUE_FREE(val, 1);
-            /* store it in the appropriate hash */
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, info->rank, kp))) {
-                PMIX_ERROR_LOG(rc);
+        info->commit_bytes += b2->bytes_used;
+        /* see if we already have info for this proc - if so, append
+         * the new blob to it in place. The storage grows geometrically
+         * so a proc that commits over and over doesn't have all its
+         * prior data copied each time */
+        cap = (PMIX_LOCAL == scope) ? &info->local_cap : &info->remote_cap;
+        if (PMIX_SUCCESS == pmix_hash_fetch_ptr(ht, info->rank, "modex", &val) &&
+            NULL != val && PMIX_BYTE_OBJECT == val->type) {
+            if (*cap < val->data.bo.size) {
+                *cap = val->data.bo.size;
             }
-            PMIX_RELEASE(kp);  // maintain acctg
+            if (*cap < val->data.bo.size + b2->bytes_used) {
+                newcap = 2 * (*cap);
+                if (newcap < val->data.bo.size + b2->bytes_used) {
+                    newcap = val->data.bo.size + b2->bytes_used;
+                }
+                if (NULL == (data = (char*)realloc(val->data.bo.bytes, newcap))) {
+                    PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+                    PMIX_RELEASE(b2);
+                    return PMIX_ERR_NOMEM;
+                }
+                val->data.bo.bytes = data;
+                *cap = newcap;
+            }
+            memcpy(val->data.bo.bytes + val->data.bo.size, b2->base_ptr, b2->bytes_used);
+            val->data.bo.size += b2->bytes_used;
+            PMIX_RELEASE(b2);
         } else {
             /* create a new kval to hold this data */
             kp = PMIX_NEW(pmix_kval_t);
@@ -195,6 +252,7 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
             kp->value->type = PMIX_BYTE_OBJECT;
             PMIX_UNLOAD_BUFFER(b2, kp->value->data.bo.bytes, kp->value->data.bo.size);
             PMIX_RELEASE(b2);
+            *cap = kp->value->data.bo.size;
             /* store it in the appropriate hash */
             if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, info->rank, kp))) {
                 PMIX_ERROR_LOG(rc);
@@ -210,14 +268,17 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     rc = PMIX_SUCCESS;
     /* mark us as having successfully received a blob from this proc */
     info->modex_recvd = true;
+    info->ncommits++;
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "%s:%d COMMIT %lu FROM %s:%d: %lu BYTES COMMITTED IN TOTAL",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        (unsigned long)info->ncommits, nptr->nspace, info->rank,
+                        (unsigned long)info->commit_bytes);
 
     /* see if anyone remote is waiting on this data - could be more than one */
-    PMIX_LIST_FOREACH_SAFE(dcd, dcdnext, &pmix_server_globals.remote_pnd, pmix_dmdx_remote_t) {
-        if (0 != strncmp(dcd->cd->proc.nspace, nptr->nspace, PMIX_MAX_NSLEN)) {
-            continue;
-        }
-        if (dcd->cd->proc.rank == info->rank) {
-           /* we can now fulfill this request - collect the
+    if (NULL != (reqs = pmix_pending_remote_take(nptr->nspace, info->rank))) {
+        PMIX_LIST_FOREACH_SAFE(dcd, dcdnext, reqs, pmix_dmdx_remote_t) {
+            /* we can now fulfill this request - collect the
              * remote/global data from this proc */
             pbkt = PMIX_NEW(pmix_buffer_t);
             /* get any remote contribution - note that there
@@ -235,14 +296,71 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
                 free(data);
             }
             /* we have finished this request */
-            pmix_list_remove_item(&pmix_server_globals.remote_pnd, &dcd->super);
+            pmix_list_remove_item(reqs, &dcd->super);
             PMIX_RELEASE(dcd);
         }
+        PMIX_RELEASE(reqs);
     }
     /* see if anyone local is waiting on this data- could be more than one */
     return pmix_pending_resolve(nptr, info->rank, PMIX_SUCCESS, NULL);
 }
 
+static int proc_cmp(const void *a, const void *b)
+{
+    const pmix_proc_t *p1 = (const pmix_proc_t*)a;
+    const pmix_proc_t *p2 = (const pmix_proc_t*)b;
+    int rc;
+
+    if (0 != (rc = strncmp(p1->nspace, p2->nspace, PMIX_MAX_NSLEN))) {
+        return rc;
+    }
+    if (p1->rank < p2->rank) {
+        return -1;
+    }
+    return (p1->rank > p2->rank) ? 1 : 0;
+}
+
+/* sort the procs into canonical order and compute the signature
+ * of the collective from them - the signature does not depend
+ * on the order in which the caller listed the participants */
+static uint64_t tracker_signature(pmix_proc_t *procs, size_t nprocs,
+                                  pmix_cmd_t type)
+{
+    uint64_t sig = 14695981039346656037ULL;
+    uint32_t h = 0;
+    size_t i;
+
+    qsort(procs, nprocs, sizeof(pmix_proc_t), proc_cmp);
+    sig = (sig ^ (uint64_t)type) * 1099511628211ULL;
+    for (i=0; i < nprocs; i++) {
+        /* the procs are grouped by nspace, so only hash each once */
+        if (0 == i || 0 != strncmp(procs[i].nspace, procs[i-1].nspace, PMIX_MAX_NSLEN)) {
+            PMIX_HASH_STR(procs[i].nspace, h);
+        }
+        sig = (sig ^ (((uint64_t)h << 32) | procs[i].rank)) * 1099511628211ULL;
+    }
+    return sig;
+}
+
+/* check if the tracker is for the given collective - the procs
+ * must already be in canonical order */
+static bool tracker_match(pmix_server_trkr_t *trk, pmix_proc_t *procs,
+                          size_t nprocs, pmix_cmd_t type, uint64_t sig)
+{
+    size_t i;
+
+    if (sig != trk->sig || nprocs != trk->npcs || type != trk->type) {
+        return false;
+    }
+    for (i=0; i < nprocs; i++) {
+        if (procs[i].rank != trk->pcs[i].rank ||
+            0 != strncmp(procs[i].nspace, trk->pcs[i].nspace, PMIX_MAX_NSLEN)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /* get an existing object for tracking LOCAL participation in a collective
  * operation such as "fence". The only way this function can be
  * called is if at least one local client process is participating
@@ -256,15 +374,14 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
  * us already knowing about all local participants.
  *
  * procs - the array of procs participating in the collective,
- *         regardless of location
+ *         regardless of location - it is sorted in place
  * nprocs - the number of procs in the array
  */
 static pmix_server_trkr_t* get_tracker(pmix_proc_t *procs,
                                        size_t nprocs, pmix_cmd_t type)
 {
-    pmix_server_trkr_t *trk;
-    size_t i, j;
-    size_t matches;
+    pmix_server_trkr_t *trk = NULL;
+    uint64_t sig;
 
     pmix_output_verbose(5, pmix_globals.debug_output,
                         "get_tracker called with %d procs", (int)nprocs);
@@ -275,35 +392,23 @@ static pmix_server_trkr_t* get_tracker(pmix_proc_t *procs,
         return NULL;
     }
 
-    /* there is no shortcut way to search the trackers - all
-     * we can do is perform a brute-force search. Fortunately,
-     * it is highly unlikely that there will be more than one
-     * or two active at a time, and they are most likely to
-     * involve only a single proc with WILDCARD rank - so this
-     * shouldn't take long */
+    /* Collective operation if unique identified by
+     * the set of participating processes and the type of collective.
+     * The procs may be in different order, so put them in canonical
+     * order and look the tracker up by the signature of the set */
+    sig = tracker_signature(procs, nprocs, type);
+    pmix_hash_table_get_value_uint64(&pmix_server_globals.trackers, sig, (void**)&trk);
+    if (NULL == trk) {
+        /* No tracker was found */
+        return NULL;
+    }
+    if (tracker_match(trk, procs, nprocs, type, sig)) {
+        return trk;
+    }
+    /* another collective has the same signature - all we can
+     * do is perform a brute-force search */
     PMIX_LIST_FOREACH(trk, &pmix_server_globals.collectives, pmix_server_trkr_t) {
-        /* Collective operation if unique identified by
-         * the set of participating processes and the type of collective
-         */
-        if (nprocs != trk->npcs) {
-            continue;
-        }
-        if (type != trk->type) {
-            continue;
-        }
-        matches = 0;
-        for (i=0; i < nprocs; i++) {
-            /* the procs may be in different order, so we have
-             * to do an exhaustive search */
-            for (j=0; j < trk->npcs; j++) {
-                if (0 == strcmp(procs[i].nspace, trk->pcs[j].nspace) &&
-                    procs[i].rank == trk->pcs[j].rank) {
-                    ++matches;
-                    break;
-                }
-            }
-        }
-        if (trk->npcs == matches) {
+        if (tracker_match(trk, procs, nprocs, type, sig)) {
             return trk;
         }
     }
@@ -324,7 +429,7 @@ static pmix_server_trkr_t* get_tracker(pmix_proc_t *procs,
  * us already knowing about all local participants.
  *
  * procs - the array of procs participating in the collective,
- *         regardless of location
+ *         regardless of location - it is sorted in place
  * nprocs - the number of procs in the array
  */
 static pmix_server_trkr_t* new_tracker(pmix_proc_t *procs,
@@ -334,7 +439,8 @@ static pmix_server_trkr_t* new_tracker(pmix_proc_t *procs,
     pmix_rank_info_t *iptr, *info;
     size_t i;
     bool all_def;
-    pmix_nspace_t *nptr, *ns;
+    pmix_nspace_t *nptr = NULL;
+    pmix_server_trkr_t *t;
 
     pmix_output_verbose(5, pmix_globals.debug_output,
                         "new_tracker called with %d procs", (int)nprocs);
@@ -353,22 +459,20 @@ static pmix_server_trkr_t* new_tracker(pmix_proc_t *procs,
     /* get here if this tracker is new - create it */
     trk = PMIX_NEW(pmix_server_trkr_t);
 
-    /* copy the procs */
+    /* copy the procs - they are in canonical order */
     PMIX_PROC_CREATE(trk->pcs, nprocs);
     trk->npcs = nprocs;
     trk->type = type;
+    trk->sig = tracker_signature(procs, nprocs, type);
 
     all_def = true;
     for (i=0; i < nprocs; i++) {
         (void)strncpy(trk->pcs[i].nspace, procs[i].nspace, PMIX_MAX_NSLEN);
         trk->pcs[i].rank = procs[i].rank;
-        /* is this nspace known to us? */
-        nptr = NULL;
-        PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
-            if (0 == strcmp(procs[i].nspace, ns->nspace)) {
-                nptr = ns;
-                break;
-            }
+        /* is this nspace known to us? The procs are grouped
+         * by nspace, so only look it up when it changes */
+        if (0 == i || 0 != strncmp(procs[i].nspace, procs[i-1].nspace, PMIX_MAX_NSLEN)) {
+            nptr = pmix_nspace_lookup(procs[i].nspace);
         }
         if (NULL == nptr) {
             /* cannot be a local proc */
@@ -413,9 +517,209 @@ static pmix_server_trkr_t* new_tracker(pmix_proc_t *procs,
         trk->def_complete = true;
     }
     pmix_list_append(&pmix_server_globals.collectives, &trk->super);
+    /* index it unless another collective already holds the signature */
+    t = NULL;
+    pmix_hash_table_get_value_uint64(&pmix_server_globals.trackers, trk->sig, (void**)&t);
+    if (NULL == t) {
+        pmix_hash_table_set_value_uint64(&pmix_server_globals.trackers, trk->sig, trk);
+    }
     return trk;
 }
 
+/* remove a tracker from the list of active collectives - the
+ * caller is responsible for releasing it */
+void pmix_server_remove_tracker(pmix_server_trkr_t *trk)
+{
+    pmix_server_trkr_t *t = NULL;
+
+    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    pmix_hash_table_get_value_uint64(&pmix_server_globals.trackers, trk->sig, (void**)&t);
+    if (t != trk) {
+        return;
+    }
+    pmix_hash_table_remove_value_uint64(&pmix_server_globals.trackers, trk->sig);
+    /* hand the signature to any other collective sharing it */
+    PMIX_LIST_FOREACH(t, &pmix_server_globals.collectives, pmix_server_trkr_t) {
+        if (t->sig == trk->sig) {
+            pmix_hash_table_set_value_uint64(&pmix_server_globals.trackers, t->sig, t);
+            break;
+        }
+    }
+}
+
+/* the distinct kvals of a fence contribution */
+typedef struct {
+    pmix_hash_table_t idx;      // index into kvs by the packed kval
+    pmix_byte_object_t *kvs;    // the packed kvals - these point into the rank blobs
+    uint32_t nkvs;
+    uint32_t size;
+    size_t nrefs;               // number of kvals in the rank blobs
+    size_t nbytes;              // bytes of all the kvals in the rank blobs
+} intern_dict_t;
+
+/* return the index of the len packed bytes of a kval in the
+ * dictionary, adding them if they aren't there yet */
+static pmix_status_t intern_kval(intern_dict_t *dict, char *bytes, size_t len, uint32_t *n)
+{
+    pmix_byte_object_t *tmp;
+    void *ptr;
+
+    dict->nrefs++;
+    dict->nbytes += len;
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&dict->idx, bytes, len, &ptr)) {
+        *n = (uint32_t)(uintptr_t)ptr;
+        return PMIX_SUCCESS;
+    }
+    if (dict->nkvs == dict->size) {
+        dict->size = (0 == dict->size) ? 256 : 2 * dict->size;
+        if (NULL == (tmp = (pmix_byte_object_t*)realloc(dict->kvs, dict->size * sizeof(pmix_byte_object_t)))) {
+            return PMIX_ERR_NOMEM;
+        }
+        dict->kvs = tmp;
+    }
+    dict->kvs[dict->nkvs].bytes = bytes;
+    dict->kvs[dict->nkvs].size = len;
+    *n = dict->nkvs++;
+    return pmix_hash_table_set_value_ptr(&dict->idx, bytes, len, (void*)(uintptr_t)*n);
+}
+
+/* pack the kvals of a rank blob as their indices in the dictionary */
+static pmix_status_t intern_blob(intern_dict_t *dict, pmix_buffer_t *bucket,
+                                 pmix_byte_object_t *blob)
+{
+    pmix_buffer_t view;
+    char *start;
+    uint32_t n;
+    int32_t cnt;
+    size_t off;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    /* walk the packed kvals in place - we only need to know where
+     * each one ends, so step over them rather than unpack them */
+    PMIX_CONSTRUCT(&view, pmix_buffer_t);
+    view.base_ptr = blob->bytes;
+    view.bytes_used = blob->size;
+    view.unpack_ptr = view.base_ptr;
+    view.pack_ptr = view.base_ptr + view.bytes_used;
+    pmix_bfrop.open_nested(bucket, 0, &off);
+    while (view.unpack_ptr < view.pack_ptr) {
+        start = view.unpack_ptr;
+        cnt = 1;
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.skip(&view, &cnt, PMIX_KVAL))) {
+            break;
+        }
+        if (PMIX_SUCCESS != (rc = intern_kval(dict, start, view.unpack_ptr - start, &n)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(bucket, &n, 1, PMIX_UINT32))) {
+            break;
+        }
+    }
+    pmix_bfrop.close_nested(bucket, off);
+    view.base_ptr = NULL;
+    view.bytes_used = 0;
+    PMIX_DESTRUCT(&view);
+    return rc;
+}
+
+/* pack the local contributions to the collective modex data with
+ * each distinct kval held just once - the rank blobs are laid out
+ * as usual except that they carry the indices of their kvals, and
+ * they are followed by the kvals themselves */
+static pmix_status_t intern_contribution(pmix_server_trkr_t *trk, pmix_buffer_t *bucket)
+{
+    intern_dict_t dict;
+    pmix_rank_info_t *rkinfo;
+    pmix_value_t *val;
+    char *nspace;
+    size_t dboff, rkoff, dbytes = 0;
+    uint32_t n;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    memset(&dict, 0, sizeof(dict));
+    PMIX_CONSTRUCT(&dict.idx, pmix_hash_table_t);
+    pmix_hash_table_init(&dict.idx, 256);
+
+    pmix_bfrop.open_nested(bucket, 0, &dboff);
+    PMIX_LIST_FOREACH(rkinfo, &trk->ranks, pmix_rank_info_t) {
+        if (PMIX_SUCCESS != pmix_hash_fetch_ptr(&rkinfo->nptr->server->myremote, rkinfo->rank, "modex", &val) ||
+            NULL == val) {
+            continue;
+        }
+        pmix_bfrop.open_nested(bucket, 0, &rkoff);
+        nspace = rkinfo->nptr->nspace;
+        pmix_bfrop.pack(bucket, &nspace, 1, PMIX_STRING);
+        pmix_bfrop.pack(bucket, &rkinfo->rank, 1, PMIX_PROC_RANK);
+        rc = intern_blob(&dict, bucket, &val->data.bo);
+        pmix_bfrop.close_nested(bucket, rkoff);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto cleanup;
+        }
+    }
+    pmix_bfrop.close_nested(bucket, dboff);
+
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(bucket, &dict.nkvs, 1, PMIX_UINT32)) ||
+        (0 < dict.nkvs &&
+         PMIX_SUCCESS != (rc = pmix_bfrop.pack(bucket, dict.kvs, dict.nkvs, PMIX_BYTE_OBJECT)))) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (n=0; n < dict.nkvs; n++) {
+        dbytes += dict.kvs[n].size;
+    }
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "fence - %lu kvals of %lu bytes interned as %lu distinct ones of %lu bytes",
+                        (unsigned long)dict.nrefs, (unsigned long)dict.nbytes,
+                        (unsigned long)dict.nkvs, (unsigned long)dbytes);
+
+  cleanup:
+    if (NULL != dict.kvs) {
+        free(dict.kvs);
+    }
+    PMIX_DESTRUCT(&dict.idx);
+    return rc;
+}
+
+/* replace everything that follows the collection type in a fence
+ * contribution by its compressed form, if that makes it smaller */
+static void compress_contribution(char **data, size_t *sz, size_t hdr,
+                                  unsigned char ctype)
+{
+    pmix_buffer_t bucket;
+    pmix_byte_object_t bo;
+    uint8_t *cdata;
+    size_t csize, usize;
+    pmix_status_t rc;
+
+    ctype |= PMIX_COLLECT_COMPRESSED;
+    usize = *sz - hdr;
+    if (PMIX_SUCCESS != (rc = pmix_compress_block((uint8_t*)*data + hdr, usize, &cdata, &csize))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "fence - %lu bytes not compressed: %d",
+                            (unsigned long)usize, rc);
+        return;
+    }
+    PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+    bo.bytes = (char*)cdata;
+    bo.size = csize;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.reserve(&bucket, csize + PMIX_FENCE_RANK_OVERHEAD)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&bucket, &ctype, 1, PMIX_BYTE)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&bucket, &usize, 1, PMIX_SIZE)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&bucket, &bo, 1, PMIX_BYTE_OBJECT))) {
+        PMIX_ERROR_LOG(rc);
+        free(cdata);
+        PMIX_DESTRUCT(&bucket);
+        return;
+    }
+    free(cdata);
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "fence - compressed %lu bytes to %lu (ratio %.2f)",
+                        (unsigned long)usize, (unsigned long)csize,
+                        (double)usize / (double)csize);
+    free(*data);
+    PMIX_UNLOAD_BUFFER(&bucket, *data, *sz);
+    PMIX_DESTRUCT(&bucket);
+}
+
 pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
                                 pmix_buffer_t *buf,
                                 pmix_modex_cbfunc_t modexcbfunc,
@@ -434,6 +738,8 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
     pmix_value_t *val;
     pmix_info_t *info = NULL;
     size_t ninfo=0, n;
+    size_t dboff, rkoff, hdr;
+    PMIX_TIMING_DECLARE(tm)
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "recvd FENCE");
@@ -539,6 +845,9 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
      * notified when we are done */
     PMIX_RETAIN(cd);
     pmix_list_append(&trk->local_cbs, &cd->super);
+    if (1 == pmix_list_get_size(&trk->local_cbs)) {
+        trk->ts[PMIX_FENCE_TS_FIRST] = pmix_timing_now();
+    }
     /* if all local contributions have been received,
      * let the local host's server know that we are at the
      * "fence" point - they will callback once the barrier
@@ -547,6 +856,7 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
         pmix_list_get_size(&trk->local_cbs) == trk->nlocal) {
         pmix_output_verbose(2, pmix_globals.debug_output,
                             "fence complete");
+        trk->ts[PMIX_FENCE_TS_LAST] = pmix_timing_now();
         /* if the user asked us to collect data, then we have
          * to provide any locally collected data to the host
          * server so they can circulate it - only take data
@@ -554,48 +864,86 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
          * participating! And only take data intended for remote
          * distribution */
 
+        PMIX_TIMING_INIT(&tm);
+        PMIX_TIMING_MSTART((&tm, "fence: assemble %d local contributions", (int)trk->nlocal));
         PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
 
         assert( PMIX_COLLECT_MAX < UCHAR_MAX );
         unsigned char tmp = (unsigned char)trk->collect_type;
+        if (PMIX_COLLECT_YES == trk->collect_type && pmix_server_globals.dedup_modex) {
+            tmp |= PMIX_COLLECT_INTERNED;
+        }
         pmix_bfrop.pack(&bucket, &tmp, 1, PMIX_BYTE);
+        hdr = bucket.bytes_used;
 
-        if (PMIX_COLLECT_YES == trk->collect_type) {
-            pmix_buffer_t databuf;
-            PMIX_CONSTRUCT(&databuf, pmix_buffer_t);
+        if (PMIX_COLLECT_INTERNED & tmp) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                                "fence - interning data");
+            if (PMIX_SUCCESS != intern_contribution(trk, &bucket)) {
+                /* just pass the data on as it is */
+                PMIX_DESTRUCT(&bucket);
+                PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+                tmp = (unsigned char)trk->collect_type;
+                pmix_bfrop.pack(&bucket, &tmp, 1, PMIX_BYTE);
+            }
+        }
+        if (PMIX_COLLECT_YES == tmp) {
             pmix_output_verbose(2, pmix_globals.debug_output,
                                 "fence - assembling data");
+            /* size the contributions so the blob is allocated once */
+            sz = 0;
+            PMIX_LIST_FOREACH(rkinfo, &trk->ranks, pmix_rank_info_t) {
+                if (PMIX_SUCCESS == pmix_hash_fetch_ptr(&rkinfo->nptr->server->myremote, rkinfo->rank, "modex", &val) &&
+                    NULL != val) {
+                    sz += val->data.bo.size + strlen(rkinfo->nptr->nspace) + PMIX_FENCE_RANK_OVERHEAD;
+                }
+            }
+            /* each contribution is packed in place as a buffer holding
+             * the source proc and the proc's data, all within the one
+             * buffer passed up - the data is copied only once */
+            pmix_bfrop.open_nested(&bucket, sz, &dboff);
             PMIX_LIST_FOREACH(rkinfo, &trk->ranks, pmix_rank_info_t) {
-                pmix_buffer_t rankbuf;
-                PMIX_CONSTRUCT(&rankbuf, pmix_buffer_t);
                 /* get any remote contribution - note that there
                  * may not be a contribution */
-                if (PMIX_SUCCESS == pmix_hash_fetch(&rkinfo->nptr->server->myremote, rkinfo->rank, "modex", &val) &&
+                if (PMIX_SUCCESS == pmix_hash_fetch_ptr(&rkinfo->nptr->server->myremote, rkinfo->rank, "modex", &val) &&
                     NULL != val) {
+                    pmix_bfrop.open_nested(&bucket, 0, &rkoff);
                     /* pack the proc so we know the source */
                     char *foobar = rkinfo->nptr->nspace;
-                    pmix_bfrop.pack(&rankbuf, &foobar, 1, PMIX_STRING);
-                    pmix_bfrop.pack(&rankbuf, &rkinfo->rank, 1, PMIX_PROC_RANK);
+                    pmix_bfrop.pack(&bucket, &foobar, 1, PMIX_STRING);
+                    pmix_bfrop.pack(&bucket, &rkinfo->rank, 1, PMIX_PROC_RANK);
+                    /* the value stays in the table, so just point at it */
                     PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
-                    PMIX_LOAD_BUFFER(&xfer, val->data.bo.bytes, val->data.bo.size);
-                    PMIX_VALUE_RELEASE(val);
+                    xfer.base_ptr = val->data.bo.bytes;
+                    xfer.bytes_used = val->data.bo.size;
                     pmix_buffer_t *pxfer = &xfer;
-                    pmix_bfrop.pack(&rankbuf, &pxfer, 1, PMIX_BUFFER);
+                    pmix_bfrop.pack(&bucket, &pxfer, 1, PMIX_BUFFER);
+                    xfer.base_ptr = NULL;
+                    xfer.bytes_used = 0;
                     PMIX_DESTRUCT(&xfer);
-                    /* now pack this proc's contribution into the bucket */
-                    pmix_buffer_t *pdatabuf = &rankbuf;
-                    pmix_bfrop.pack(&databuf, &pdatabuf, 1, PMIX_BUFFER);
+                    pmix_bfrop.close_nested(&bucket, rkoff);
                 }
-                PMIX_DESTRUCT(&rankbuf);
             }
-            // TODO: we have multiple data movings while only one is actually need
-            pmix_buffer_t *pbkt = &databuf;
-            pmix_bfrop.pack(&bucket, &pbkt, 1, PMIX_BUFFER);
-            PMIX_DESTRUCT(&databuf);
+            pmix_bfrop.close_nested(&bucket, dboff);
         }
 
         PMIX_UNLOAD_BUFFER(&bucket, data, sz);
         PMIX_DESTRUCT(&bucket);
+        /* compress the data if the host can carry it that way - every
+         * server decompresses whatever comes back to it, so it only
+         * has to be sure that all the others are able to */
+        if (PMIX_COLLECT_YES == trk->collect_type &&
+            pmix_server_globals.compress_modex &&
+            pmix_server_globals.compress_min <= sz - hdr) {
+            PMIX_TIMING_MNEXT((&tm, "fence: compress %lu bytes", (unsigned long)(sz - hdr)));
+            compress_contribution(&data, &sz, hdr, tmp);
+        }
+        PMIX_TIMING_MSTOP(&tm);
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "fence - passing %lu bytes to the host", (unsigned long)sz);
+        PMIX_TIMING_DELTAS(true, &tm);
+        PMIX_TIMING_RELEASE(&tm);
+        trk->ts[PMIX_FENCE_TS_HOST] = pmix_timing_now();
         pmix_host_server.fence_nb(trk->pcs, trk->npcs,
                                   trk->info, trk->ninfo,
                                   data, sz, trk->modexcbfunc, trk);
@@ -696,12 +1044,11 @@ pmix_status_t pmix_server_lookup(pmix_peer_t *peer,
     /* unpack the array of keys */
     for (i=0; i < nkeys; i++) {
         cnt=1;
-        if  (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(buf, &sptr, &cnt, PMIX_STRING))) {
+        if  (PMIX_SUCCESS != (rc = pmix_bfrop.unpack_view(buf, &sptr, &cnt, PMIX_STRING))) {
             PMIX_ERROR_LOG(rc);
             goto cleanup;
         }
         pmix_argv_append_nosize(&keys, sptr);
-        free(sptr);
     }
     /* unpack the number of info objects */
     cnt=1;
@@ -769,12 +1116,11 @@ pmix_status_t pmix_server_unpublish(pmix_peer_t *peer,
     /* unpack the keys */
     for (i=0; i < nkeys; i++) {
         cnt=1;
-        if  (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(buf, &sptr, &cnt, PMIX_STRING))) {
+        if  (PMIX_SUCCESS != (rc = pmix_bfrop.unpack_view(buf, &sptr, &cnt, PMIX_STRING))) {
             PMIX_ERROR_LOG(rc);
             goto cleanup;
         }
         pmix_argv_append_nosize(&keys, sptr);
-        free(sptr);
     }
     /* unpack the number of info objects */
     cnt=1;
@@ -1316,6 +1662,40 @@ pmix_status_t pmix_server_event_recvd_from_client(pmix_peer_t *peer,
     return rc;
 }
 
+pmix_status_t pmix_server_query_local(pmix_query_t queries[], size_t nqueries,
+                                      pmix_info_t **info, size_t *ninfo)
+{
+    size_t n, m, nkeys = 0;
+    char *stats;
+
+    *info = NULL;
+    *ninfo = 0;
+    for (n=0; n < nqueries; n++) {
+        for (m=0; NULL != queries[n].keys && NULL != queries[n].keys[m]; m++) {
+            if (0 != strcmp(queries[n].keys[m], PMIX_QUERY_FENCE_STATS)) {
+                return PMIX_ERR_NOT_FOUND;
+            }
+            nkeys++;
+        }
+    }
+    if (0 == nkeys) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    PMIX_INFO_CREATE(*info, nkeys);
+    *ninfo = nkeys;
+    for (n=0; n < nkeys; n++) {
+        if (NULL == (stats = pmix_server_fence_stats())) {
+            PMIX_INFO_FREE(*info, *ninfo);
+            *ninfo = 0;
+            return PMIX_ERR_NOMEM;
+        }
+        PMIX_INFO_LOAD(&(*info)[n], PMIX_QUERY_FENCE_STATS, stats, PMIX_STRING);
+        free(stats);
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_server_query(pmix_peer_t *peer,
                                 pmix_buffer_t *buf,
                                 pmix_info_cbfunc_t cbfunc,
@@ -1325,14 +1705,12 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
     pmix_status_t rc;
     pmix_query_caddy_t *cd;
     pmix_proc_t proc;
+    pmix_info_t *info;
+    size_t ninfo;
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "recvd query from client");
 
-    if (NULL == pmix_host_server.query) {
-        return PMIX_ERR_NOT_SUPPORTED;
-    }
-
     cd = PMIX_NEW(pmix_query_caddy_t);
     cd->cbdata = cbdata;
     /* unpack the number of queries */
@@ -1351,6 +1729,18 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
         }
     }
 
+    /* we may know the answers ourselves */
+    if (PMIX_SUCCESS == pmix_server_query_local(cd->queries, cd->nqueries, &info, &ninfo)) {
+        cbfunc(PMIX_SUCCESS, info, ninfo, cd, NULL, NULL);
+        PMIX_INFO_FREE(info, ninfo);
+        return PMIX_SUCCESS;
+    }
+
+    if (NULL == pmix_host_server.query) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        goto exit;
+    }
+
     /* setup the requesting peer name */
     (void)strncpy(proc.nspace, peer->info->nptr->nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->rank;
@@ -1363,6 +1753,9 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
     return PMIX_SUCCESS;
 
   exit:
+    if (NULL != cd->queries) {
+        PMIX_QUERY_FREE(cd->queries, cd->nqueries);
+    }
     PMIX_RELEASE(cd);
     return rc;
 }
@@ -1443,10 +1836,63 @@ pmix_status_t pmix_server_log(pmix_peer_t *peer,
 
 
 /*****    INSTANCE SERVER LIBRARY CLASSES    *****/
+static const char *fence_phases[PMIX_FENCE_PHASES] = {
+    "arrive",       // first to last local participant
+    "assemble",     // last local participant to hand-off to the host
+    "host",         // hand-off to the host's callback
+    "ingest",       // host's callback to the reply to the participants
+    "total"
+};
+
+void pmix_server_fence_stats_add(pmix_server_trkr_t *trk)
+{
+    int n;
+
+    /* the tracker has to have made it through all the steps */
+    for (n=0; n < PMIX_FENCE_TS_MAX; n++) {
+        if (0 == trk->ts[n]) {
+            return;
+        }
+    }
+    for (n=0; n < PMIX_FENCE_PHASES - 1; n++) {
+        pmix_timing_hist_add(&pmix_server_globals.fence_hist[n],
+                             trk->ts[n+1] - trk->ts[n]);
+    }
+    pmix_timing_hist_add(&pmix_server_globals.fence_hist[PMIX_FENCE_PHASES - 1],
+                         trk->ts[PMIX_FENCE_TS_DONE] - trk->ts[PMIX_FENCE_TS_FIRST]);
+}
+
+char *pmix_server_fence_stats(void)
+{
+    char *str = NULL, *line, *tmp;
+    int n, rc;
+
+    for (n=0; n < PMIX_FENCE_PHASES; n++) {
+        if (NULL == (line = pmix_timing_hist_print(&pmix_server_globals.fence_hist[n],
+                                                   fence_phases[n]))) {
+            free(str);
+            return NULL;
+        }
+        if (NULL == str) {
+            str = line;
+            continue;
+        }
+        rc = asprintf(&tmp, "%s\n%s", str, line);
+        free(str);
+        free(line);
+        if (0 > rc) {
+            return NULL;
+        }
+        str = tmp;
+    }
+    return str;
+}
+
 static void tcon(pmix_server_trkr_t *t)
 {
     t->pcs = NULL;
     t->npcs = 0;
+    t->sig = 0;
     t->active = true;
     t->def_complete = false;
     PMIX_CONSTRUCT(&t->ranks, pmix_list_t);
@@ -1459,6 +1905,7 @@ static void tcon(pmix_server_trkr_t *t)
     t->collect_type = PMIX_COLLECT_INVALID;
     t->modexcbfunc = NULL;
     t->op_cbfunc = NULL;
+    memset(t->ts, 0, sizeof(t->ts));
 }
 static void tdes(pmix_server_trkr_t *t)
 {
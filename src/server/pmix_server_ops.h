@@ -21,6 +21,7 @@
 #include <pmix_server.h>
 #include "src/usock/usock.h"
 #include "src/util/hash.h"
+#include "src/util/timings.h"
 
 typedef struct {
     pmix_object_t super;
@@ -137,11 +138,39 @@ typedef struct pmix_listener_t {
 } pmix_listener_t;
 PMIX_CLASS_DECLARATION(pmix_listener_t);
 
+/* default for the smallest collective modex data that is compressed
+ * when the host supports it - see PMIX_SERVER_COMPRESS_MIN */
+#define PMIX_SERVER_COMPRESS_MIN_DEFAULT 4096
+
+/* flag or'ed into the collection type that leads each server's
+ * contribution to the collective modex data when the rest of
+ * the contribution is compressed */
+#define PMIX_COLLECT_COMPRESSED 0x40
+
+/* flag or'ed into the collection type when the contribution holds
+ * each distinct key and value only once, and the rank blobs refer
+ * to them by their index */
+#define PMIX_COLLECT_INTERNED 0x20
+
+/* the phases of a fence the server keeps latency histograms of - each
+ * one runs from the timestamp of its index to the next one, except for
+ * the last that covers the whole fence */
+#define PMIX_FENCE_PHASES PMIX_FENCE_TS_MAX
+
+/* upper bound on the bytes packing a pmix_kval_t adds beyond its
+ * key and data - used to size buffers before packing into them */
+#define PMIX_KVAL_PACK_OVERHEAD 48
+
 typedef struct {
     pmix_pointer_array_t clients;           // array of pmix_peer_t local clients
     pmix_list_t collectives;                // list of active pmix_server_trkr_t
-    pmix_list_t remote_pnd;                 // list of pmix_dmdx_remote_t awaiting arrival of data fror servicing remote req's
+    pmix_hash_table_t trackers;             // index of the collectives by signature
+    pmix_hash_table_t remote_pnd;           // lists of pmix_dmdx_remote_t awaiting arrival of data fror servicing remote req's, by proc
+    size_t nremote_pnd;                     // #requests in remote_pnd
+    size_t max_remote_pnd;                  // high-water mark of nremote_pnd
     pmix_list_t local_reqs;                 // list of pmix_dmdx_local_t awaiting arrival of data from local neighbours
+    pmix_hash_table_t local_idx;            // index of local_reqs by proc
+    size_t max_local_reqs;                  // high-water mark of the length of local_reqs
     volatile bool listen_thread_active;     // listen thread is running
     pmix_list_t listeners;                  // list of pmix_listener_t
     int stop_thread[2];                     // pipe used to stop listener thread
@@ -149,6 +178,11 @@ typedef struct {
     pmix_list_t events;                     // list of pmix_regevents_info_t registered events
     pmix_ring_buffer_t notifications;       // ring buffer of pending notifications
     bool tool_connections_allowed;
+    bool compress_modex;                    // compress the collective modex data handed to the host
+    size_t compress_min;                    // smallest collective modex data worth compressing
+    bool dedup_modex;                       // send identical keys and values in the collective modex data once
+    pmix_timing_hist_t fence_hist[PMIX_FENCE_PHASES];   // latencies of the phases of the completed fences
+    bool fence_stats;                       // report fence_hist at finalize
 } pmix_server_globals_t;
 
 typedef struct {
@@ -221,6 +255,17 @@ void pmix_stop_listening(void);
 
 bool pmix_server_trk_update(pmix_server_trkr_t *trk);
 
+/* the key under which the pending requests for the data
+ * of a proc are indexed */
+#define PMIX_PENDING_KEY(k, n, r)                           \
+    do {                                                    \
+        memset((k), 0, sizeof(pmix_proc_t));                \
+        (void)strncpy((k)->nspace, (n), PMIX_MAX_NSLEN);    \
+        (k)->rank = (r);                                    \
+    } while (0)
+
+void pmix_pending_remote_add(pmix_dmdx_remote_t *dcd);
+pmix_list_t *pmix_pending_remote_take(const char *nspace, pmix_rank_t rank);
 void pmix_pending_nspace_requests(pmix_nspace_t *nptr);
 pmix_status_t pmix_pending_resolve(pmix_nspace_t *nptr, pmix_rank_t rank,
                                    pmix_status_t status, pmix_dmdx_local_t *lcd);
@@ -288,6 +333,11 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
                                 pmix_info_cbfunc_t cbfunc,
                                 void *cbdata);
 
+/* answer the queries the server can answer by itself - returns
+ * PMIX_ERR_NOT_FOUND if any of them has to go to the host */
+pmix_status_t pmix_server_query_local(pmix_query_t queries[], size_t nqueries,
+                                      pmix_info_t **info, size_t *ninfo);
+
 pmix_status_t pmix_server_log(pmix_peer_t *peer,
                               pmix_buffer_t *buf,
                               pmix_op_cbfunc_t cbfunc,
@@ -299,6 +349,15 @@ pmix_status_t pmix_server_event_recvd_from_client(pmix_peer_t *peer,
                                                   void *cbdata);
 void pmix_server_execute_collective(int sd, short args, void *cbdata);
 
+void pmix_server_remove_tracker(pmix_server_trkr_t *trk);
+
+/* add a completed fence to the histograms of its phases */
+void pmix_server_fence_stats_add(pmix_server_trkr_t *trk);
+
+/* describe the fence histograms, one line per phase - the
+ * returned string must be free'd by the caller */
+char *pmix_server_fence_stats(void);
+
 void pmix_server_queue_message(int fd, short args, void *cbdata);
 
 extern pmix_server_module_t pmix_host_server;
@@ -65,7 +65,7 @@ void pmix_pack_proc_map(pmix_buffer_t *buf,
     pmix_value_t val;
     pmix_status_t rc;
     pmix_buffer_t buf2;
-    size_t i, nnodes;
+    size_t i, nnodes, size;
 
     /* bozo check - need procs for each node */
     if (pmix_argv_count(nodes) != pmix_argv_count(procs)) {
@@ -78,8 +78,18 @@ void pmix_pack_proc_map(pmix_buffer_t *buf,
     kv.value = &val;
     val.type = PMIX_STRING;
 
-    /* pass the number of nodes involved in this namespace */
+    /* size the map so it is allocated once */
     nnodes = pmix_argv_count(nodes);
+    size = sizeof(size_t) + sizeof(pmix_data_type_t);
+    for (i=0; i < nnodes; i++) {
+        size += strlen(nodes[i]) + strlen(procs[i]) + PMIX_KVAL_PACK_OVERHEAD;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.reserve(&buf2, size))) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+    /* pass the number of nodes involved in this namespace */
     if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf2, &nnodes, 1, PMIX_SIZE))) {
         PMIX_ERROR_LOG(rc);
         goto cleanup;
@@ -100,6 +110,10 @@ void pmix_pack_proc_map(pmix_buffer_t *buf,
     val.data.string = NULL;
 
     /* pass the completed blob */
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.reserve(buf, buf2.bytes_used + strlen(PMIX_MAP_BLOB) + PMIX_KVAL_PACK_OVERHEAD))) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
     kv.key = PMIX_MAP_BLOB;
     val.type = PMIX_BYTE_OBJECT;
     val.data.bo.bytes = buf2.base_ptr;
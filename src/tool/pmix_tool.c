@@ -192,7 +192,7 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc,
     size_t n;
     pmix_kval_t *kptr;
     pmix_status_t rc;
-    pmix_nspace_t *nptr, *nsptr;
+    pmix_nspace_t *nsptr;
     pid_t server_pid=0;
     bool server_pid_given = false;
     int hostnamelen = 30;
@@ -400,13 +400,7 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc,
      * datastore with typical job-related info. No point
      * in having the server generate these as we are
      * obviously a singleton, and so the values are well-known */
-    nsptr = NULL;
-    PMIX_LIST_FOREACH(nptr, &pmix_globals.nspaces, pmix_nspace_t) {
-        if (0 == strncmp(pmix_globals.myid.nspace, nptr->nspace, PMIX_MAX_NSLEN)) {
-            nsptr = nptr;
-            break;
-        }
-    }
+    nsptr = pmix_nspace_lookup(pmix_globals.myid.nspace);
     if (NULL == nsptr) {
         return PMIX_ERR_NOT_FOUND;
     }
@@ -809,7 +803,7 @@ static pmix_status_t recv_connect_ack(int sd)
     /* setup required bookkeeping */
     nsptr = PMIX_NEW(pmix_nspace_t);
     (void)strncpy(nsptr->nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN);
-    pmix_list_append(&pmix_globals.nspaces, &nsptr->super);
+    pmix_nspace_add(nsptr);
     /* our rank is always zero */
     pmix_globals.myid.rank = 0;
 
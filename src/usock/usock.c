@@ -242,6 +242,7 @@ static void rcon(pmix_usock_recv_t *p)
     p->hdr.tag = UINT32_MAX;
     p->hdr.nbytes = 0;
     p->data = NULL;
+    p->version = PMIX_BFROP_BUFFER_V1;
     p->hdr_recvd = false;
     p->rdptr = NULL;
     p->rdbytes = 0;
@@ -304,6 +305,7 @@ static void pcon(pmix_peer_t *p)
 {
     p->info = NULL;
     p->sd = -1;
+    p->bfrop_version = PMIX_BFROP_BUFFER_V1;
     p->send_ev_active = false;
     p->recv_ev_active = false;
     PMIX_CONSTRUCT(&p->send_queue, pmix_list_t);
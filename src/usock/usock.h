@@ -191,6 +191,7 @@ pmix_status_t pmix_usock_set_nonblocking(int sd);
 pmix_status_t  pmix_usock_set_blocking(int sd);
 pmix_status_t pmix_usock_send_blocking(int sd, char *ptr, size_t size);
 pmix_status_t pmix_usock_recv_blocking(int sd, char *data, size_t size);
+void pmix_usock_load_hdr(pmix_peer_t *peer, pmix_usock_send_t *snd);
 void pmix_usock_send_recv(int sd, short args, void *cbdata);
 void pmix_usock_send_handler(int sd, short flags, void *cbdata);
 void pmix_usock_recv_handler(int sd, short flags, void *cbdata);
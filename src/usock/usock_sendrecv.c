@@ -343,8 +343,13 @@ void pmix_usock_recv_handler(int sd, short flags, void *cbdata)
         }
         peer->recv_msg->peer = peer;  // provide a handle back to the peer object
         /* start by reading the header */
-        peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
-        peer->recv_msg->rdbytes = sizeof(pmix_usock_hdr_t);
+        if (PMIX_USOCK_XHDR(peer)) {
+            peer->recv_msg->rdptr = peer->recv_msg->xhdr;
+            peer->recv_msg->rdbytes = PMIX_USOCK_XHDR_SIZE;
+        } else {
+            peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
+            peer->recv_msg->rdbytes = sizeof(pmix_usock_hdr_t);
+        }
     }
     msg = peer->recv_msg;
     msg->sd = sd;
@@ -355,6 +360,10 @@ void pmix_usock_recv_handler(int sd, short flags, void *cbdata)
         if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &msg->rdptr, &msg->rdbytes))) {
             /* completed reading the header */
             peer->recv_msg->hdr_recvd = true;
+            if (PMIX_USOCK_XHDR(peer)) {
+                memcpy(&peer->recv_msg->hdr, peer->recv_msg->xhdr, sizeof(pmix_usock_hdr_t));
+                peer->recv_msg->version = (uint8_t)peer->recv_msg->xhdr[sizeof(pmix_usock_hdr_t)];
+            }
             /* if this is a zero-byte message, then we are done */
             if (0 == peer->recv_msg->hdr.nbytes) {
                 pmix_output_verbose(2, pmix_globals.debug_output,
@@ -437,6 +446,31 @@ void pmix_usock_recv_handler(int sd, short flags, void *cbdata)
     lost_connection(peer, PMIX_ERR_UNREACH);
 }
 
+/* point a new send at its header - followed by the encoding of
+ * the payload for peers that agreed to take it */
+void pmix_usock_load_hdr(pmix_peer_t *peer, pmix_usock_send_t *snd)
+{
+    uint8_t version = PMIX_BFROP_BUFFER_V1;
+
+    if (NULL != snd->data) {
+        version = snd->data->version;
+    }
+    if (peer->bfrop_version < version) {
+        /* whoever packed it should have checked - the peer will
+         * not be able to read it */
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
+    }
+    if (PMIX_USOCK_XHDR(peer)) {
+        memcpy(snd->xhdr, &snd->hdr, sizeof(pmix_usock_hdr_t));
+        snd->xhdr[sizeof(pmix_usock_hdr_t)] = (char)version;
+        snd->sdptr = snd->xhdr;
+        snd->sdbytes = PMIX_USOCK_XHDR_SIZE;
+    } else {
+        snd->sdptr = (char*)&snd->hdr;
+        snd->sdbytes = sizeof(pmix_usock_hdr_t);
+    }
+}
+
 void pmix_usock_send_recv(int fd, short args, void *cbdata)
 {
     pmix_usock_sr_t *ms = (pmix_usock_sr_t*)cbdata;
@@ -471,8 +505,7 @@ void pmix_usock_send_recv(int fd, short args, void *cbdata)
     snd->hdr.nbytes = ms->bfr->bytes_used;
     snd->data = ms->bfr;
     /* always start with the header */
-    snd->sdptr = (char*)&snd->hdr;
-    snd->sdbytes = sizeof(pmix_usock_hdr_t);
+    pmix_usock_load_hdr(ms->peer, snd);
 
     /* if there is no message on-deck, put this one there */
     if (NULL == ms->peer->send_msg) {
@@ -510,6 +543,7 @@ void pmix_usock_process_msg(int fd, short flags, void *cbdata)
             if (NULL != rcv->cbfunc) {
                 /* construct and load the buffer */
                 PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+                buf.version = msg->version;
                 if (NULL != msg->data) {
                     buf.base_ptr = (char*)msg->data;
                     buf.bytes_allocated = buf.bytes_used = msg->hdr.nbytes;
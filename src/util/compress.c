@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2016      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <stdlib.h>
+#include <string.h>
+#if PMIX_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "src/util/error.h"
+#include "src/util/compress.h"
+
+pmix_status_t pmix_compress_block(const uint8_t *inbytes, size_t size,
+                                  uint8_t **outbytes, size_t *nbytes)
+{
+#if PMIX_HAVE_ZLIB
+    z_stream strm;
+    uint8_t *tmp;
+    size_t len;
+    int rc;
+
+    *outbytes = NULL;
+    *nbytes = 0;
+
+    /* zlib counts in uInt */
+    if (size > (size_t)UINT32_MAX) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    memset(&strm, 0, sizeof(strm));
+    if (Z_OK != deflateInit(&strm, Z_DEFAULT_COMPRESSION)) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    /* there is no point in a result that isn't any smaller, so
+     * only give zlib as much room as the input takes */
+    len = deflateBound(&strm, size);
+    if (len > size) {
+        len = size;
+    }
+    if (NULL == (tmp = (uint8_t*)malloc(len))) {
+        deflateEnd(&strm);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    strm.next_in = (Bytef*)inbytes;
+    strm.avail_in = size;
+    strm.next_out = tmp;
+    strm.avail_out = len;
+    rc = deflate(&strm, Z_FINISH);
+    deflateEnd(&strm);
+    if (Z_STREAM_END != rc) {
+        /* ran out of room - the data doesn't compress */
+        free(tmp);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *outbytes = tmp;
+    *nbytes = len - strm.avail_out;
+    return PMIX_SUCCESS;
+#else
+    return PMIX_ERR_NOT_SUPPORTED;
+#endif
+}
+
+pmix_status_t pmix_uncompress_block(const uint8_t *inbytes, size_t size,
+                                    uint8_t **outbytes, size_t len)
+{
+#if PMIX_HAVE_ZLIB
+    z_stream strm;
+    uint8_t *tmp;
+    int rc;
+
+    *outbytes = NULL;
+
+    if (size > (size_t)UINT32_MAX || len > (size_t)UINT32_MAX) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    memset(&strm, 0, sizeof(strm));
+    if (Z_OK != inflateInit(&strm)) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    if (NULL == (tmp = (uint8_t*)malloc(len))) {
+        inflateEnd(&strm);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    strm.next_in = (Bytef*)inbytes;
+    strm.avail_in = size;
+    strm.next_out = tmp;
+    strm.avail_out = len;
+    rc = inflate(&strm, Z_FINISH);
+    inflateEnd(&strm);
+    if (Z_STREAM_END != rc || 0 != strm.avail_out) {
+        free(tmp);
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    *outbytes = tmp;
+    return PMIX_SUCCESS;
+#else
+    return PMIX_ERR_NOT_SUPPORTED;
+#endif
+}
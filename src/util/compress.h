@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2016      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_COMPRESS_H
+#define PMIX_COMPRESS_H
+
+#include <src/include/pmix_config.h>
+
+#include <pmix_common.h>
+
+BEGIN_C_DECLS
+
+/* compress size bytes starting at inbytes into a newly allocated
+ * block returned in outbytes with its length in nbytes. Returns
+ * PMIX_ERR_NOT_SUPPORTED if PMIx was built without zlib and
+ * PMIX_ERR_BAD_PARAM if the data would not get any smaller - the
+ * caller then just sends the data as it is */
+pmix_status_t pmix_compress_block(const uint8_t *inbytes, size_t size,
+                                  uint8_t **outbytes, size_t *nbytes);
+
+/* uncompress the size bytes starting at inbytes, which must
+ * expand to exactly len bytes, into a newly allocated block
+ * returned in outbytes */
+pmix_status_t pmix_uncompress_block(const uint8_t *inbytes, size_t size,
+                                    uint8_t **outbytes, size_t len);
+
+END_C_DECLS
+
+#endif /* PMIX_COMPRESS_H */
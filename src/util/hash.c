@@ -36,6 +36,10 @@
 
 #include "src/util/hash.h"
 
+/* initial number of keys each proc's key index is sized for,
+ * the index grows as needed */
+#define PMIX_HASH_KEYS_INIT_SIZE 16
+
 /**
  * Data for a particular pmix process
  * The name association is maintained in the
@@ -47,21 +51,29 @@ typedef struct {
     /* List of pmix_kval_t structures containing all data
        received from this process */
     pmix_list_t data;
+    /* index of the pmix_kval_t structures on the data list
+     * by their key so lookups don't have to walk the list */
+    pmix_hash_table_t keys;
 } pmix_proc_data_t;
 static void pdcon(pmix_proc_data_t *p)
 {
     PMIX_CONSTRUCT(&p->data, pmix_list_t);
+    PMIX_CONSTRUCT(&p->keys, pmix_hash_table_t);
+    pmix_hash_table_init(&p->keys, PMIX_HASH_KEYS_INIT_SIZE);
 }
 static void pddes(pmix_proc_data_t *p)
 {
+    PMIX_DESTRUCT(&p->keys);
     PMIX_LIST_DESTRUCT(&p->data);
 }
 static PMIX_CLASS_INSTANCE(pmix_proc_data_t,
                            pmix_list_item_t,
                            pdcon, pddes);
 
-static pmix_kval_t* lookup_keyval(pmix_list_t *data,
+static pmix_kval_t* lookup_keyval(pmix_proc_data_t *proc_data,
                                   const char *key);
+static void remove_keyval(pmix_proc_data_t *proc_data,
+                          pmix_kval_t *kv);
 static pmix_proc_data_t* lookup_proc(pmix_hash_table_t *jtable,
                                      uint64_t id, bool create);
 
@@ -85,15 +97,16 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
     }
 
     /* see if we already have this key-value */
-    hv = lookup_keyval(&proc_data->data, kin->key);
+    hv = lookup_keyval(proc_data, kin->key);
     if (NULL != hv) {
         /* yes we do - so remove the current value
          * and replace it */
-        pmix_list_remove_item(&proc_data->data, &hv->super);
-        PMIX_RELEASE(hv);
+        remove_keyval(proc_data, hv);
     }
     PMIX_RETAIN(kin);
     pmix_list_append(&proc_data->data, &kin->super);
+    pmix_hash_table_set_value_ptr(&proc_data->keys, kin->key,
+                                  strlen(kin->key), kin);
 
     return PMIX_SUCCESS;
 }
@@ -146,7 +159,7 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
 
         } else {
             /* find the value from within this proc_data object */
-            hv = lookup_keyval(&proc_data->data, key);
+            hv = lookup_keyval(proc_data, key);
             if (NULL != hv) {
                 /* create the copy */
                 if (PMIX_SUCCESS != (rc = pmix_bfrop.copy((void**)kvs, hv->value, PMIX_VALUE))) {
@@ -173,6 +186,26 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
     return rc;
 }
 
+pmix_status_t pmix_hash_fetch_ptr(pmix_hash_table_t *table, pmix_rank_t rank,
+                                  const char *key, pmix_value_t **kvs)
+{
+    pmix_proc_data_t *proc_data;
+    pmix_kval_t *hv;
+
+    pmix_output_verbose(10, pmix_globals.debug_output,
+                        "HASH:FETCH_PTR rank %d key %s",
+                        rank, key);
+
+    if (NULL == (proc_data = lookup_proc(table, (uint64_t)rank, false))) {
+        return PMIX_ERR_PROC_ENTRY_NOT_FOUND;
+    }
+    if (NULL == (hv = lookup_keyval(proc_data, key))) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    *kvs = hv->value;
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const char *key,
                                      pmix_rank_t *rank, pmix_value_t **kvs, void **last)
 {
@@ -212,7 +245,7 @@ pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const char *key,
     }
 
     /* find the value from within this proc_data object */
-    hv = lookup_keyval(&proc_data->data, key_r);
+    hv = lookup_keyval(proc_data, key_r);
     if (hv) {
         /* create the copy */
         if (PMIX_SUCCESS != (rc = pmix_bfrop.copy((void**)kvs, hv->value, PMIX_VALUE))) {
@@ -250,12 +283,8 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
                 if (NULL == key) {
                     PMIX_RELEASE(proc_data);
                 } else {
-                    PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
-                        if (0 == strcmp(key, kv->key)) {
-                            pmix_list_remove_item(&proc_data->data, &kv->super);
-                            PMIX_RELEASE(kv);
-                            break;
-                        }
+                    if (NULL != (kv = lookup_keyval(proc_data, key))) {
+                        remove_keyval(proc_data, kv);
                     }
                 }
             }
@@ -272,6 +301,7 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
 
     /* if key is NULL, remove all data for this proc */
     if (NULL == key) {
+        pmix_hash_table_remove_all(&proc_data->keys);
         while (NULL != (kv = (pmix_kval_t*)pmix_list_remove_first(&proc_data->data))) {
             PMIX_RELEASE(kv);
         }
@@ -283,31 +313,37 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     }
 
     /* remove this item */
-    PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
-        if (0 == strcmp(key, kv->key)) {
-            pmix_list_remove_item(&proc_data->data, &kv->super);
-            PMIX_RELEASE(kv);
-            break;
-        }
+    if (NULL != (kv = lookup_keyval(proc_data, key))) {
+        remove_keyval(proc_data, kv);
     }
 
     return PMIX_SUCCESS;
 }
 
 /**
- * Find data for a given key in a given pmix_list_t.
+ * Find data for a given key in a given proc_data_t.
  */
-static pmix_kval_t* lookup_keyval(pmix_list_t *data,
+static pmix_kval_t* lookup_keyval(pmix_proc_data_t *proc_data,
                                   const char *key)
 {
-    pmix_kval_t *kv;
+    pmix_kval_t *kv = NULL;
 
-    PMIX_LIST_FOREACH(kv, data, pmix_kval_t) {
-        if (0 == strcmp(key, kv->key)) {
-            return kv;
-        }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&proc_data->keys, key,
+                                                      strlen(key), (void**)&kv)) {
+        return NULL;
     }
-    return NULL;
+    return kv;
+}
+
+/**
+ * Remove and release the given data of a given proc_data_t.
+ */
+static void remove_keyval(pmix_proc_data_t *proc_data,
+                          pmix_kval_t *kv)
+{
+    pmix_hash_table_remove_value_ptr(&proc_data->keys, kv->key, strlen(kv->key));
+    pmix_list_remove_item(&proc_data->data, &kv->super);
+    PMIX_RELEASE(kv);
 }
 
 
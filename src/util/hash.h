@@ -32,6 +32,13 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
 pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
                               const char *key, pmix_value_t **kvs);
 
+/* Fetch the value for a specified key and rank from within
+ * the given hash_table without copying it. The value remains
+ * owned by the table and is only valid until the key is stored
+ * again or removed */
+pmix_status_t pmix_hash_fetch_ptr(pmix_hash_table_t *table, pmix_rank_t rank,
+                                  const char *key, pmix_value_t **kvs);
+
 /* Fetch the value for a specified key from within
  * the given hash_table
  * It gets the next portion of data from table, where matching key.
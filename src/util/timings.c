@@ -32,6 +32,81 @@
 #include <sys/resource.h>
 #endif
 
+#include "src/util/printf.h"
+#include "src/util/timings.h"
+
+double pmix_timing_now(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+}
+
+void pmix_timing_hist_init(pmix_timing_hist_t *h)
+{
+    memset(h, 0, sizeof(*h));
+}
+
+void pmix_timing_hist_add(pmix_timing_hist_t *h, double secs)
+{
+    uint64_t usecs;
+    int bin = 0;
+
+    if (secs < 0) {
+        secs = 0;
+    }
+    if (0 == h->count || secs < h->min) {
+        h->min = secs;
+    }
+    if (secs > h->max) {
+        h->max = secs;
+    }
+    h->count++;
+    h->sum += secs;
+    usecs = (uint64_t)(secs * 1000000.0);
+    while (0 < usecs && bin < PMIX_TIMING_HIST_BINS - 1) {
+        usecs >>= 1;
+        bin++;
+    }
+    h->bins[bin]++;
+}
+
+char *pmix_timing_hist_print(pmix_timing_hist_t *h, const char *name)
+{
+    char *str, *tmp;
+    int n, rc;
+
+    if (0 == h->count) {
+        if (0 > asprintf(&str, "%s: count 0", name)) {
+            return NULL;
+        }
+        return str;
+    }
+    if (0 > asprintf(&str, "%s: count %lu avg %.1f min %.1f max %.1f usec, bins",
+                     name, (unsigned long)h->count,
+                     1000000.0 * h->sum / (double)h->count,
+                     1000000.0 * h->min, 1000000.0 * h->max)) {
+        return NULL;
+    }
+    /* list the non-empty bins by their upper bound in usecs */
+    for (n=0; n < PMIX_TIMING_HIST_BINS; n++) {
+        if (0 == h->bins[n]) {
+            continue;
+        }
+        if (PMIX_TIMING_HIST_BINS - 1 == n) {
+            rc = asprintf(&tmp, "%s inf:%lu", str, (unsigned long)h->bins[n]);
+        } else {
+            rc = asprintf(&tmp, "%s %lu:%lu", str, 1UL << n, (unsigned long)h->bins[n]);
+        }
+        free(str);
+        if (0 > rc) {
+            return NULL;
+        }
+        str = tmp;
+    }
+    return str;
+}
+
 
 #if PMIX_ENABLE_TIMING
 
@@ -40,8 +115,6 @@
 #include "src/util/output.h"
 #include "src/util/basename.h"
 
-#include "src/util/timings.h"
-
 #define DELTAS_SANE_LIMIT (10*1024*1024)
 
 struct interval_descr{
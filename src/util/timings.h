@@ -18,6 +18,39 @@
 
 #include "src/class/pmix_list.h"
 
+/* Latency histograms are always built in as they are cheap enough
+ * to keep for every operation. Bin 0 counts the samples below one
+ * usec, bin n > 0 those of [2^(n-1), 2^n) usecs, and the last bin
+ * everything beyond */
+#define PMIX_TIMING_HIST_BINS 32
+
+typedef struct {
+    uint64_t count;
+    double sum, min, max;   // in seconds
+    uint64_t bins[PMIX_TIMING_HIST_BINS];
+} pmix_timing_hist_t;
+
+/**
+ * Current wall-clock time in seconds.
+ */
+double pmix_timing_now(void);
+
+/**
+ * Reset the histogram 'h'.
+ */
+void pmix_timing_hist_init(pmix_timing_hist_t *h);
+
+/**
+ * Add a sample of 'secs' seconds to the histogram 'h'.
+ */
+void pmix_timing_hist_add(pmix_timing_hist_t *h, double secs);
+
+/**
+ * Describe the histogram 'h' in a single line starting with
+ * 'name' - the returned string must be free'd by the caller.
+ */
+char *pmix_timing_hist_print(pmix_timing_hist_t *h, const char *name);
+
 #if PMIX_ENABLE_TIMING
 
 #define PMIX_TIMING_DESCR_MAX 1024
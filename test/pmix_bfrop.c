@@ -0,0 +1,974 @@
+/*
+ * Copyright (c) 2013-2016 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Unit test of the buffer operations - needs no server. Packs values
+ * with each buffer encoding version and buffer type and checks that
+ * they unpack again, then prints how long a few of the hot paths take.
+ * Exits non-zero if any check fails.
+ *
+ * floats:  floats and doubles - on their own, in arrays and in
+ *          values - unpack exactly when packed as binary, and to the
+ *          decimal precision of the strings older versions pack
+ * swap:    the byte order kernels picked for this CPU convert arrays
+ *          of 16, 32 and 64 bit integers exactly as the scalar loop
+ *          does - timed against it, as is packing an array of ranks
+ * views:   strings and byte objects unpacked as views point into the
+ *          buffer they were packed in and match what was packed -
+ *          timed against unpacking by copy, as is unpacking info and
+ *          procs whose keys and nspaces are read in place
+ * wire:    counts, sizes, ranks, strings, info, procs and values
+ *          unpack from V1 and compact (V3) buffers, and a compact
+ *          payload can't be copied into a V1 buffer - then prints
+ *          how many bytes fence, get and commit requests like the
+ *          ones the client sends take in each encoding
+ * nested:  buffers packed in place - one inside another - in V1 and
+ *          compact buffers unpack as the buffers packed separately
+ *          do, with the outer buffer's encoding picked up again
+ * skip:    kvals of each kind of value are stepped over to exactly
+ *          where unpacking them leaves the buffer
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "src/class/pmix_object.h"
+#include "src/buffer_ops/buffer_ops.h"
+#include "src/buffer_ops/internal.h"
+#include "src/include/pmix_globals.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#define BFROP_FLOAT_NVALS 9
+#define BFROP_FLOAT_TIMED 100000
+/* total bytes converted at each array length */
+#define BFROP_SWAP_VOLUME (64 * 1024 * 1024)
+#define BFROP_SWAP_RANKS 65536
+#define BFROP_SWAP_REPS 50
+#define BFROP_VIEW_NVALS 100000
+/* the nspace simptest gives its clients */
+#define BFROP_WIRE_NSPACE "foobar"
+
+static double get_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1E-6 * (double)tv.tv_usec;
+}
+
+/* the decimal strings carry six places after the point */
+static bool dbl_match(double a, double b, uint8_t version)
+{
+    if (PMIX_BFROP_BUFFER_V2 <= version) {
+        return 0 == memcmp(&a, &b, sizeof(a));
+    }
+    if (isnan(a) || isnan(b)) {
+        return isnan(a) && isnan(b);
+    }
+    if (isinf(a) || isinf(b)) {
+        return a == b;
+    }
+    return fabs(a - b) <= 5E-7 + 1E-15 * fabs(a);
+}
+
+static int check_floats(uint8_t version, pmix_bfrop_buffer_type_t type)
+{
+    pmix_buffer_t buf;
+    float fin[BFROP_FLOAT_NVALS] = {0.0f, -0.0f, 1.5f, -3.25f, 3.14159265f,
+                                    FLT_MIN, FLT_MAX, INFINITY, NAN};
+    double din[BFROP_FLOAT_NVALS] = {0.0, -0.0, 1.5, -3.25, 3.141592653589793,
+                                     DBL_MIN, 1E300, -INFINITY, NAN};
+    float fout[BFROP_FLOAT_NVALS];
+    double dout[BFROP_FLOAT_NVALS], d = 2.718281828459045;
+    pmix_value_t val, vout;
+    int32_t cnt;
+    int i, rc;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.type = type;
+    buf.version = version;
+
+    /* the arrays, a single double and a double value */
+    PMIX_VALUE_CONSTRUCT(&val);
+    val.type = PMIX_DOUBLE;
+    val.data.dval = d;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, fin, BFROP_FLOAT_NVALS, PMIX_FLOAT)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, din, BFROP_FLOAT_NVALS, PMIX_DOUBLE)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &d, 1, PMIX_DOUBLE)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &val, 1, PMIX_VALUE))) {
+        goto done;
+    }
+
+    cnt = BFROP_FLOAT_NVALS;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, fout, &cnt, PMIX_FLOAT))) {
+        goto done;
+    }
+    for (i=0; i < BFROP_FLOAT_NVALS; i++) {
+        if (!dbl_match(fin[i], fout[i], version)) {
+            fprintf(stderr, "float %d packed as %g came back as %g\n", i, fin[i], fout[i]);
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            goto done;
+        }
+    }
+    cnt = BFROP_FLOAT_NVALS;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, dout, &cnt, PMIX_DOUBLE))) {
+        goto done;
+    }
+    for (i=0; i < BFROP_FLOAT_NVALS; i++) {
+        if (!dbl_match(din[i], dout[i], version)) {
+            fprintf(stderr, "double %d packed as %g came back as %g\n", i, din[i], dout[i]);
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            goto done;
+        }
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, dout, &cnt, PMIX_DOUBLE))) {
+        goto done;
+    }
+    PMIX_VALUE_CONSTRUCT(&vout);
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, &vout, &cnt, PMIX_VALUE))) {
+        goto done;
+    }
+    if (!dbl_match(d, dout[0], version) || PMIX_DOUBLE != vout.type ||
+        !dbl_match(d, vout.data.dval, version)) {
+        fprintf(stderr, "double packed as %g came back as %g and %g\n", d, dout[0], vout.data.dval);
+        rc = PMIX_ERR_UNPACK_FAILURE;
+    }
+    PMIX_VALUE_DESTRUCT(&vout);
+    if (PMIX_SUCCESS == rc && buf.unpack_ptr != buf.pack_ptr) {
+        fprintf(stderr, "%d bytes left over\n", (int)(buf.pack_ptr - buf.unpack_ptr));
+        rc = PMIX_ERR_UNPACK_FAILURE;
+    }
+
+  done:
+    PMIX_DESTRUCT(&buf);
+    return rc;
+}
+
+/* return the usec to pack and unpack an array of doubles */
+static int time_doubles(uint8_t version, double *usec, size_t *nbytes)
+{
+    pmix_buffer_t buf;
+    double *din, *dout, start;
+    int32_t cnt;
+    int i, rc;
+
+    din = (double*)malloc(BFROP_FLOAT_TIMED * sizeof(double));
+    dout = (double*)malloc(BFROP_FLOAT_TIMED * sizeof(double));
+    for (i=0; i < BFROP_FLOAT_TIMED; i++) {
+        din[i] = (double)i / 7.0;
+    }
+
+    start = get_ts();
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.version = version;
+    rc = pmix_bfrop.pack(&buf, din, BFROP_FLOAT_TIMED, PMIX_DOUBLE);
+    cnt = BFROP_FLOAT_TIMED;
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_bfrop.unpack(&buf, dout, &cnt, PMIX_DOUBLE);
+    }
+    *usec = 1E6 * (get_ts() - start);
+    *nbytes = buf.bytes_used;
+    PMIX_DESTRUCT(&buf);
+
+    free(din);
+    free(dout);
+    return rc;
+}
+
+/* return the usec to convert an array of n elements */
+static double time_kernel(pmix_bfrop_swap_fn_t fn, char *dst, const char *src,
+                          size_t n, size_t width)
+{
+    size_t reps, i;
+    double start;
+
+    reps = BFROP_SWAP_VOLUME / (n * width);
+    start = get_ts();
+    for (i=0; i < reps; i++) {
+        fn(dst, src, n);
+    }
+    return 1E6 * (get_ts() - start) / reps;
+}
+
+static int check_swap(size_t width, pmix_bfrop_swap_fn_t fast,
+                      pmix_bfrop_swap_fn_t scalar)
+{
+    /* odd lengths leave a tail for the scalar kernel to finish */
+    size_t lens[] = {1, 7, 33, 1024, 65537, 1048576};
+    size_t maxlen = lens[sizeof(lens)/sizeof(lens[0]) - 1];
+    char *src, *d1, *d2;
+    size_t n, i;
+    double tscalar, tfast;
+    int rc = PMIX_SUCCESS;
+
+    src = (char*)malloc(maxlen * width + 1);
+    d1 = (char*)malloc(maxlen * width + 1);
+    d2 = (char*)malloc(maxlen * width + 1);
+    for (i=0; i < maxlen * width + 1; i++) {
+        src[i] = (char)(i * 7 + 3);
+    }
+
+    for (n=0; n < sizeof(lens)/sizeof(lens[0]); n++) {
+        /* start one byte in so the vector loads are unaligned */
+        scalar(d1 + 1, src + 1, lens[n]);
+        fast(d2 + 1, src + 1, lens[n]);
+        if (0 != memcmp(d1 + 1, d2 + 1, lens[n] * width)) {
+            fprintf(stderr, "%d bit %s kernel differs at length %lu\n",
+                    (int)(8 * width), pmix_bfrop_swap_kernel, (unsigned long)lens[n]);
+            rc = PMIX_ERROR;
+            break;
+        }
+        if (lens[n] < 1024) {
+            continue;
+        }
+        tscalar = time_kernel(scalar, d1, src, lens[n], width);
+        tfast = time_kernel(fast, d2, src, lens[n], width);
+        fprintf(stderr, "swap: %d bit x %lu: %.2f usec scalar, %.2f usec %s (%.1fx)\n",
+                (int)(8 * width), (unsigned long)lens[n],
+                tscalar, tfast, pmix_bfrop_swap_kernel, tscalar / tfast);
+    }
+
+    free(src);
+    free(d1);
+    free(d2);
+    return rc;
+}
+
+/* pack and unpack an array of ranks with whichever kernels are set */
+static int time_ranks(double *usec)
+{
+    pmix_buffer_t buf;
+    pmix_rank_t *rin, *rout;
+    double start;
+    int32_t cnt;
+    int i, n, rc = PMIX_SUCCESS;
+
+    rin = (pmix_rank_t*)malloc(BFROP_SWAP_RANKS * sizeof(pmix_rank_t));
+    rout = (pmix_rank_t*)malloc(BFROP_SWAP_RANKS * sizeof(pmix_rank_t));
+    for (i=0; i < BFROP_SWAP_RANKS; i++) {
+        rin[i] = i;
+    }
+
+    /* the first pass is not timed so the pages are all touched */
+    start = 0.0;
+    for (n=0; n <= BFROP_SWAP_REPS; n++) {
+        if (1 == n) {
+            start = get_ts();
+        }
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        rc = pmix_bfrop.pack(&buf, rin, BFROP_SWAP_RANKS, PMIX_PROC_RANK);
+        cnt = BFROP_SWAP_RANKS;
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_bfrop.unpack(&buf, rout, &cnt, PMIX_PROC_RANK);
+        }
+        PMIX_DESTRUCT(&buf);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+    *usec = 1E6 * (get_ts() - start) / BFROP_SWAP_REPS;
+    if (PMIX_SUCCESS == rc && 0 != memcmp(rin, rout, sizeof(pmix_rank_t) * BFROP_SWAP_RANKS)) {
+        rc = PMIX_ERR_UNPACK_FAILURE;
+    }
+
+    free(rin);
+    free(rout);
+    return rc;
+}
+
+static bool in_buffer(pmix_buffer_t *buf, const char *ptr)
+{
+    return buf->base_ptr <= ptr && ptr < buf->base_ptr + buf->bytes_used;
+}
+
+static int check_views(pmix_bfrop_buffer_type_t type)
+{
+    pmix_buffer_t buf;
+    char *sin[3] = {"first", NULL, "third"};
+    char *sout[3];
+    pmix_byte_object_t bin[2], bout[2];
+    int32_t cnt, ival = 7;
+    int i, rc;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.type = type;
+    bin[0].bytes = "\001\002\003";
+    bin[0].size = 3;
+    bin[1].bytes = NULL;
+    bin[1].size = 0;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, sin, 3, PMIX_STRING)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, bin, 2, PMIX_BYTE_OBJECT)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &ival, 1, PMIX_INT32))) {
+        goto done;
+    }
+
+    cnt = 3;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack_view(&buf, sout, &cnt, PMIX_STRING))) {
+        goto done;
+    }
+    for (i=0; i < 3; i++) {
+        if (NULL == sin[i] ? NULL != sout[i] :
+            (NULL == sout[i] || !in_buffer(&buf, sout[i]) || 0 != strcmp(sin[i], sout[i]))) {
+            fprintf(stderr, "string %d is not a view of what was packed\n", i);
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            goto done;
+        }
+    }
+    cnt = 2;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack_view(&buf, bout, &cnt, PMIX_BYTE_OBJECT))) {
+        goto done;
+    }
+    if (3 != bout[0].size || !in_buffer(&buf, bout[0].bytes) ||
+        0 != memcmp(bin[0].bytes, bout[0].bytes, 3) ||
+        0 != bout[1].size || NULL != bout[1].bytes) {
+        fprintf(stderr, "byte objects are not views of what was packed\n");
+        rc = PMIX_ERR_UNPACK_FAILURE;
+        goto done;
+    }
+    /* only strings and byte objects can be viewed */
+    cnt = 1;
+    if (PMIX_ERR_NOT_SUPPORTED != pmix_bfrop.unpack_view(&buf, &ival, &cnt, PMIX_INT32)) {
+        fprintf(stderr, "viewed an int32\n");
+        rc = PMIX_ERR_UNPACK_FAILURE;
+        goto done;
+    }
+    cnt = 1;
+    rc = pmix_bfrop.unpack(&buf, &ival, &cnt, PMIX_INT32);
+
+  done:
+    PMIX_DESTRUCT(&buf);
+    return rc;
+}
+
+/* return the usec to unpack an array of strings by copy or as views */
+static int time_strings(bool view, double *usec)
+{
+    pmix_buffer_t buf;
+    char **sin, **sout;
+    int32_t cnt;
+    double start;
+    int i, rc;
+
+    sin = (char**)malloc(BFROP_VIEW_NVALS * sizeof(char*));
+    sout = (char**)malloc(BFROP_VIEW_NVALS * sizeof(char*));
+    for (i=0; i < BFROP_VIEW_NVALS; i++) {
+        (void)asprintf(&sin[i], "bfrop.key.%d", i);
+    }
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    rc = pmix_bfrop.pack(&buf, sin, BFROP_VIEW_NVALS, PMIX_STRING);
+
+    start = get_ts();
+    cnt = BFROP_VIEW_NVALS;
+    if (PMIX_SUCCESS == rc) {
+        if (view) {
+            rc = pmix_bfrop.unpack_view(&buf, sout, &cnt, PMIX_STRING);
+        } else {
+            rc = pmix_bfrop.unpack(&buf, sout, &cnt, PMIX_STRING);
+        }
+    }
+    if (PMIX_SUCCESS == rc && !view) {
+        for (i=0; i < BFROP_VIEW_NVALS; i++) {
+            free(sout[i]);
+        }
+    }
+    *usec = 1E6 * (get_ts() - start);
+
+    PMIX_DESTRUCT(&buf);
+    for (i=0; i < BFROP_VIEW_NVALS; i++) {
+        free(sin[i]);
+    }
+    free(sin);
+    free(sout);
+    return rc;
+}
+
+/* return the usec to unpack an array of info and one of procs */
+static int time_structs(double *info_usec, double *proc_usec)
+{
+    pmix_buffer_t buf;
+    pmix_info_t *iin, *iout;
+    pmix_proc_t *pin, *pout;
+    int32_t cnt;
+    double start;
+    int i, rc;
+
+    PMIX_INFO_CREATE(iin, BFROP_VIEW_NVALS);
+    PMIX_INFO_CREATE(iout, BFROP_VIEW_NVALS);
+    PMIX_PROC_CREATE(pin, BFROP_VIEW_NVALS);
+    PMIX_PROC_CREATE(pout, BFROP_VIEW_NVALS);
+    for (i=0; i < BFROP_VIEW_NVALS; i++) {
+        (void)snprintf(iin[i].key, PMIX_MAX_KEYLEN, "bfrop.key.%d", i);
+        iin[i].value.type = PMIX_UINT32;
+        iin[i].value.data.uint32 = i;
+        (void)snprintf(pin[i].nspace, PMIX_MAX_NSLEN, "bfrop.%d", i % 16);
+        pin[i].rank = i;
+    }
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, iin, BFROP_VIEW_NVALS, PMIX_INFO)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, pin, BFROP_VIEW_NVALS, PMIX_PROC))) {
+        goto done;
+    }
+
+    start = get_ts();
+    cnt = BFROP_VIEW_NVALS;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, iout, &cnt, PMIX_INFO))) {
+        goto done;
+    }
+    *info_usec = 1E6 * (get_ts() - start);
+    start = get_ts();
+    cnt = BFROP_VIEW_NVALS;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, pout, &cnt, PMIX_PROC))) {
+        goto done;
+    }
+    *proc_usec = 1E6 * (get_ts() - start);
+
+    for (i=0; i < BFROP_VIEW_NVALS; i++) {
+        if (0 != strcmp(iin[i].key, iout[i].key) || iin[i].value.data.uint32 != iout[i].value.data.uint32 ||
+            0 != strcmp(pin[i].nspace, pout[i].nspace) || pin[i].rank != pout[i].rank) {
+            fprintf(stderr, "element %d did not unpack\n", i);
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            break;
+        }
+    }
+
+  done:
+    PMIX_DESTRUCT(&buf);
+    PMIX_INFO_FREE(iin, BFROP_VIEW_NVALS);
+    PMIX_INFO_FREE(iout, BFROP_VIEW_NVALS);
+    PMIX_PROC_FREE(pin, BFROP_VIEW_NVALS);
+    PMIX_PROC_FREE(pout, BFROP_VIEW_NVALS);
+    return rc;
+}
+
+static int check_wire(pmix_bfrop_buffer_type_t type, uint8_t version)
+{
+    pmix_buffer_t buf, v1;
+    int32_t iin[6] = {0, 1, 127, 128, -1, INT32_MAX}, iout[6];
+    size_t zin[5] = {0, 127, 128, 16384, SIZE_MAX}, zout[5];
+    pmix_rank_t rin[7] = {0, 1, 127, 1000000, PMIX_RANK_WILDCARD,
+                          PMIX_RANK_UNDEF, PMIX_RANK_LOCAL_NODE}, rout[7];
+    char *sin[4] = {"", NULL, "bfrop", NULL}, *sout[4];
+    pmix_info_t *info, *iinfo;
+    pmix_proc_t pin[2], pout[2];
+    pmix_value_t vin, vout;
+    char big[300];
+    bool yes = true, quiet;
+    int32_t cnt;
+    int i, rc;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.type = type;
+    buf.version = version;
+    memset(big, 'w', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    sin[3] = big;
+    PMIX_INFO_CREATE(info, 3);
+    PMIX_INFO_CREATE(iinfo, 3);
+    PMIX_INFO_LOAD(&info[0], "bfrop.str", "value", PMIX_STRING);
+    PMIX_INFO_LOAD(&info[1], "bfrop.u32", &iin[3], PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[2], PMIX_COLLECT_DATA, &yes, PMIX_BOOL);
+    PMIX_INFO_REQUIRED(&info[2]);
+    (void)strncpy(pin[0].nspace, "bfrop", PMIX_MAX_NSLEN);
+    pin[0].rank = PMIX_RANK_WILDCARD;
+    (void)strncpy(pin[1].nspace, "bfrop.1", PMIX_MAX_NSLEN);
+    pin[1].rank = 1000;
+    vin.type = PMIX_SIZE;
+    vin.data.size = 1 << 20;
+
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, iin, 6, PMIX_INT32)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, zin, 5, PMIX_SIZE)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, rin, 7, PMIX_PROC_RANK)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, sin, 4, PMIX_STRING)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, info, 3, PMIX_INFO)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, pin, 2, PMIX_PROC)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &vin, 1, PMIX_VALUE))) {
+        goto done;
+    }
+
+    cnt = 6;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, iout, &cnt, PMIX_INT32)) ||
+        0 != memcmp(iin, iout, sizeof(iin))) {
+        fprintf(stderr, "int32s did not unpack\n");
+        goto fail;
+    }
+    cnt = 5;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, zout, &cnt, PMIX_SIZE)) ||
+        0 != memcmp(zin, zout, sizeof(zin))) {
+        fprintf(stderr, "sizes did not unpack\n");
+        goto fail;
+    }
+    cnt = 7;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, rout, &cnt, PMIX_PROC_RANK)) ||
+        0 != memcmp(rin, rout, sizeof(rin))) {
+        fprintf(stderr, "ranks did not unpack\n");
+        goto fail;
+    }
+    cnt = 4;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, sout, &cnt, PMIX_STRING))) {
+        goto fail;
+    }
+    for (i=0; i < 4; i++) {
+        if (NULL == sin[i] ? NULL != sout[i] : (NULL == sout[i] || 0 != strcmp(sin[i], sout[i]))) {
+            fprintf(stderr, "string %d did not unpack\n", i);
+            rc = PMIX_ERR_UNPACK_FAILURE;
+        }
+        free(sout[i]);
+    }
+    if (PMIX_SUCCESS != rc) {
+        goto done;
+    }
+    cnt = 3;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, iinfo, &cnt, PMIX_INFO)) ||
+        0 != strcmp(iinfo[0].value.data.string, "value") ||
+        iinfo[1].value.data.uint32 != (uint32_t)iin[3] ||
+        0 != strcmp(iinfo[2].key, PMIX_COLLECT_DATA) || !iinfo[2].value.data.flag ||
+        info[2].flags != iinfo[2].flags) {
+        fprintf(stderr, "info did not unpack\n");
+        goto fail;
+    }
+    cnt = 2;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, pout, &cnt, PMIX_PROC)) ||
+        0 != strcmp(pin[1].nspace, pout[1].nspace) ||
+        pin[0].rank != pout[0].rank || pin[1].rank != pout[1].rank) {
+        fprintf(stderr, "procs did not unpack\n");
+        goto fail;
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, &vout, &cnt, PMIX_VALUE)) ||
+        PMIX_SIZE != vout.type || vin.data.size != vout.data.size) {
+        fprintf(stderr, "value did not unpack\n");
+        goto fail;
+    }
+    /* and nothing is left over */
+    cnt = 1;
+    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != pmix_bfrop.unpack(&buf, iout, &cnt, PMIX_INT32)) {
+        fprintf(stderr, "data left in the buffer\n");
+        goto fail;
+    }
+
+    /* a compact payload can't be mixed into a V1 buffer that already
+     * holds data - an empty one takes on the encoding of the source */
+    PMIX_CONSTRUCT(&v1, pmix_buffer_t);
+    v1.type = type;
+    v1.version = PMIX_BFROP_BUFFER_V1;
+    rc = pmix_bfrop.pack(&v1, iin, 1, PMIX_INT32);
+    if (PMIX_SUCCESS == rc && PMIX_BFROP_BUFFER_V3 == version) {
+        /* the refusal is logged - keep it out of a passing run */
+        quiet = pmix_output_switch(0, false);
+        rc = pmix_bfrop.copy_payload(&v1, &buf);
+        pmix_output_switch(0, quiet);
+        rc = (PMIX_ERR_BAD_PARAM == rc) ? PMIX_SUCCESS : PMIX_ERR_BAD_PARAM;
+    }
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "copied a compact payload into a V1 buffer\n");
+    }
+    PMIX_DESTRUCT(&v1);
+    goto done;
+
+  fail:
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIX_ERR_UNPACK_FAILURE;
+    }
+  done:
+    PMIX_INFO_FREE(info, 3);
+    PMIX_INFO_FREE(iinfo, 3);
+    PMIX_DESTRUCT(&buf);
+    return rc;
+}
+
+/* pack a request shaped like the one the client sends for a
+ * fence, a get or a commit and return its size in bytes */
+static int request_size(pmix_bfrop_buffer_type_t type, uint8_t version,
+                        pmix_cmd_t cmd, size_t *nbytes)
+{
+    pmix_buffer_t buf, *blob;
+    pmix_proc_t proc;
+    pmix_info_t info;
+    pmix_rank_t rank = 5;
+    pmix_scope_t scope = PMIX_REMOTE;
+    pmix_kval_t kv;
+    pmix_value_t val;
+    char *nspace = BFROP_WIRE_NSPACE, key[PMIX_MAX_KEYLEN+1];
+    size_t n, one = 1;
+    bool yes = true;
+    int rc;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.type = type;
+    buf.version = version;
+    PMIX_INFO_CONSTRUCT(&info);
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &yes, PMIX_BOOL);
+    (void)strncpy(proc.nspace, BFROP_WIRE_NSPACE, PMIX_MAX_NSLEN);
+    proc.rank = PMIX_RANK_WILDCARD;
+
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &cmd, 1, PMIX_CMD))) {
+        goto done;
+    }
+    if (PMIX_FENCENB_CMD == cmd) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &one, 1, PMIX_SIZE)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &proc, 1, PMIX_PROC)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &one, 1, PMIX_SIZE)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &info, 1, PMIX_INFO))) {
+            goto done;
+        }
+    } else if (PMIX_GETNB_CMD == cmd) {
+        n = 0;
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &nspace, 1, PMIX_STRING)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &rank, 1, PMIX_PROC_RANK)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &n, 1, PMIX_SIZE))) {
+            goto done;
+        }
+    } else {
+        /* the blob is packed by PMIx_Put and stays V1 */
+        blob = PMIX_NEW(pmix_buffer_t);
+        blob->type = type;
+        PMIX_CONSTRUCT(&kv, pmix_kval_t);
+        kv.key = key;
+        kv.value = &val;
+        val.type = PMIX_UINT64;
+        for (n=0; n < 8; n++) {
+            (void)snprintf(key, sizeof(key), "bfrop.key.%d", (int)n);
+            val.data.uint64 = n;
+            if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(blob, &kv, 1, PMIX_KVAL))) {
+                break;
+            }
+        }
+        kv.key = NULL;
+        kv.value = NULL;
+        PMIX_DESTRUCT(&kv);
+        if (PMIX_SUCCESS == rc &&
+            PMIX_SUCCESS == (rc = pmix_bfrop.pack(&buf, &scope, 1, PMIX_SCOPE))) {
+            rc = pmix_bfrop.pack(&buf, &blob, 1, PMIX_BUFFER);
+        }
+        PMIX_RELEASE(blob);
+        if (PMIX_SUCCESS != rc) {
+            goto done;
+        }
+    }
+    *nbytes = buf.bytes_used;
+
+  done:
+    PMIX_INFO_DESTRUCT(&info);
+    PMIX_DESTRUCT(&buf);
+    return rc;
+}
+
+/* pack a string and a rank, then a buffer holding a size, as a
+ * PMIX_BUFFER into buf - in place or as separate buffers */
+static int pack_nested(pmix_buffer_t *buf, bool in_place)
+{
+    pmix_buffer_t *outer, *inner;
+    char *str = "bfrop.nested";
+    pmix_rank_t rank = PMIX_RANK_WILDCARD;
+    size_t off, ioff, sz = 300;
+    int rc;
+
+    if (in_place) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.open_nested(buf, 0, &off)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(buf, &str, 1, PMIX_STRING)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(buf, &rank, 1, PMIX_PROC_RANK)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.open_nested(buf, 0, &ioff)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.pack(buf, &sz, 1, PMIX_SIZE)) ||
+            PMIX_SUCCESS != (rc = pmix_bfrop.close_nested(buf, ioff))) {
+            return rc;
+        }
+        return pmix_bfrop.close_nested(buf, off);
+    }
+
+    outer = PMIX_NEW(pmix_buffer_t);
+    inner = PMIX_NEW(pmix_buffer_t);
+    outer->type = inner->type = buf->type;
+    if (PMIX_SUCCESS == (rc = pmix_bfrop.pack(outer, &str, 1, PMIX_STRING)) &&
+        PMIX_SUCCESS == (rc = pmix_bfrop.pack(outer, &rank, 1, PMIX_PROC_RANK)) &&
+        PMIX_SUCCESS == (rc = pmix_bfrop.pack(inner, &sz, 1, PMIX_SIZE)) &&
+        PMIX_SUCCESS == (rc = pmix_bfrop.pack(outer, &inner, 1, PMIX_BUFFER))) {
+        rc = pmix_bfrop.pack(buf, &outer, 1, PMIX_BUFFER);
+    }
+    PMIX_RELEASE(inner);
+    PMIX_RELEASE(outer);
+    return rc;
+}
+
+static int check_nested(pmix_bfrop_buffer_type_t type, uint8_t version, bool in_place)
+{
+    pmix_buffer_t buf, *outer = NULL, *inner = NULL;
+    char *str = NULL;
+    pmix_rank_t rank;
+    size_t sz;
+    int32_t cnt, before = 7, after = 0;
+    int rc;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.type = type;
+    buf.version = version;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &before, 1, PMIX_INT32)) ||
+        PMIX_SUCCESS != (rc = pack_nested(&buf, in_place))) {
+        goto done;
+    }
+    if (buf.version != version) {
+        fprintf(stderr, "buffer left at version %d\n", (int)buf.version);
+        rc = PMIX_ERROR;
+        goto done;
+    }
+    /* and something packed in the outer encoding after it */
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &before, 1, PMIX_INT32))) {
+        goto done;
+    }
+
+    /* unpacked buffers start out with the default type, so tell
+     * them what they hold as a receiver would */
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, &after, &cnt, PMIX_INT32)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, &outer, &cnt, PMIX_BUFFER))) {
+        fprintf(stderr, "nested buffers did not unpack: %d\n", rc);
+        goto done;
+    }
+    outer->type = type;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(outer, &str, &cnt, PMIX_STRING)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.unpack(outer, &rank, &cnt, PMIX_PROC_RANK)) ||
+        PMIX_SUCCESS != (rc = pmix_bfrop.unpack(outer, &inner, &cnt, PMIX_BUFFER))) {
+        fprintf(stderr, "nested buffers did not unpack: %d\n", rc);
+        goto done;
+    }
+    inner->type = type;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(inner, &sz, &cnt, PMIX_SIZE))) {
+        fprintf(stderr, "nested buffers did not unpack: %d\n", rc);
+        goto done;
+    }
+    if (7 != after || NULL == str || 0 != strcmp(str, "bfrop.nested") ||
+        PMIX_RANK_WILDCARD != rank || 300 != sz ||
+        outer->unpack_ptr != outer->pack_ptr || inner->unpack_ptr != inner->pack_ptr) {
+        fprintf(stderr, "nested buffers did not unpack to what was packed\n");
+        rc = PMIX_ERR_UNPACK_FAILURE;
+        goto done;
+    }
+    cnt = 1;
+    after = 0;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, &after, &cnt, PMIX_INT32)) || 7 != after) {
+        fprintf(stderr, "the value after the nested buffers did not unpack\n");
+        rc = PMIX_ERR_UNPACK_FAILURE;
+    }
+
+  done:
+    if (NULL != str) {
+        free(str);
+    }
+    if (NULL != inner) {
+        PMIX_RELEASE(inner);
+    }
+    if (NULL != outer) {
+        PMIX_RELEASE(outer);
+    }
+    PMIX_DESTRUCT(&buf);
+    return rc;
+}
+
+static int check_skip(pmix_bfrop_buffer_type_t type, uint8_t version)
+{
+    pmix_buffer_t buf;
+    pmix_kval_t kv;
+    pmix_value_t vals[5];
+    pmix_proc_t proc;
+    char *keys[5] = {"bfrop.str", "bfrop.bo", "bfrop.u32", "bfrop.size", "bfrop.proc"};
+    int32_t cnt, i, marker = 7, after = 0;
+    int rc = PMIX_SUCCESS;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.type = type;
+    buf.version = version;
+    vals[0].type = PMIX_STRING;
+    vals[0].data.string = "bfrop.skipped";
+    vals[1].type = PMIX_BYTE_OBJECT;
+    vals[1].data.bo.bytes = "bytes";
+    vals[1].data.bo.size = 5;
+    vals[2].type = PMIX_UINT32;
+    vals[2].data.uint32 = 1234567;
+    vals[3].type = PMIX_SIZE;
+    vals[3].data.size = 300;
+    (void)strncpy(proc.nspace, BFROP_WIRE_NSPACE, PMIX_MAX_NSLEN);
+    proc.rank = 3;
+    vals[4].type = PMIX_PROC;
+    vals[4].data.proc = &proc;
+    for (i=0; i < 5; i++) {
+        kv.key = keys[i];
+        kv.value = &vals[i];
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &kv, 1, PMIX_KVAL))) {
+            goto done;
+        }
+    }
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(&buf, &marker, 1, PMIX_INT32))) {
+        goto done;
+    }
+
+    for (i=0; i < 5; i++) {
+        cnt = 1;
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.skip(&buf, &cnt, PMIX_KVAL)) || 1 != cnt) {
+            fprintf(stderr, "kval %d was not stepped over: %d\n", i, rc);
+            goto done;
+        }
+    }
+    cnt = 1;
+    if (PMIX_ERR_NOT_SUPPORTED != pmix_bfrop.skip(&buf, &cnt, PMIX_INT32)) {
+        fprintf(stderr, "an int32 was stepped over\n");
+        rc = PMIX_ERROR;
+        goto done;
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(&buf, &after, &cnt, PMIX_INT32)) || 7 != after) {
+        fprintf(stderr, "the value after the kvals did not unpack\n");
+        rc = PMIX_ERR_UNPACK_FAILURE;
+    }
+
+  done:
+    PMIX_DESTRUCT(&buf);
+    return rc;
+}
+
+static void print_sizes(pmix_bfrop_buffer_type_t type, const char *tname)
+{
+    pmix_cmd_t cmds[3] = {PMIX_FENCENB_CMD, PMIX_GETNB_CMD, PMIX_COMMIT_CMD};
+    const char *names[3] = {"fence", "get", "commit"};
+    size_t v1, v3;
+    int i;
+
+    for (i=0; i < 3; i++) {
+        if (PMIX_SUCCESS == request_size(type, PMIX_BFROP_BUFFER_V1, cmds[i], &v1) &&
+            PMIX_SUCCESS == request_size(type, PMIX_BFROP_BUFFER_V3, cmds[i], &v3)) {
+            fprintf(stderr, "wire: %s %s request %lu bytes as V1, %lu as V3\n",
+                    tname, names[i], (unsigned long)v1, (unsigned long)v3);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t versions[] = {PMIX_BFROP_BUFFER_V1, PMIX_BFROP_BUFFER_V2};
+    uint8_t wire[] = {PMIX_BFROP_BUFFER_V1, PMIX_BFROP_BUFFER_V3};
+    pmix_bfrop_buffer_type_t types[] = {PMIX_BFROP_BUFFER_NON_DESC, PMIX_BFROP_BUFFER_FULLY_DESC};
+    size_t v, t, nbytes;
+    double usec, tfast, tscalar, tcopy, tview;
+    pmix_bfrop_swap_fn_t fast32;
+    int rc, nfail = 0;
+
+    if (PMIX_SUCCESS != (rc = pmix_bfrop_open())) {
+        fprintf(stderr, "pmix_bfrop_open failed: %d\n", rc);
+        return 1;
+    }
+
+    for (v=0; v < sizeof(versions)/sizeof(versions[0]); v++) {
+        for (t=0; t < sizeof(types)/sizeof(types[0]); t++) {
+            if (PMIX_SUCCESS != (rc = check_floats(versions[v], types[t]))) {
+                fprintf(stderr, "floats: version %d buffer type %d FAILED: %d\n",
+                        (int)versions[v], (int)types[t], rc);
+                nfail++;
+            }
+        }
+        if (PMIX_SUCCESS == time_doubles(versions[v], &usec, &nbytes)) {
+            fprintf(stderr, "floats: version %d: %d doubles in %lu bytes, packed and unpacked in %.1f usec\n",
+                    (int)versions[v], BFROP_FLOAT_TIMED, (unsigned long)nbytes, usec);
+        }
+    }
+
+    fprintf(stderr, "swap: using the %s kernels\n", pmix_bfrop_swap_kernel);
+    if (PMIX_SUCCESS != check_swap(2, pmix_bfrop_swap16, pmix_bfrop_swap16_scalar)) {
+        nfail++;
+    }
+    if (PMIX_SUCCESS != check_swap(4, pmix_bfrop_swap32, pmix_bfrop_swap32_scalar)) {
+        nfail++;
+    }
+    if (PMIX_SUCCESS != check_swap(8, pmix_bfrop_swap64, pmix_bfrop_swap64_scalar)) {
+        nfail++;
+    }
+    /* ranks go through the 32 bit kernel */
+    fast32 = pmix_bfrop_swap32;
+    if (PMIX_SUCCESS != (rc = time_ranks(&tfast))) {
+        fprintf(stderr, "swap: ranks did not unpack: %d\n", rc);
+        nfail++;
+    } else {
+        pmix_bfrop_swap32 = pmix_bfrop_swap32_scalar;
+        if (PMIX_SUCCESS != (rc = time_ranks(&tscalar))) {
+            fprintf(stderr, "swap: ranks did not unpack with the scalar kernel: %d\n", rc);
+            nfail++;
+        } else {
+            fprintf(stderr, "swap: %d ranks packed and unpacked in %.1f usec scalar, %.1f usec %s\n",
+                    BFROP_SWAP_RANKS, tscalar, tfast, pmix_bfrop_swap_kernel);
+        }
+        pmix_bfrop_swap32 = fast32;
+    }
+
+    for (t=0; t < sizeof(types)/sizeof(types[0]); t++) {
+        if (PMIX_SUCCESS != (rc = check_views(types[t]))) {
+            fprintf(stderr, "views: buffer type %d FAILED: %d\n", (int)types[t], rc);
+            nfail++;
+        }
+    }
+    if (PMIX_SUCCESS != (rc = time_strings(false, &tcopy)) ||
+        PMIX_SUCCESS != (rc = time_strings(true, &tview))) {
+        fprintf(stderr, "views: strings did not unpack: %d\n", rc);
+        nfail++;
+    } else {
+        fprintf(stderr, "views: %d strings unpacked in %.1f usec by copy, %.1f usec as views\n",
+                BFROP_VIEW_NVALS, tcopy, tview);
+    }
+    if (PMIX_SUCCESS != (rc = time_structs(&tcopy, &tview))) {
+        fprintf(stderr, "views: info and procs did not unpack: %d\n", rc);
+        nfail++;
+    } else {
+        fprintf(stderr, "views: %d info unpacked in %.1f usec, %d procs in %.1f usec\n",
+                BFROP_VIEW_NVALS, tcopy, BFROP_VIEW_NVALS, tview);
+    }
+
+    for (v=0; v < sizeof(wire)/sizeof(wire[0]); v++) {
+        for (t=0; t < sizeof(types)/sizeof(types[0]); t++) {
+            if (PMIX_SUCCESS != (rc = check_wire(types[t], wire[v]))) {
+                fprintf(stderr, "wire: version %d buffer type %d FAILED: %d\n",
+                        (int)wire[v], (int)types[t], rc);
+                nfail++;
+            }
+        }
+    }
+    for (v=0; v < sizeof(wire)/sizeof(wire[0]); v++) {
+        for (t=0; t < sizeof(types)/sizeof(types[0]); t++) {
+            if (PMIX_SUCCESS != (rc = check_nested(types[t], wire[v], true)) ||
+                PMIX_SUCCESS != (rc = check_nested(types[t], wire[v], false))) {
+                fprintf(stderr, "nested: version %d buffer type %d FAILED: %d\n",
+                        (int)wire[v], (int)types[t], rc);
+                nfail++;
+            }
+        }
+    }
+    for (v=0; v < sizeof(wire)/sizeof(wire[0]); v++) {
+        for (t=0; t < sizeof(types)/sizeof(types[0]); t++) {
+            if (PMIX_SUCCESS != (rc = check_skip(types[t], wire[v]))) {
+                fprintf(stderr, "skip: version %d buffer type %d FAILED: %d\n",
+                        (int)wire[v], (int)types[t], rc);
+                nfail++;
+            }
+        }
+    }
+    print_sizes(PMIX_BFROP_BUFFER_NON_DESC, "non-desc");
+    print_sizes(PMIX_BFROP_BUFFER_FULLY_DESC, "fully-desc");
+
+    pmix_bfrop_close();
+    if (0 < nfail) {
+        fprintf(stderr, "%d checks FAILED\n", nfail);
+        return 1;
+    }
+    fprintf(stderr, "all checks OK\n");
+    return 0;
+}
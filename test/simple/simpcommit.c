@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2013-2016 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Times a rank that publishes its data incrementally, doing a
+ * PMIx_Put and a PMIx_Commit per key, then checks that its peer
+ * sees all of the keys. Run it under simptest, e.g.
+ *
+ *     ./simptest -n 2 -e ./simpcommit
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "src/class/pmix_object.h"
+#include "src/buffer_ops/types.h"
+#include "src/util/output.h"
+#include "src/util/printf.h"
+
+#define SIMPCOMMIT_NKEYS 4000
+
+static pmix_proc_t myproc;
+
+static double get_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1E-6 * (double)tv.tv_usec;
+}
+
+int main(int argc, char **argv)
+{
+    int rc, i, ret = 1;
+    pmix_value_t value;
+    pmix_value_t *val = &value;
+    pmix_proc_t proc;
+    uint32_t nprocs;
+    char *key;
+    double start;
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Init failed: %d", myproc.nspace, myproc.rank, rc);
+        exit(1);
+    }
+    PMIX_PROC_CONSTRUCT(&proc);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    proc.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get job size failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    /* commit each key on its own - the fence makes sure the
+     * server has processed all of them */
+    value.type = PMIX_UINT64;
+    start = get_ts();
+    for (i=0; i < SIMPCOMMIT_NKEYS; i++) {
+        (void)asprintf(&key, "%s-%d-%d", myproc.nspace, myproc.rank, i);
+        value.data.uint64 = i;
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_LOCAL, key, &value))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Put failed: %d", myproc.nspace, myproc.rank, rc);
+            free(key);
+            goto done;
+        }
+        free(key);
+        if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Commit failed: %d", myproc.nspace, myproc.rank, rc);
+            goto done;
+        }
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(&proc, 1, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    pmix_output(0, "Client ns %s rank %d: %d commits in %.3f sec",
+                myproc.nspace, myproc.rank, SIMPCOMMIT_NKEYS, get_ts() - start);
+
+    /* check the first and last keys of the next rank */
+    proc.rank = (myproc.rank + 1) % nprocs;
+    for (i=0; i < SIMPCOMMIT_NKEYS; i += SIMPCOMMIT_NKEYS - 1) {
+        (void)asprintf(&key, "%s-%d-%d", proc.nspace, proc.rank, i);
+        if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, key, NULL, 0, &val))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get %s failed: %d", myproc.nspace, myproc.rank, key, rc);
+            free(key);
+            goto done;
+        }
+        if (PMIX_UINT64 != val->type || (uint64_t)i != val->data.uint64) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get %s returned wrong value", myproc.nspace, myproc.rank, key);
+            PMIX_VALUE_RELEASE(val);
+            free(key);
+            goto done;
+        }
+        PMIX_VALUE_RELEASE(val);
+        free(key);
+    }
+    ret = 0;
+
+ done:
+    /* finalize us */
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize failed: %d\n", myproc.nspace, myproc.rank, rc);
+        ret = 1;
+    }
+    fflush(stderr);
+    return(ret);
+}
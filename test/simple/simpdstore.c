@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2016      Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Checks that the data the server stores for a remote nspace
+ * survives the deregistration of the local nspaces: two local
+ * nspaces are registered, data of a third one is stored, one of
+ * the local nspaces is deregistered and the data is fetched back.
+ * It is a server on its own, run it as
+ *
+ *     ./simpdstore
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/buffer_ops/buffer_ops.h"
+#include "src/util/output.h"
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+#include "src/dstore/pmix_dstore.h"
+#endif /* PMIX_ENABLE_DSTORE */
+
+#define SIMPDSTORE_REMOTE "simpdstore.remote"
+#define SIMPDSTORE_KEY    "simpdstore.key"
+#define SIMPDSTORE_VALUE  0xfeedbeef
+
+static pmix_server_module_t mymodule = {0};
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    volatile bool *active = (volatile bool*)cbdata;
+
+    *active = false;
+}
+
+static void nspace_op(const char *nspace, int reg)
+{
+    volatile bool active = true;
+
+    if (reg) {
+        PMIx_server_register_nspace(nspace, 0, NULL, 0, opcbfunc, (void*)&active);
+    } else {
+        PMIx_server_deregister_nspace(nspace, opcbfunc, (void*)&active);
+    }
+    PMIX_WAIT_FOR_COMPLETION(active);
+}
+
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+/* store the blob of a single key the way the server stores the
+ * data it got for a remote proc */
+static int store_remote(void)
+{
+    pmix_buffer_t blob;
+    pmix_kval_t kv, *bo;
+    pmix_value_t val;
+    int rc;
+
+    PMIX_CONSTRUCT(&kv, pmix_kval_t);
+    kv.key = SIMPDSTORE_KEY;
+    val.type = PMIX_UINT32;
+    val.data.uint32 = SIMPDSTORE_VALUE;
+    kv.value = &val;
+    PMIX_CONSTRUCT(&blob, pmix_buffer_t);
+    pmix_bfrop.pack(&blob, &kv, 1, PMIX_KVAL);
+    kv.key = NULL;
+    kv.value = NULL;
+    PMIX_DESTRUCT(&kv);
+
+    bo = PMIX_NEW(pmix_kval_t);
+    bo->key = strdup("modex");
+    PMIX_VALUE_CREATE(bo->value, 1);
+    bo->value->type = PMIX_BYTE_OBJECT;
+    PMIX_UNLOAD_BUFFER(&blob, bo->value->data.bo.bytes, bo->value->data.bo.size);
+    PMIX_DESTRUCT(&blob);
+
+    rc = pmix_dstore_store(SIMPDSTORE_REMOTE, 0, bo);
+    PMIX_RELEASE(bo);
+    return rc;
+}
+
+static int fetch_remote(void)
+{
+    pmix_value_t *val = NULL;
+    int rc;
+
+    if (PMIX_SUCCESS != (rc = pmix_dstore_fetch(SIMPDSTORE_REMOTE, 0, SIMPDSTORE_KEY, &val))) {
+        return rc;
+    }
+    if (PMIX_UINT32 != val->type || SIMPDSTORE_VALUE != val->data.uint32) {
+        rc = PMIX_ERR_BAD_PARAM;
+    }
+    PMIX_VALUE_RELEASE(val);
+    return rc;
+}
+#endif /* PMIX_ENABLE_DSTORE */
+
+int main(int argc, char **argv)
+{
+    int rc, ret = 0;
+
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        return 1;
+    }
+
+#if defined(PMIX_ENABLE_DSTORE) && (PMIX_ENABLE_DSTORE == 1)
+    nspace_op("simpdstore.a", 1);
+    nspace_op("simpdstore.b", 1);
+    if (PMIX_SUCCESS != (rc = store_remote())) {
+        fprintf(stderr, "Storing the data of %s failed with error %d\n", SIMPDSTORE_REMOTE, rc);
+        ret = 1;
+    }
+    nspace_op("simpdstore.b", 0);
+    if (0 == ret && PMIX_SUCCESS != (rc = fetch_remote())) {
+        fprintf(stderr, "Fetching the data of %s after the deregistration failed with error %d\n",
+                SIMPDSTORE_REMOTE, rc);
+        ret = 1;
+    }
+    nspace_op("simpdstore.a", 0);
+    if (0 == ret && PMIX_SUCCESS != (rc = fetch_remote())) {
+        fprintf(stderr, "Fetching the data of %s after the deregistration failed with error %d\n",
+                SIMPDSTORE_REMOTE, rc);
+        ret = 1;
+    }
+#else
+    fprintf(stderr, "The dstore is disabled, nothing to check\n");
+#endif /* PMIX_ENABLE_DSTORE */
+
+    if (PMIX_SUCCESS != (rc = PMIx_server_finalize())) {
+        fprintf(stderr, "Finalize failed with error %d\n", rc);
+        ret = 1;
+    }
+
+    if (0 == ret) {
+        fprintf(stderr, "Test finished OK!\n");
+    }
+    return ret;
+}
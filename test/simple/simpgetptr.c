@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2013-2016 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Times PMIx_Get of a peer's byte object with and without the
+ * PMIX_GET_POINTER directive. Run it under simptest, e.g.
+ *
+ *     ./simptest -n 4 -e ./simpgetptr
+ *
+ * The byte object is only returned without a copy when the dstore
+ * uses the compact layout, so set NS_DATA_COMPACT=1 in the
+ * environment of simptest to see the difference.
+ * Each size is also stored again while the peers hold a pointer to
+ * the old bytes, which must not change under them.
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "src/class/pmix_object.h"
+#include "src/buffer_ops/types.h"
+#include "src/util/output.h"
+#include "src/util/printf.h"
+
+#define SIMPGETPTR_ITERS 1000
+
+static pmix_proc_t myproc;
+
+static double get_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1E-6 * (double)tv.tv_usec;
+}
+
+static void fill(char *bytes, size_t size, pmix_rank_t rank)
+{
+    size_t n;
+
+    for (n=0; n < size; n++) {
+        bytes[n] = (char)(rank + n);
+    }
+}
+
+/* get the byte object of the peer the given number of times and
+ * check its content, return the time per call */
+static int time_get(pmix_proc_t *proc, const char *key, pmix_info_t *info, size_t ninfo,
+                    char *expected, size_t size, double *usec)
+{
+    pmix_value_t *val;
+    double start;
+    int rc, i;
+
+    start = get_ts();
+    for (i=0; i < SIMPGETPTR_ITERS; i++) {
+        if (PMIX_SUCCESS != (rc = PMIx_Get(proc, key, info, ninfo, &val))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get failed: %d", myproc.nspace, myproc.rank, rc);
+            return rc;
+        }
+        if (PMIX_BYTE_OBJECT != val->type || size != val->data.bo.size ||
+            0 != memcmp(expected, val->data.bo.bytes, size)) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get returned wrong value", myproc.nspace, myproc.rank);
+            PMIx_Get_release(val);
+            return PMIX_ERROR;
+        }
+        PMIx_Get_release(val);
+    }
+    *usec = 1E6 * (get_ts() - start) / SIMPGETPTR_ITERS;
+    return PMIX_SUCCESS;
+}
+
+/* store a new value of the same size under the key while holding a
+ * pointer to the bytes of the peer's old value. The peer's data is
+ * stored again when we ask for a key it added along with the new
+ * value - the bytes we point to must not change, and the next get
+ * must return the new value */
+static int check_restore(pmix_proc_t *peer, const char *key, pmix_info_t *info,
+                         char *bytes, char *expected, size_t size)
+{
+    pmix_value_t value, *val, *nval;
+    pmix_proc_t all;
+    char *nkey;
+    int rc;
+
+    PMIX_PROC_CONSTRUCT(&all);
+    (void)strncpy(all.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    all.rank = PMIX_RANK_WILDCARD;
+    (void)asprintf(&nkey, "%s-restored", key);
+
+    if (PMIX_SUCCESS != (rc = PMIx_Get(peer, key, info, 1, &val))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get failed: %d", myproc.nspace, myproc.rank, rc);
+        free(nkey);
+        return rc;
+    }
+    /* everyone holds the old value before anyone stores a new one */
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(&all, 1, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+        goto release;
+    }
+    fill(bytes, size, myproc.rank + 1);
+    value.type = PMIX_BYTE_OBJECT;
+    value.data.bo.bytes = bytes;
+    value.data.bo.size = size;
+    if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, key, &value)) ||
+        PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, nkey, &value)) ||
+        PMIX_SUCCESS != (rc = PMIx_Commit()) ||
+        PMIX_SUCCESS != (rc = PMIx_Fence(&all, 1, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: storing the new value failed: %d", myproc.nspace, myproc.rank, rc);
+        goto release;
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Get(peer, nkey, info, 1, &nval))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get failed: %d", myproc.nspace, myproc.rank, rc);
+        goto release;
+    }
+    PMIx_Get_release(nval);
+    if (size != val->data.bo.size || 0 != memcmp(expected, val->data.bo.bytes, size)) {
+        pmix_output(0, "Client ns %s rank %d: the bytes of the old value changed under the pointer",
+                    myproc.nspace, myproc.rank);
+        rc = PMIX_ERROR;
+        goto release;
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Get(peer, key, info, 1, &nval))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get failed: %d", myproc.nspace, myproc.rank, rc);
+        goto release;
+    }
+    fill(expected, size, peer->rank + 1);
+    if (PMIX_BYTE_OBJECT != nval->type || size != nval->data.bo.size ||
+        0 != memcmp(expected, nval->data.bo.bytes, size)) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get returned the old value", myproc.nspace, myproc.rank);
+        rc = PMIX_ERROR;
+    }
+    PMIx_Get_release(nval);
+
+  release:
+    PMIx_Get_release(val);
+    free(nkey);
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    int rc;
+    pmix_value_t value;
+    pmix_value_t *val = &value;
+    pmix_proc_t proc;
+    pmix_info_t info;
+    bool flag = true;
+    uint32_t nprocs;
+    size_t sizes[] = {64, 4096, 65536};
+    size_t k;
+    char *bytes, *expected, *key;
+    double copy, ptr;
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Init failed: %d", myproc.nspace, myproc.rank, rc);
+        exit(0);
+    }
+
+    /* get our universe size */
+    PMIX_PROC_CONSTRUCT(&proc);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    proc.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_UNIV_SIZE, NULL, 0, &val))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get universe size failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    PMIX_INFO_CONSTRUCT(&info);
+    PMIX_INFO_LOAD(&info, PMIX_GET_POINTER, &flag, PMIX_BOOL);
+
+    for (k=0; k < sizeof(sizes)/sizeof(sizes[0]); k++) {
+        bytes = (char*)malloc(sizes[k]);
+        expected = (char*)malloc(sizes[k]);
+        fill(bytes, sizes[k], myproc.rank);
+        (void)asprintf(&key, "simpgetptr-%lu", (unsigned long)sizes[k]);
+
+        value.type = PMIX_BYTE_OBJECT;
+        value.data.bo.bytes = bytes;
+        value.data.bo.size = sizes[k];
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, key, &value))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Put failed: %d", myproc.nspace, myproc.rank, rc);
+            goto cleanup;
+        }
+        if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Commit failed: %d", myproc.nspace, myproc.rank, rc);
+            goto cleanup;
+        }
+        proc.rank = PMIX_RANK_WILDCARD;
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(&proc, 1, NULL, 0))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+            goto cleanup;
+        }
+
+        /* time the retrieval of the byte object put by our peer */
+        proc.rank = (myproc.rank + 1) % nprocs;
+        fill(expected, sizes[k], proc.rank);
+        if (PMIX_SUCCESS != (rc = time_get(&proc, key, NULL, 0, expected, sizes[k], &copy)) ||
+            PMIX_SUCCESS != (rc = time_get(&proc, key, &info, 1, expected, sizes[k], &ptr))) {
+            goto cleanup;
+        }
+        pmix_output(0, "Client ns %s rank %d: %lu bytes: %.3f usec per PMIx_Get, %.3f usec with %s",
+                    myproc.nspace, myproc.rank, (unsigned long)sizes[k], copy, ptr, PMIX_GET_POINTER);
+        if (PMIX_SUCCESS != (rc = check_restore(&proc, key, &info, bytes, expected, sizes[k]))) {
+            goto cleanup;
+        }
+
+      cleanup:
+        free(bytes);
+        free(expected);
+        free(key);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+    PMIX_INFO_DESTRUCT(&info);
+
+    /* call fence so everyone waits before leaving */
+    proc.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(&proc, 1, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+
+ done:
+    /* finalize us */
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize failed: %d\n", myproc.nspace, myproc.rank, rc);
+    }
+    fflush(stderr);
+    return(0);
+}
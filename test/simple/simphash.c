@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2013-2016 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Times pmix_hash_store and pmix_hash_fetch on a private table
+ * holding a growing number of keys per rank - this is the storage
+ * behind the server's modex tables and the client's job info.
+ * Run it under simptest, e.g.
+ *
+ *     ./simptest -n 1 -e ./simphash
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "src/class/pmix_object.h"
+#include "src/class/pmix_hash_table.h"
+#include "src/buffer_ops/types.h"
+#include "src/util/hash.h"
+#include "src/util/output.h"
+#include "src/util/printf.h"
+
+#define SIMPHASH_NRANKS 16
+
+static pmix_proc_t myproc;
+
+static double get_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1E-6 * (double)tv.tv_usec;
+}
+
+/* store nkeys keys for each rank of a fresh table, then fetch
+ * them all back, return the time per store and per fetch */
+static int time_hash(int nkeys, double *store, double *fetch)
+{
+    pmix_hash_table_t table;
+    pmix_kval_t *kv;
+    pmix_value_t *val;
+    char **keys;
+    double start;
+    pmix_rank_t r;
+    int rc = PMIX_SUCCESS, k;
+
+    keys = (char**)malloc(nkeys * sizeof(char*));
+    for (k=0; k < nkeys; k++) {
+        (void)asprintf(&keys[k], "simphash.key.%d", k);
+    }
+    PMIX_CONSTRUCT(&table, pmix_hash_table_t);
+    pmix_hash_table_init(&table, 256);
+
+    start = get_ts();
+    for (r=0; r < SIMPHASH_NRANKS; r++) {
+        for (k=0; k < nkeys; k++) {
+            kv = PMIX_NEW(pmix_kval_t);
+            kv->key = strdup(keys[k]);
+            PMIX_VALUE_CREATE(kv->value, 1);
+            kv->value->type = PMIX_UINT32;
+            kv->value->data.uint32 = r * nkeys + k;
+            rc = pmix_hash_store(&table, r, kv);
+            PMIX_RELEASE(kv);
+            if (PMIX_SUCCESS != rc) {
+                pmix_output(0, "Client ns %s rank %d: pmix_hash_store failed: %d", myproc.nspace, myproc.rank, rc);
+                goto cleanup;
+            }
+        }
+    }
+    *store = 1E6 * (get_ts() - start) / (SIMPHASH_NRANKS * nkeys);
+
+    start = get_ts();
+    for (r=0; r < SIMPHASH_NRANKS; r++) {
+        for (k=0; k < nkeys; k++) {
+            if (PMIX_SUCCESS != (rc = pmix_hash_fetch(&table, r, keys[k], &val))) {
+                pmix_output(0, "Client ns %s rank %d: pmix_hash_fetch failed: %d", myproc.nspace, myproc.rank, rc);
+                goto cleanup;
+            }
+            if (PMIX_UINT32 != val->type || (uint32_t)(r * nkeys + k) != val->data.uint32) {
+                pmix_output(0, "Client ns %s rank %d: pmix_hash_fetch returned wrong value", myproc.nspace, myproc.rank);
+                PMIX_VALUE_RELEASE(val);
+                rc = PMIX_ERROR;
+                goto cleanup;
+            }
+            PMIX_VALUE_RELEASE(val);
+        }
+    }
+    *fetch = 1E6 * (get_ts() - start) / (SIMPHASH_NRANKS * nkeys);
+
+  cleanup:
+    for (r=0; r < SIMPHASH_NRANKS; r++) {
+        pmix_hash_remove_data(&table, r, NULL);
+    }
+    PMIX_DESTRUCT(&table);
+    for (k=0; k < nkeys; k++) {
+        free(keys[k]);
+    }
+    free(keys);
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    int rc;
+    int nkeys[] = {10, 50, 100, 500};
+    size_t n;
+    double store, fetch;
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Init failed: %d", myproc.nspace, myproc.rank, rc);
+        exit(0);
+    }
+
+    for (n=0; n < sizeof(nkeys)/sizeof(nkeys[0]); n++) {
+        if (PMIX_SUCCESS != (rc = time_hash(nkeys[n], &store, &fetch))) {
+            break;
+        }
+        pmix_output(0, "Client ns %s rank %d: %d keys per rank: %.3f usec per store, %.3f usec per fetch",
+                    myproc.nspace, myproc.rank, nkeys[n], store, fetch);
+    }
+
+    /* finalize us */
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize failed: %d\n", myproc.nspace, myproc.rank, rc);
+    }
+    fflush(stderr);
+    return(0);
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2013-2016 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Times PMIx_Get of a peer's key while the number of keys stored
+ * for each rank grows. Run it under simptest, e.g.
+ *
+ *     ./simptest -n 4 -e ./simpkeyget
+ *
+ * To compare against the linear search of the dstore, disable the
+ * per-rank key index by setting SM_USE_KEY_INDEX=0 in the environment
+ * of simptest.
+ *
+ * It also compares getting all the keys of the peer one by one with
+ * getting them in a single PMIx_Get_multi call.
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "src/class/pmix_object.h"
+#include "src/buffer_ops/types.h"
+#include "src/util/output.h"
+#include "src/util/printf.h"
+
+#define SIMPKEYGET_ITERS 1000
+
+static pmix_proc_t myproc;
+
+static double get_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1E-6 * (double)tv.tv_usec;
+}
+
+/* get the first nkeys keys of the peer one by one and all at once */
+static int time_get_all(pmix_proc_t *peer, uint32_t nkeys)
+{
+    pmix_proc_t *procs;
+    char **keys;
+    pmix_value_t **vals, *val;
+    pmix_status_t *status;
+    double start, single, multi;
+    uint32_t n;
+    int rc = PMIX_SUCCESS;
+
+    procs = (pmix_proc_t*)calloc(nkeys, sizeof(pmix_proc_t));
+    keys = (char**)calloc(nkeys, sizeof(char*));
+    vals = (pmix_value_t**)calloc(nkeys, sizeof(pmix_value_t*));
+    status = (pmix_status_t*)calloc(nkeys, sizeof(pmix_status_t));
+    for (n=0; n < nkeys; n++) {
+        procs[n] = *peer;
+        (void)asprintf(&keys[n], "simpkeyget-%d", n);
+    }
+
+    start = get_ts();
+    for (n=0; n < nkeys; n++) {
+        if (PMIX_SUCCESS != (rc = PMIx_Get(peer, keys[n], NULL, 0, &val))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get %s failed: %d", myproc.nspace, myproc.rank, keys[n], rc);
+            goto cleanup;
+        }
+        PMIX_VALUE_RELEASE(val);
+    }
+    single = get_ts() - start;
+
+    start = get_ts();
+    if (PMIX_SUCCESS != (rc = PMIx_Get_multi(procs, (const char**)keys, nkeys, NULL, 0, vals, status))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get_multi failed: %d", myproc.nspace, myproc.rank, rc);
+    }
+    multi = get_ts() - start;
+    for (n=0; n < nkeys; n++) {
+        if (PMIX_SUCCESS == rc &&
+            (PMIX_SUCCESS != status[n] || PMIX_UINT64 != vals[n]->type || n != vals[n]->data.uint64)) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get_multi %s returned wrong value", myproc.nspace, myproc.rank, keys[n]);
+            rc = PMIX_ERROR;
+        }
+        if (NULL != vals[n]) {
+            PMIX_VALUE_RELEASE(vals[n]);
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        pmix_output(0, "Client ns %s rank %d: %u keys: %.3f usec for PMIx_Get of each, %.3f usec for PMIx_Get_multi",
+                    myproc.nspace, myproc.rank, nkeys, 1E6 * single, 1E6 * multi);
+    }
+
+  cleanup:
+    for (n=0; n < nkeys; n++) {
+        free(keys[n]);
+    }
+    free(keys);
+    free(procs);
+    free(vals);
+    free(status);
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    int rc;
+    pmix_value_t value;
+    pmix_value_t *val = &value;
+    char *tmp;
+    pmix_proc_t proc;
+    pmix_info_t info;
+    bool flag = true;
+    uint32_t nprocs, n, i;
+    uint32_t nkeys[] = {1, 10, 100, 1000};
+    uint32_t stored = 0;
+    size_t k;
+    double start, elapsed;
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Init failed: %d", myproc.nspace, myproc.rank, rc);
+        exit(0);
+    }
+
+    /* get our universe size */
+    PMIX_PROC_CONSTRUCT(&proc);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    proc.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_UNIV_SIZE, NULL, 0, &val))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get universe size failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    PMIX_INFO_CONSTRUCT(&info);
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &flag, PMIX_BOOL);
+
+    for (k=0; k < sizeof(nkeys)/sizeof(nkeys[0]); k++) {
+        /* grow the number of keys we have stored */
+        for (n=stored; n < nkeys[k]; n++) {
+            (void)asprintf(&tmp, "simpkeyget-%d", n);
+            value.type = PMIX_UINT64;
+            value.data.uint64 = n;
+            if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, tmp, &value))) {
+                pmix_output(0, "Client ns %s rank %d: PMIx_Put failed: %d", myproc.nspace, myproc.rank, rc);
+                free(tmp);
+                goto done;
+            }
+            free(tmp);
+        }
+        stored = nkeys[k];
+        if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Commit failed: %d", myproc.nspace, myproc.rank, rc);
+            goto done;
+        }
+        proc.rank = PMIX_RANK_WILDCARD;
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(&proc, 1, &info, 1))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+            goto done;
+        }
+
+        /* time the retrieval of the last key put by our peer */
+        proc.rank = (myproc.rank + 1) % nprocs;
+        (void)asprintf(&tmp, "simpkeyget-%d", stored - 1);
+        start = get_ts();
+        for (i=0; i < SIMPKEYGET_ITERS; i++) {
+            if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, tmp, NULL, 0, &val))) {
+                pmix_output(0, "Client ns %s rank %d: PMIx_Get %s failed: %d", myproc.nspace, myproc.rank, tmp, rc);
+                free(tmp);
+                goto done;
+            }
+            if (PMIX_UINT64 != val->type || stored - 1 != val->data.uint64) {
+                pmix_output(0, "Client ns %s rank %d: PMIx_Get %s returned wrong value", myproc.nspace, myproc.rank, tmp);
+                PMIX_VALUE_RELEASE(val);
+                free(tmp);
+                goto done;
+            }
+            PMIX_VALUE_RELEASE(val);
+        }
+        elapsed = get_ts() - start;
+        free(tmp);
+        pmix_output(0, "Client ns %s rank %d: %u keys per rank: %.3f usec per PMIx_Get",
+                    myproc.nspace, myproc.rank, stored, 1E6 * elapsed / SIMPKEYGET_ITERS);
+
+        if (PMIX_SUCCESS != (rc = time_get_all(&proc, stored))) {
+            goto done;
+        }
+    }
+    PMIX_INFO_DESTRUCT(&info);
+
+    /* call fence so everyone waits before leaving */
+    proc.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(&proc, 1, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+
+ done:
+    /* finalize us */
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize failed: %d\n", myproc.nspace, myproc.rank, rc);
+    }
+    fflush(stderr);
+    return(0);
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2013-2016 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the latency of the blocking PMIx_Put and PMIx_Get calls
+ * and the cpu time a rank burns while it waits in PMIx_Fence for a
+ * late peer, then has rank 0 print the server's fence latencies.
+ * Run it under simptest, e.g.
+ *
+ *     ./simptest -n 2 -e ./simplat
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "src/class/pmix_object.h"
+#include "src/buffer_ops/types.h"
+#include "src/util/argv.h"
+#include "src/util/output.h"
+#include "src/util/printf.h"
+
+#define SIMPLAT_ITERS 10000
+#define SIMPLAT_DELAY 1
+
+static pmix_proc_t myproc;
+
+static double get_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1E-6 * (double)tv.tv_usec;
+}
+
+static double get_cpu(void)
+{
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return (double)(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+           1E-6 * (double)(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec);
+}
+
+static void querycbfunc(pmix_status_t status,
+                        pmix_info_t *info, size_t ninfo,
+                        void *cbdata,
+                        pmix_release_cbfunc_t release_fn,
+                        void *release_cbdata)
+{
+    volatile bool *active = (volatile bool*)cbdata;
+
+    if (PMIX_SUCCESS != status) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Query_info failed: %d",
+                    myproc.nspace, myproc.rank, status);
+    } else if (1 != ninfo || PMIX_STRING != info[0].value.type ||
+               0 != strncmp(info[0].key, PMIX_QUERY_FENCE_STATS, PMIX_MAX_KEYLEN)) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Query_info returned %d infos of the wrong kind",
+                    myproc.nspace, myproc.rank, (int)ninfo);
+    } else {
+        pmix_output(0, "Client ns %s rank %d: server fence latencies\n%s",
+                    myproc.nspace, myproc.rank, info[0].value.data.string);
+    }
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    *active = false;
+}
+
+int main(int argc, char **argv)
+{
+    int rc, i;
+    pmix_value_t value;
+    pmix_value_t *val = &value;
+    pmix_proc_t proc;
+    double start, cpu, put, get;
+    pmix_query_t *query;
+    volatile bool active;
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Init failed: %d", myproc.nspace, myproc.rank, rc);
+        exit(0);
+    }
+
+    /* time putting the same key over and over */
+    value.type = PMIX_UINT64;
+    start = get_ts();
+    for (i=0; i < SIMPLAT_ITERS; i++) {
+        value.data.uint64 = i;
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_LOCAL, "simplat", &value))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Put failed: %d", myproc.nspace, myproc.rank, rc);
+            goto done;
+        }
+    }
+    put = get_ts() - start;
+
+    /* time getting a job-level key that is always available locally */
+    PMIX_PROC_CONSTRUCT(&proc);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    proc.rank = PMIX_RANK_WILDCARD;
+    start = get_ts();
+    for (i=0; i < SIMPLAT_ITERS; i++) {
+        if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_UNIV_SIZE, NULL, 0, &val))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get universe size failed: %d", myproc.nspace, myproc.rank, rc);
+            goto done;
+        }
+        PMIX_VALUE_RELEASE(val);
+    }
+    get = get_ts() - start;
+    pmix_output(0, "Client ns %s rank %d: %.3f usec per PMIx_Put, %.3f usec per PMIx_Get",
+                myproc.nspace, myproc.rank, 1E6 * put / SIMPLAT_ITERS, 1E6 * get / SIMPLAT_ITERS);
+
+    /* rank 0 is late for the fence, everyone else waits for it */
+    if (0 == myproc.rank) {
+        sleep(SIMPLAT_DELAY);
+    }
+    start = get_ts();
+    cpu = get_cpu();
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(&proc, 1, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    if (0 != myproc.rank) {
+        pmix_output(0, "Client ns %s rank %d: waited %.3f sec in PMIx_Fence using %.3f sec of cpu",
+                    myproc.nspace, myproc.rank, get_ts() - start, get_cpu() - cpu);
+    }
+
+    /* see where the time of the fence went */
+    if (0 == myproc.rank) {
+        PMIX_QUERY_CREATE(query, 1);
+        pmix_argv_append_nosize(&query[0].keys, PMIX_QUERY_FENCE_STATS);
+        active = true;
+        if (PMIX_SUCCESS != (rc = PMIx_Query_info_nb(query, 1, querycbfunc, (void*)&active))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Query_info failed: %d", myproc.nspace, myproc.rank, rc);
+            active = false;
+        }
+        while (active) {
+            usleep(10);
+        }
+        PMIX_QUERY_FREE(query, 1);
+    }
+
+ done:
+    /* finalize us */
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize failed: %d\n", myproc.nspace, myproc.rank, rc);
+    }
+    fflush(stderr);
+    return(0);
+}
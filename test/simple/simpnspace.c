@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2013-2016 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Times finding an nspace by name once the process knows about
+ * a growing number of them - once through pmix_nspace_lookup and
+ * once by walking the list of nspaces the way lookups used to.
+ * Run it under simptest, e.g.
+ *
+ *     ./simptest -n 1 -e ./simpnspace
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "src/class/pmix_object.h"
+#include "src/class/pmix_list.h"
+#include "src/buffer_ops/types.h"
+#include "src/include/pmix_globals.h"
+#include "src/util/output.h"
+#include "src/util/printf.h"
+
+#define SIMPNSPACE_LOOKUPS 100000
+
+static pmix_proc_t myproc;
+
+static double get_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1E-6 * (double)tv.tv_usec;
+}
+
+/* add nspaces until there are nns of ours, then look them up
+ * round-robin - return the time per lookup for the index and
+ * for the list walk */
+static int time_lookup(pmix_nspace_t **added, int *nadded, int nns,
+                       double *idx, double *scan)
+{
+    pmix_nspace_t *nptr, *ns;
+    char name[PMIX_MAX_NSLEN+1];
+    double start;
+    int i;
+
+    for (i=*nadded; i < nns; i++) {
+        nptr = PMIX_NEW(pmix_nspace_t);
+        (void)snprintf(nptr->nspace, PMIX_MAX_NSLEN, "simpnspace.%d", i);
+        pmix_nspace_add(nptr);
+        added[i] = nptr;
+    }
+    *nadded = nns;
+
+    start = get_ts();
+    for (i=0; i < SIMPNSPACE_LOOKUPS; i++) {
+        (void)snprintf(name, PMIX_MAX_NSLEN, "simpnspace.%d", i % nns);
+        if (NULL == pmix_nspace_lookup(name)) {
+            pmix_output(0, "Client ns %s rank %d: nspace %s not found", myproc.nspace, myproc.rank, name);
+            return PMIX_ERR_NOT_FOUND;
+        }
+    }
+    *idx = 1E6 * (get_ts() - start) / SIMPNSPACE_LOOKUPS;
+
+    start = get_ts();
+    for (i=0; i < SIMPNSPACE_LOOKUPS; i++) {
+        (void)snprintf(name, PMIX_MAX_NSLEN, "simpnspace.%d", i % nns);
+        nptr = NULL;
+        PMIX_LIST_FOREACH(ns, &pmix_globals.nspaces, pmix_nspace_t) {
+            if (0 == strcmp(name, ns->nspace)) {
+                nptr = ns;
+                break;
+            }
+        }
+        if (NULL == nptr) {
+            pmix_output(0, "Client ns %s rank %d: nspace %s not on the list", myproc.nspace, myproc.rank, name);
+            return PMIX_ERR_NOT_FOUND;
+        }
+    }
+    *scan = 1E6 * (get_ts() - start) / SIMPNSPACE_LOOKUPS;
+
+    return PMIX_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    int rc;
+    int nns[] = {10, 100, 1000, 10000};
+    size_t n;
+    double idx, scan;
+    pmix_nspace_t **added;
+    int i, nadded = 0;
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Init failed: %d", myproc.nspace, myproc.rank, rc);
+        exit(0);
+    }
+
+    added = (pmix_nspace_t**)malloc(nns[sizeof(nns)/sizeof(nns[0]) - 1] * sizeof(pmix_nspace_t*));
+    for (n=0; n < sizeof(nns)/sizeof(nns[0]); n++) {
+        if (PMIX_SUCCESS != (rc = time_lookup(added, &nadded, nns[n], &idx, &scan))) {
+            break;
+        }
+        pmix_output(0, "Client ns %s rank %d: %d nspaces: %.3f usec per indexed lookup, %.3f usec per list walk",
+                    myproc.nspace, myproc.rank, nns[n], idx, scan);
+    }
+    for (i=0; i < nadded; i++) {
+        pmix_nspace_remove(added[i]);
+        PMIX_RELEASE(added[i]);
+    }
+    free(added);
+
+    /* finalize us */
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize failed: %d\n", myproc.nspace, myproc.rank, rc);
+    }
+    fflush(stderr);
+    return(0);
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2013-2016 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Times packing payloads from 1KB to 64MB into a buffer a piece
+ * at a time - once letting the buffer grow as it goes and once
+ * reserving the whole payload up front - and checks that what
+ * was packed unpacks again. Run it under simptest, e.g.
+ *
+ *     ./simptest -n 1 -e ./simppack
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "src/class/pmix_object.h"
+#include "src/buffer_ops/buffer_ops.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+/* size of each piece packed */
+#define SIMPPACK_PIECE 256
+/* upper bound on what packing a piece adds to it */
+#define SIMPPACK_PIECE_OVERHEAD 32
+/* total bytes packed at each payload size */
+#define SIMPPACK_VOLUME (256 * 1024 * 1024)
+
+static pmix_proc_t myproc;
+
+static double get_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1E-6 * (double)tv.tv_usec;
+}
+
+/* pack size bytes in pieces, reserving the room first if asked */
+static int pack_payload(pmix_buffer_t *buf, char *piece, size_t size, bool reserve)
+{
+    pmix_byte_object_t bo;
+    size_t n;
+    int rc;
+
+    bo.bytes = piece;
+    bo.size = SIMPPACK_PIECE;
+    if (reserve &&
+        PMIX_SUCCESS != (rc = pmix_bfrop.reserve(buf, size + (size / SIMPPACK_PIECE) * SIMPPACK_PIECE_OVERHEAD))) {
+        return rc;
+    }
+    for (n=0; n < size; n += SIMPPACK_PIECE) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.pack(buf, &bo, 1, PMIX_BYTE_OBJECT))) {
+            return rc;
+        }
+    }
+    bo.bytes = NULL;
+    bo.size = 0;
+    return PMIX_SUCCESS;
+}
+
+static int check_payload(pmix_buffer_t *buf, char *piece, size_t size)
+{
+    pmix_byte_object_t bo;
+    size_t n;
+    int32_t cnt;
+    int rc;
+
+    for (n=0; n < size; n += SIMPPACK_PIECE) {
+        cnt = 1;
+        if (PMIX_SUCCESS != (rc = pmix_bfrop.unpack(buf, &bo, &cnt, PMIX_BYTE_OBJECT))) {
+            return rc;
+        }
+        if (SIMPPACK_PIECE != bo.size || 0 != memcmp(bo.bytes, piece, SIMPPACK_PIECE)) {
+            free(bo.bytes);
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        free(bo.bytes);
+    }
+    return PMIX_SUCCESS;
+}
+
+/* return the time in usec to pack one payload of size bytes */
+static int time_pack(char *piece, size_t size, bool reserve, double *usec)
+{
+    pmix_buffer_t buf;
+    size_t reps, n;
+    double start;
+    int rc = PMIX_SUCCESS;
+
+    reps = SIMPPACK_VOLUME / size;
+    start = get_ts();
+    for (n=0; n < reps; n++) {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        rc = pack_payload(&buf, piece, size, reserve);
+        if (PMIX_SUCCESS == rc && 0 == n) {
+            rc = check_payload(&buf, piece, size);
+        }
+        PMIX_DESTRUCT(&buf);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    *usec = 1E6 * (get_ts() - start) / reps;
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    int rc;
+    size_t size;
+    double grow, rsv;
+    char piece[SIMPPACK_PIECE];
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Init failed: %d", myproc.nspace, myproc.rank, rc);
+        exit(0);
+    }
+
+    memset(piece, 'p', SIMPPACK_PIECE);
+    for (size=1024; size <= 64*1024*1024; size *= 4) {
+        if (PMIX_SUCCESS != (rc = time_pack(piece, size, false, &grow)) ||
+            PMIX_SUCCESS != (rc = time_pack(piece, size, true, &rsv))) {
+            pmix_output(0, "Client ns %s rank %d: packing %lu bytes failed: %d",
+                        myproc.nspace, myproc.rank, (unsigned long)size, rc);
+            break;
+        }
+        pmix_output(0, "Client ns %s rank %d: %lu bytes: %.1f usec growing (%.0f MB/s), %.1f usec reserved (%.0f MB/s)",
+                    myproc.nspace, myproc.rank, (unsigned long)size,
+                    grow, (double)size / grow, rsv, (double)size / rsv);
+    }
+
+    /* finalize us */
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize failed: %d\n", myproc.nspace, myproc.rank, rc);
+    }
+    fflush(stderr);
+    return(0);
+}
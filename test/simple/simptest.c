@@ -335,6 +335,12 @@ int main(int argc, char **argv)
         nanosleep(&ts, NULL);
     }
 
+    /* the clients are gone, so release their nspace */
+    x = PMIX_NEW(myxfer_t);
+    PMIx_server_deregister_nspace("foobar", opcbfunc, x);
+    PMIX_WAIT_FOR_COMPLETION(x->active);
+    PMIX_RELEASE(x);
+
     /* deregister the errhandler */
     PMIx_Deregister_event_handler(0, NULL, NULL);
 